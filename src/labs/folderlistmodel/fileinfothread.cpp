@@ -6,6 +6,8 @@
 #include <qpointer.h>
 #include <qtimer.h>
 
+#include <algorithm>
+
 #include <QDebug>
 #include <QtCore/qloggingcategory.h>
 
@@ -13,10 +15,14 @@ QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcFileInfoThread, "qt.labs.folderlistmodel.fileinfothread")
 
+// Number of entries delivered per page while an unsorted folder is read.
+static const qsizetype FileInfoPageSize = 256;
+
 FileInfoThread::FileInfoThread(QObject *parent)
     : QThread(parent),
       abort(false),
       scanPending(false),
+      pathChanged(false),
 #if QT_CONFIG(filesystemwatcher)
       watcher(nullptr),
 #endif
@@ -79,6 +85,7 @@ void FileInfoThread::setPath(const QString &path)
         watcher->addPath(path);
 #endif
     currentPath = path;
+    pathChanged = true;
     needUpdate = true;
     initiateScan();
 }
@@ -289,48 +296,47 @@ void FileInfoThread::getFileInfos(const QString &path)
     if (showDirsFirst)
         sortFlags = sortFlags | QDir::DirsFirst;
 
+    // A new folder always replaces the whole model, whatever else changed meanwhile.
+    const bool newPath = pathChanged;
+    pathChanged = false;
+
+    if (newPath && (sortFlags & (QDir::SortByMask | QDir::DirsFirst)) == QDir::Unsorted) {
+        // Nothing needs to be sorted, so hand out the entries as they are read.
+        updateTypes = UpdateType::None;
+        needUpdate = false;
+        // Settings changed while reading are applied as an update of the pages read. If
+        // reading was cut short, the new path or the destruction takes over instead.
+        if (readFileInfoPages(path, filter) && updateTypes != UpdateType::None)
+            needUpdate = true;
+        return;
+    }
+
     QDir currentDir(path, QString(), sortFlags);
     QList<FileProperty> filePropertyList;
 
     const QFileInfoList fileInfoList = currentDir.entryInfoList(nameFilters, filter, sortFlags);
-
-    if (!fileInfoList.isEmpty()) {
-        filePropertyList.reserve(fileInfoList.size());
-        for (const QFileInfo &info : fileInfoList)
-            filePropertyList << FileProperty(info);
-
-        if (updateTypes & UpdateType::Contents) {
-            int fromIndex = 0;
-            int toIndex = currentFileList.size()-1;
-            findChangeRange(filePropertyList, fromIndex, toIndex);
-            currentFileList = filePropertyList;
-            qCDebug(lcFileInfoThread) << "- about to emit directoryUpdated with fromIndex" << fromIndex
-                << "toIndex" << toIndex << "fileInfoList" << fileInfoListToString(fileInfoList);
-            emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
-        } else {
-            currentFileList = filePropertyList;
-            if (updateTypes & UpdateType::Sort) {
-                qCDebug(lcFileInfoThread) << "- about to emit sortFinished - fileInfoList:"
-                    << fileInfoListToString(fileInfoList);
-                emit sortFinished(filePropertyList);
-            } else {
-                qCDebug(lcFileInfoThread) << "- about to emit directoryChanged - fileInfoList:"
-                    << fileInfoListToString(fileInfoList);
-                emit directoryChanged(path, filePropertyList);
-            }
+    filePropertyList.reserve(fileInfoList.size());
+    for (const QFileInfo &info : fileInfoList)
+        filePropertyList << FileProperty(info);
+
+    if (!newPath && (updateTypes & UpdateType::Contents)) {
+        QList<FileProperty> items;
+        const QList<FileChange> changes = diffFileList(filePropertyList, items);
+        currentFileList = filePropertyList;
+        if (!changes.isEmpty()) {
+            qCDebug(lcFileInfoThread) << "- about to emit directoryUpdated with" << changes.size()
+                << "changes - fileInfoList:" << fileInfoListToString(fileInfoList);
+            emit directoryUpdated(path, items, changes);
         }
     } else {
-        // The directory is empty
-        if (updateTypes & UpdateType::Contents) {
-            int fromIndex = 0;
-            int toIndex = currentFileList.size()-1;
-            currentFileList.clear();
-            qCDebug(lcFileInfoThread) << "- directory is empty, about to emit directoryUpdated with fromIndex"
-                << fromIndex << "toIndex" << toIndex;
-            emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
+        currentFileList = filePropertyList;
+        if (!newPath && (updateTypes & UpdateType::Sort)) {
+            qCDebug(lcFileInfoThread) << "- about to emit sortFinished - fileInfoList:"
+                << fileInfoListToString(fileInfoList);
+            emit sortFinished(filePropertyList);
         } else {
-            currentFileList.clear();
-            qCDebug(lcFileInfoThread) << "- directory is empty, about to emit directoryChanged";
+            qCDebug(lcFileInfoThread) << "- about to emit directoryChanged - fileInfoList:"
+                << fileInfoListToString(fileInfoList);
             emit directoryChanged(path, filePropertyList);
         }
     }
@@ -338,32 +344,138 @@ void FileInfoThread::getFileInfos(const QString &path)
     needUpdate = false;
 }
 
-void FileInfoThread::findChangeRange(const QList<FileProperty> &list, int &fromIndex, int &toIndex)
+/*
+    Reads the folder in pages of FileInfoPageSize entries. The first page
+    completes the model reset, so the view has something to show right away;
+    the remaining pages are appended as incremental updates. The mutex is
+    released between pages; returns false if the thread was aborted or the
+    path changed meanwhile, leaving the rest of the folder unread.
+*/
+bool FileInfoThread::readFileInfoPages(const QString &path, QDir::Filters filter)
 {
-    if (currentFileList.size() == 0) {
-        fromIndex = 0;
-        toIndex = list.size();
-        return;
-    }
+    qCDebug(lcFileInfoThread) << "- reading unsorted folder" << path << "in pages";
+
+    QDirIterator it(path, nameFilters, filter);
+    QList<FileProperty> page;
+    bool firstPage = true;
+    currentFileList.clear();
+
+    auto emitPage = [&]() {
+        if (firstPage) {
+            emit directoryChanged(path, page);
+            firstPage = false;
+        } else if (!page.isEmpty()) {
+            const FileChange change = { FileChange::Insert, int(currentFileList.size()), int(page.size()) };
+            emit directoryUpdated(path, page, { change });
+        }
+        currentFileList += page;
+        page.clear();
+    };
 
-    int i;
-    int listSize = list.size() < currentFileList.size() ? list.size() : currentFileList.size();
-    bool changeFound = false;
+    page.reserve(FileInfoPageSize);
+    while (it.hasNext()) {
+        page.append(FileProperty(it.nextFileInfo()));
+        if (page.size() < FileInfoPageSize)
+            continue;
 
-    for (i=0; i < listSize; i++) {
-        if (list.at(i) != currentFileList.at(i)) {
-            changeFound = true;
-            break;
+        emitPage();
+#if QT_CONFIG(thread)
+        // run() holds the mutex; let setPath() and the destructor in.
+        mutex.unlock();
+        yieldCurrentThread();
+        mutex.lock();
+#endif
+        if (abort || pathChanged) {
+            qCDebug(lcFileInfoThread) << "- stopped reading" << path << "after"
+                << currentFileList.size() << "entries";
+            return false;
         }
     }
+    emitPage();
+    return true;
+}
 
-    if (changeFound)
-        fromIndex = i;
-    else
-        fromIndex = i-1;
+/*
+    Computes the steps that turn currentFileList into \a list. Entries are
+    matched by name; the longest run of matched entries that kept their
+    relative order stays in place, everything else is removed or inserted.
+    Matched entries whose size, type or modification time changed are
+    reported as updates. The FileProperty of every inserted or updated row is
+    appended to \a items in the order the steps consume them.
+*/
+QList<FileChange> FileInfoThread::diffFileList(const QList<FileProperty> &list, QList<FileProperty> &items) const
+{
+    const qsizetype oldSize = currentFileList.size();
+    const qsizetype newSize = list.size();
+
+    QHash<QString, qsizetype> oldIndexes;
+    oldIndexes.reserve(oldSize);
+    for (qsizetype i = 0; i < oldSize; ++i)
+        oldIndexes.insert(currentFileList.at(i).fileName(), i);
+
+    QList<qsizetype> newToOld(newSize, -1);
+    for (qsizetype j = 0; j < newSize; ++j)
+        newToOld[j] = oldIndexes.value(list.at(j).fileName(), -1);
+
+    // Longest increasing subsequence of the old positions, in O(n log n).
+    QList<qsizetype> tails;
+    QList<qsizetype> previous(newSize, -1);
+    for (qsizetype j = 0; j < newSize; ++j) {
+        const qsizetype oldIndex = newToOld.at(j);
+        if (oldIndex < 0)
+            continue;
+        auto pos = std::lower_bound(tails.begin(), tails.end(), oldIndex,
+                                    [&newToOld](qsizetype tail, qsizetype value) {
+            return newToOld.at(tail) < value;
+        });
+        if (pos != tails.begin())
+            previous[j] = *(pos - 1);
+        if (pos == tails.end())
+            tails.append(j);
+        else
+            *pos = j;
+    }
 
-    // For now I let the rest of the list be updated..
-    toIndex = list.size() > currentFileList.size() ? list.size() - 1 : currentFileList.size() - 1;
+    QList<bool> keptOld(oldSize, false);
+    QList<bool> keptNew(newSize, false);
+    for (qsizetype j = tails.isEmpty() ? -1 : tails.last(); j >= 0; j = previous.at(j)) {
+        keptNew[j] = true;
+        keptOld[newToOld.at(j)] = true;
+    }
+
+    QList<FileChange> changes;
+    qsizetype i = 0;
+    qsizetype j = 0;
+    int row = 0;
+    while (i < oldSize || j < newSize) {
+        if (i < oldSize && !keptOld.at(i)) {
+            int count = 0;
+            for (; i < oldSize && !keptOld.at(i); ++i)
+                ++count;
+            changes.append({ FileChange::Remove, row, count });
+        } else if (j < newSize && !keptNew.at(j)) {
+            int count = 0;
+            for (; j < newSize && !keptNew.at(j); ++j, ++count)
+                items.append(list.at(j));
+            changes.append({ FileChange::Insert, row, count });
+            row += count;
+        } else {
+            // Both sides are at the same matched entry.
+            if (!currentFileList.at(i).hasSameAttributes(list.at(j))) {
+                if (!changes.isEmpty() && changes.last().kind == FileChange::Update
+                        && changes.last().index + changes.last().count == row) {
+                    ++changes.last().count;
+                } else {
+                    changes.append({ FileChange::Update, row, 1 });
+                }
+                items.append(list.at(j));
+            }
+            ++i;
+            ++j;
+            ++row;
+        }
+    }
+    return changes;
 }
 
 constexpr FileInfoThread::UpdateTypes operator|(FileInfoThread::UpdateType f1, FileInfoThread::UpdateTypes f2) noexcept
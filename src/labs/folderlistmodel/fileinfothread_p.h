@@ -35,7 +35,7 @@ class FileInfoThread : public QThread
 
 Q_SIGNALS:
     void directoryChanged(const QString &directory, const QList<FileProperty> &list) const;
-    void directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex) const;
+    void directoryUpdated(const QString &directory, const QList<FileProperty> &items, const QList<FileChange> &changes) const;
     void sortFinished(const QList<FileProperty> &list) const;
     void statusChanged(QQuickFolderListModel::Status status) const;
 
@@ -68,7 +68,8 @@ protected:
     void runOnce();
     void initiateScan();
     void getFileInfos(const QString &path);
-    void findChangeRange(const QList<FileProperty> &list, int &fromIndex, int &toIndex);
+    bool readFileInfoPages(const QString &path, QDir::Filters filter);
+    QList<FileChange> diffFileList(const QList<FileProperty> &list, QList<FileProperty> &items) const;
 
 private:
     enum class UpdateType {
@@ -88,6 +89,7 @@ private:
     QWaitCondition condition;
     volatile bool abort;
     bool scanPending;
+    bool pathChanged;
 
 #if QT_CONFIG(filesystemwatcher)
     QFileSystemWatcher *watcher;
@@ -55,6 +55,10 @@ public:
     bool operator ==(const FileProperty &property) const {
         return ((mFileName == property.mFileName) && (isDir() == property.isDir()));
     }
+    bool hasSameAttributes(const FileProperty &property) const {
+        return mIsDir == property.mIsDir && mIsFile == property.mIsFile
+                && mSize == property.mSize && mLastModified == property.mLastModified;
+    }
 
 private:
     QString mFileName;
@@ -68,6 +72,19 @@ private:
     QDateTime mLastRead;
 };
 
+// One step of an incremental update. Steps are applied in order, so each
+// index refers to the list as left by the preceding steps. Inserted and
+// updated rows take their FileProperty from the accompanying item list.
+struct FileChange
+{
+    enum Kind { Insert, Remove, Update };
+
+    Kind kind;
+    int index;
+    int count;
+};
+Q_DECLARE_TYPEINFO(FileChange, Q_PRIMITIVE_TYPE);
+
 QT_END_NAMESPACE
 
 #endif // FILEPROPERTY_P_H
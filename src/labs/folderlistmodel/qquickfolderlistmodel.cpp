@@ -38,6 +38,7 @@ public:
     bool showHidden = false;
     bool caseSensitive = true;
     bool sortCaseSensitive = true;
+    bool resetPending = false;
 
     ~QQuickFolderListModelPrivate() {}
     void init();
@@ -45,7 +46,7 @@ public:
 
     // private slots
     void _q_directoryChanged(const QString &directory, const QList<FileProperty> &list);
-    void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex);
+    void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &items, const QList<FileChange> &changes);
     void _q_sortFinished(const QList<FileProperty> &list);
     void _q_statusChanged(QQuickFolderListModel::Status s);
 
@@ -57,11 +58,12 @@ void QQuickFolderListModelPrivate::init()
 {
     Q_Q(QQuickFolderListModel);
     qRegisterMetaType<QList<FileProperty> >("QList<FileProperty>");
+    qRegisterMetaType<QList<FileChange> >("QList<FileChange>");
     qRegisterMetaType<QQuickFolderListModel::Status>("QQuickFolderListModel::Status");
     q->connect(&fileInfoThread, SIGNAL(directoryChanged(QString,QList<FileProperty>)),
                q, SLOT(_q_directoryChanged(QString,QList<FileProperty>)));
-    q->connect(&fileInfoThread, SIGNAL(directoryUpdated(QString,QList<FileProperty>,int,int)),
-               q, SLOT(_q_directoryUpdated(QString,QList<FileProperty>,int,int)));
+    q->connect(&fileInfoThread, SIGNAL(directoryUpdated(QString,QList<FileProperty>,QList<FileChange>)),
+               q, SLOT(_q_directoryUpdated(QString,QList<FileProperty>,QList<FileChange>)));
     q->connect(&fileInfoThread, SIGNAL(sortFinished(QList<FileProperty>)),
                q, SLOT(_q_sortFinished(QList<FileProperty>)));
     q->connect(&fileInfoThread, SIGNAL(statusChanged(QQuickFolderListModel::Status)),
@@ -108,9 +110,13 @@ void QQuickFolderListModelPrivate::_q_directoryChanged(const QString &directory,
 {
     qCDebug(lcFolderListModel) << "_q_directoryChanged called with directory" << directory;
     Q_Q(QQuickFolderListModel);
-    Q_UNUSED(directory);
+
+    // A listing of a folder that has been replaced in the meantime.
+    if (directory != resolvePath(currentDir))
+        return;
 
     data = list;
+    resetPending = false;
     q->endResetModel();
     qCDebug(lcFolderListModel) << "- endResetModel called";
     emit q->rowCountChanged();
@@ -118,35 +124,46 @@ void QQuickFolderListModelPrivate::_q_directoryChanged(const QString &directory,
 }
 
 
-void QQuickFolderListModelPrivate::_q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex)
+void QQuickFolderListModelPrivate::_q_directoryUpdated(const QString &directory, const QList<FileProperty> &items, const QList<FileChange> &changes)
 {
     Q_Q(QQuickFolderListModel);
-    Q_UNUSED(directory);
+
+    // Updates still queued for a previous folder are superseded by the reset.
+    if (resetPending || directory != resolvePath(currentDir))
+        return;
+
+    qCDebug(lcFolderListModel) << "_q_directoryUpdated called with" << changes.size() << "changes";
 
     QModelIndex parent;
-    if (data.size() == list.size()) {
-        QModelIndex modelIndexFrom = q->createIndex(fromIndex, 0);
-        QModelIndex modelIndexTo = q->createIndex(toIndex, 0);
-        data = list;
-        emit q->dataChanged(modelIndexFrom, modelIndexTo);
-    } else {
-        // File(s) inserted or removed. Since I do not know how many
-        // or where, I need to update the whole list from the first item.
-        // This is a little pessimistic, but optimizing it would require
-        // more information in the signal from FileInfoThread.
-        if (data.size() > 0) {
-            q->beginRemoveRows(parent, 0, data.size() - 1);
-            q->endRemoveRows();
-        }
-        data = list;
-        if (list.size() > 0) {
-            if (toIndex > list.size() - 1)
-                toIndex = list.size() - 1;
-            q->beginInsertRows(parent, 0, data.size() - 1);
+    qsizetype item = 0;
+    bool countChanged = false;
+    for (const FileChange &change : changes) {
+        const int last = change.index + change.count - 1;
+        switch (change.kind) {
+        case FileChange::Insert:
+            q->beginInsertRows(parent, change.index, last);
+            data.insert(change.index, change.count, items.at(item));
+            for (int i = change.index; i <= last; ++i)
+                data[i] = items.at(item++);
             q->endInsertRows();
+            countChanged = true;
+            break;
+        case FileChange::Remove:
+            q->beginRemoveRows(parent, change.index, last);
+            data.remove(change.index, change.count);
+            q->endRemoveRows();
+            countChanged = true;
+            break;
+        case FileChange::Update:
+            for (int i = change.index; i <= last; ++i)
+                data[i] = items.at(item++);
+            emit q->dataChanged(q->createIndex(change.index, 0), q->createIndex(last, 0));
+            break;
         }
-        emit q->rowCountChanged();
     }
+
+    if (countChanged)
+        emit q->rowCountChanged();
 }
 
 void QQuickFolderListModelPrivate::_q_sortFinished(const QList<FileProperty> &list)
@@ -265,6 +282,18 @@ QString QQuickFolderListModelPrivate::resolvePath(const QUrl &path)
     that the user can access. The \l showOnlyReadable property can be set to
     enable this feature.
 
+    \section1 Updates
+
+    When the contents of the folder change, or a filter is changed, the model
+    compares the new contents with the current rows by file name and reports
+    the difference as row insertions, removals and data changes, so views keep
+    their delegates and scroll position. Changing the sort order or the folder
+    still replaces all rows.
+
+    When \l sortField is \c FolderListModel.Unsorted, the contents of a newly set
+    folder are delivered in pages while the folder is being read, so the first
+    rows are available before a large folder has been read completely.
+
     \section1 Example Usage
 
     The following example shows a FolderListModel being used to provide a list
@@ -416,8 +445,11 @@ void QQuickFolderListModel::setFolder(const QUrl &folder)
 
     QString resolvedPath = QQuickFolderListModelPrivate::resolvePath(folder);
 
-    qCDebug(lcFolderListModel) << "about to emit beginResetModel since our folder was set to" << folder;
-    beginResetModel();
+    // A reset still waiting for the listing of the previous folder is taken over by this one.
+    if (!d->resetPending) {
+        qCDebug(lcFolderListModel) << "about to emit beginResetModel since our folder was set to" << folder;
+        beginResetModel();
+    }
 
     //Remove the old path for the file system watcher
     if (!d->currentDir.isEmpty())
@@ -428,6 +460,7 @@ void QQuickFolderListModel::setFolder(const QUrl &folder)
     QFileInfo info(resolvedPath);
     if (!info.exists() || !info.isDir()) {
         d->data.clear();
+        d->resetPending = false;
         endResetModel();
         emit rowCountChanged();
         if (d->status != QQuickFolderListModel::Null) {
@@ -437,6 +470,7 @@ void QQuickFolderListModel::setFolder(const QUrl &folder)
         return;
     }
 
+    d->resetPending = true;
     d->fileInfoThread.setPath(resolvedPath);
 }
 
@@ -3,10 +3,17 @@
 
 #include "qqmltablemodel_p.h"
 
+#include <QtCore/qcborarray.h>
+#include <QtCore/qcbormap.h>
+#include <QtCore/qcborvalue.h>
 #include <QtCore/qloggingcategory.h>
 #include <QtQml/qqmlinfo.h>
 #include <QtQml/qqmlengine.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcTableModel, "qt.qml.tablemodel")
@@ -112,6 +119,31 @@ Q_LOGGING_CATEGORY(lcTableModel, "qt.qml.tablemodel")
     \note Row manipulation functions such as \l appendRow(), \l removeRow(),
     etc. are not supported when using complex rows.
 
+    \section1 Columnar Storage
+
+    By default, TableModel keeps a copy of each row object. For large tables
+    of simple rows, setting \l storage to \c TableModel.ColumnarStorage
+    stores the values of each row property in a single array of the type
+    that the property has in the first row, which takes far less memory and
+    lets data() read cells directly:
+
+    \code
+    TableModel {
+        storage: TableModel.ColumnarStorage
+
+        TableModelColumn { display: "name" }
+        TableModelColumn { display: "price" }
+
+        rows: [
+            { name: "Apple", price: 1.50 },
+            // ...
+        ]
+    }
+    \endcode
+
+    Large tables can also be loaded in one go from CBOR with
+    \l setRowsFromCbor().
+
     \section1 Using DelegateChooser with TableModel
 
     For most real world use cases, it is recommended to use DelegateChooser
@@ -147,11 +179,22 @@ QQmlTableModel::~QQmlTableModel()
 
     \snippet qml/tablemodel/fruit-example-simpledelegate.qml rows
 
+    With \l {storage}{columnar storage}, the rows are rebuilt from the
+    columns each time this property is read, and only contain the properties
+    that are used by a TableModelColumn.
+
     \sa getRow(), setRow(), moveRow(), appendRow(), insertRow(), clear(), rowCount, columnCount
 */
 QVariant QQmlTableModel::rows() const
 {
-    return mRows;
+    if (!mColumnar)
+        return mRows;
+
+    QVariantList rows;
+    rows.reserve(mRowCount);
+    for (int rowIndex = 0; rowIndex < mRowCount; ++rowIndex)
+        rows.append(rowAt(rowIndex));
+    return rows;
 }
 
 void QQmlTableModel::setRows(const QVariant &rows)
@@ -162,6 +205,12 @@ void QQmlTableModel::setRows(const QVariant &rows)
     }
 
     const QJSValue rowsAsJSValue = rows.value<QJSValue>();
+    if (mColumnar) {
+        // Read the cells straight into the columns, without a QVariantMap per row.
+        setColumnDataFromJS(rowsAsJSValue);
+        return;
+    }
+
     const QVariantList rowsAsVariantList = rowsAsJSValue.toVariant().toList();
     if (rowsAsVariantList == mRows) {
         // No change.
@@ -210,8 +259,10 @@ void QQmlTableModel::doSetRows(const QVariantList &rowsAsVariantList)
     mRowCount = mRows.size();
 
     // Gather metadata the first time rows is set.
-    if (firstTimeValidRowsHaveBeenSet && !mRows.isEmpty())
+    if (firstTimeValidRowsHaveBeenSet && !mRows.isEmpty()) {
         fetchColumnMetadata();
+        setupColumnData();
+    }
 
     endResetModel();
 
@@ -223,6 +274,248 @@ void QQmlTableModel::doSetRows(const QVariantList &rowsAsVariantList)
         emit columnCountChanged();
 }
 
+/*!
+    \qmlproperty enumeration TableModel::storage
+    \since 6.6
+
+    This property holds how the model stores its rows.
+
+    \value TableModel.RowStorage
+        (default) A copy of each row object is kept. Complex rows are
+        supported.
+    \value TableModel.ColumnarStorage
+        The values of each row property are kept in one contiguous array of
+        the property's type (number, string or bool; anything else is kept
+        as a variant), which uses much less memory for large tables and
+        makes reading cells cheap. Every role of each TableModelColumn
+        must be a property name. Properties that no column refers to are
+        dropped.
+
+    The types of the columns are taken from the first row. If a role is
+    given as a function, or a later row does not match those types, the
+    model falls back to row storage and prints a warning.
+
+    This property must be set when the model is declared; it cannot be
+    changed afterwards.
+
+    \sa {Columnar Storage}
+*/
+QQmlTableModel::Storage QQmlTableModel::storage() const
+{
+    return mStorage;
+}
+
+void QQmlTableModel::setStorage(Storage storage)
+{
+    if (mStorage == storage)
+        return;
+
+    if (componentCompleted) {
+        qmlWarning(this) << "storage can only be set when the TableModel is declared";
+        return;
+    }
+
+    mStorage = storage;
+    emit storageChanged();
+}
+
+/*!
+    \qmlmethod TableModel::setRowsFromCbor(ArrayBuffer cbor)
+    \since 6.6
+
+    Replaces the rows of the model with the rows encoded in \a cbor, which
+    must hold a CBOR array of maps that have the same structure as the
+    objects in \l rows.
+
+    This is the fastest way to load a large table: with
+    \l {storage}{columnar storage}, the cells are decoded straight into the
+    column arrays, without creating a JavaScript object per row.
+
+    \sa rows, storage
+*/
+void QQmlTableModel::setRowsFromCbor(const QByteArray &cbor)
+{
+    QCborParserError error;
+    const QCborValue rowsAsCbor = QCborValue::fromCbor(cbor, &error);
+    if (error.error != QCborError::NoError) {
+        qmlWarning(this) << "setRowsFromCbor(): failed to parse CBOR: " << error.errorString();
+        return;
+    }
+
+    if (!rowsAsCbor.isArray()) {
+        qmlWarning(this) << "setRowsFromCbor(): expected an array of rows";
+        return;
+    }
+
+    if (mColumnar) {
+        setColumnDataFromCbor(rowsAsCbor.toArray());
+        return;
+    }
+
+    const QVariantList rowsAsVariantList = rowsAsCbor.toArray().toVariantList();
+    if (!componentCompleted) {
+        // Store the rows until we can call doSetRows() after component completion.
+        mRows = rowsAsVariantList;
+        return;
+    }
+
+    doSetRows(rowsAsVariantList);
+}
+
+void QQmlTableModel::setColumnDataFromJS(const QJSValue &rowsAsJSValue)
+{
+    if (!rowsAsJSValue.isArray()) {
+        qmlWarning(this) << "setRows(): \"rows\" must be an array";
+        return;
+    }
+
+    const int rowCount = rowsAsJSValue.property(QStringLiteral("length")).toInt();
+    QList<ColumnData> columnData = emptyColumnData();
+    for (ColumnData &column : columnData)
+        column.reserve(rowCount);
+
+    for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+        const QJSValue row = rowsAsJSValue.property(quint32(rowIndex));
+        for (ColumnData &column : columnData) {
+            const QJSValue cell = row.property(column.name());
+            if (!storeCell("setRows()", column, rowIndex, cell.toVariant(), !cell.isUndefined()))
+                return;
+        }
+    }
+
+    resetColumnData(std::move(columnData), rowCount);
+}
+
+void QQmlTableModel::setColumnDataFromCbor(const QCborArray &rowsAsCborArray)
+{
+    const int rowCount = int(rowsAsCborArray.size());
+    QList<ColumnData> columnData = emptyColumnData();
+    for (ColumnData &column : columnData)
+        column.reserve(rowCount);
+
+    for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+        const QCborMap row = rowsAsCborArray.at(rowIndex).toMap();
+        for (ColumnData &column : columnData) {
+            const QCborValue cell = row.value(column.name());
+            if (!storeCell("setRowsFromCbor()", column, rowIndex, cell.toVariant(), !cell.isUndefined()))
+                return;
+        }
+    }
+
+    resetColumnData(std::move(columnData), rowCount);
+}
+
+void QQmlTableModel::resetColumnData(QList<ColumnData> &&columnData, int rowCount)
+{
+    const int oldRowCount = mRowCount;
+
+    beginResetModel();
+    mColumnData = std::move(columnData);
+    mRowCount = rowCount;
+    endResetModel();
+
+    emit rowsChanged();
+
+    if (mRowCount != oldRowCount)
+        emit rowCountChanged();
+}
+
+QList<QQmlTableModel::ColumnData> QQmlTableModel::emptyColumnData() const
+{
+    QList<ColumnData> columnData;
+    columnData.reserve(mColumnData.size());
+    for (const ColumnData &column : mColumnData)
+        columnData.append(ColumnData(column.name(), column.type()));
+    return columnData;
+}
+
+/*
+    Moves the rows gathered so far into one ColumnData per row property, now
+    that the metadata tells us which properties are used and of what type.
+*/
+void QQmlTableModel::setupColumnData()
+{
+    if (mStorage != ColumnarStorage || mColumnar)
+        return;
+
+    QHash<QString, int> dataIndexes;
+    QList<ColumnData> columnData;
+    for (const ColumnMetadata &metaData : std::as_const(mColumnMetadata)) {
+        for (const ColumnRoleMetadata &roleData : metaData.roles) {
+            if (!roleData.isStringRole) {
+                qmlWarning(this) << "columnar storage requires every role of each TableModelColumn "
+                    << "to be a property name; using row storage instead";
+                return;
+            }
+            if (!dataIndexes.contains(roleData.name)) {
+                dataIndexes.insert(roleData.name, int(columnData.size()));
+                columnData.append(ColumnData(roleData.name, roleData.type));
+            }
+        }
+    }
+
+    for (ColumnData &column : columnData)
+        column.reserve(mRows.size());
+    for (int rowIndex = 0; rowIndex < mRows.size(); ++rowIndex) {
+        if (!storeRow(columnData, rowIndex, mRows.at(rowIndex).toMap())) {
+            qmlWarning(this) << "row at index " << rowIndex << " does not match the types of "
+                << "the first row; using row storage instead";
+            return;
+        }
+    }
+
+    for (ColumnMetadata &metaData : mColumnMetadata) {
+        for (ColumnRoleMetadata &roleData : metaData.roles)
+            roleData.dataIndex = dataIndexes.value(roleData.name);
+    }
+
+    qCDebug(lcTableModel) << "using columnar storage for" << columnData.size() << "row properties";
+
+    mColumnData = std::move(columnData);
+    mRows.clear();
+    mColumnar = true;
+}
+
+bool QQmlTableModel::storeRow(QList<ColumnData> &columnData, int rowIndex, const QVariantMap &row) const
+{
+    for (ColumnData &column : columnData) {
+        if (!column.insert(rowIndex, row.value(column.name())))
+            return false;
+    }
+    return true;
+}
+
+bool QQmlTableModel::storeCell(const char *functionName, ColumnData &column, int rowIndex,
+    const QVariant &cell, bool found) const
+{
+    if (!found) {
+        qmlWarning(this).quote() << functionName << ": expected a property named "
+            << column.name() << " in row at index " << rowIndex << ", but couldn't find one";
+        return false;
+    }
+
+    if (!column.insert(rowIndex, cell)) {
+        qmlWarning(this).quote() << functionName << ": expected the property named "
+            << column.name() << " in row at index " << rowIndex << " to be of type "
+            << QString::fromLatin1(QMetaType(column.type()).name()) << ", but got "
+            << QString::fromLatin1(cell.typeName()) << " instead";
+        return false;
+    }
+
+    return true;
+}
+
+QVariant QQmlTableModel::rowAt(int rowIndex) const
+{
+    if (!mColumnar)
+        return mRows.at(rowIndex);
+
+    QVariantMap row;
+    for (const ColumnData &column : mColumnData)
+        row.insert(column.name(), column.at(rowIndex));
+    return row;
+}
+
 QQmlTableModel::ColumnRoleMetadata QQmlTableModel::fetchColumnRoleData(const QString &roleNameKey,
     QQmlTableModelColumn *tableModelColumn, int columnIndex) const
 {
@@ -377,7 +670,7 @@ QVariant QQmlTableModel::getRow(int rowIndex)
     if (!validateRowIndex("getRow()", "rowIndex", rowIndex))
         return QVariant();
 
-    return mRows.at(rowIndex);
+    return rowAt(rowIndex);
 }
 
 /*!
@@ -416,15 +709,20 @@ void QQmlTableModel::doInsert(int rowIndex, const QVariant &row)
     // Adding rowAsVariant.toList() will add each invidual variant in the list,
     // which is definitely not what we want.
     const QVariant rowAsVariant = row.value<QJSValue>().toVariant();
-    mRows.insert(rowIndex, rowAsVariant);
+    if (mColumnar)
+        storeRow(mColumnData, rowIndex, rowAsVariant.toMap());
+    else
+        mRows.insert(rowIndex, rowAsVariant);
     ++mRowCount;
 
     qCDebug(lcTableModel).nospace() << "inserted the following row to the model at index "
         << rowIndex << ":\n" << rowAsVariant.toMap();
 
     // Gather metadata the first time a row is added.
-    if (mColumnMetadata.isEmpty())
+    if (mColumnMetadata.isEmpty()) {
         fetchColumnMetadata();
+        setupColumnData();
+    }
 
     endInsertRows();
     emit rowCountChanged();
@@ -510,16 +808,21 @@ void QQmlTableModel::moveRow(int fromRowIndex, int toRowIndex, int rows)
         rows = from - to;
     }
 
-    QVector<QVariant> store;
-    store.reserve(rows);
-    for (int i = 0; i < (toRowIndex - fromRowIndex); ++i)
-        store.append(mRows.at(fromRowIndex + rows + i));
-    for (int i = 0; i < rows; ++i)
-        store.append(mRows.at(fromRowIndex + i));
-    for (int i = 0; i < store.size(); ++i)
-        mRows[fromRowIndex + i] = store[i];
+    if (mColumnar) {
+        for (ColumnData &column : mColumnData)
+            column.rotate(fromRowIndex, fromRowIndex + rows, toRowIndex + rows);
+    } else {
+        QVector<QVariant> store;
+        store.reserve(rows);
+        for (int i = 0; i < (toRowIndex - fromRowIndex); ++i)
+            store.append(mRows.at(fromRowIndex + rows + i));
+        for (int i = 0; i < rows; ++i)
+            store.append(mRows.at(fromRowIndex + i));
+        for (int i = 0; i < store.size(); ++i)
+            mRows[fromRowIndex + i] = store[i];
+    }
 
-    qCDebug(lcTableModel).nospace() << "after moving, rows are:\n" << mRows;
+    qCDebug(lcTableModel).nospace() << "after moving, rows are:\n" << this->rows();
 
     endMoveRows();
 }
@@ -550,10 +853,15 @@ void QQmlTableModel::removeRow(int rowIndex, int rows)
 
     beginRemoveRows(QModelIndex(), rowIndex, rowIndex + rows - 1);
 
-    auto firstIterator = mRows.begin() + rowIndex;
-    // The "last" argument to erase() is exclusive, so we go one past the last item.
-    auto lastIterator = firstIterator + rows;
-    mRows.erase(firstIterator, lastIterator);
+    if (mColumnar) {
+        for (ColumnData &column : mColumnData)
+            column.remove(rowIndex, rows);
+    } else {
+        auto firstIterator = mRows.begin() + rowIndex;
+        // The "last" argument to erase() is exclusive, so we go one past the last item.
+        auto lastIterator = firstIterator + rows;
+        mRows.erase(firstIterator, lastIterator);
+    }
     mRowCount -= rows;
 
     endRemoveRows();
@@ -592,7 +900,13 @@ void QQmlTableModel::setRow(int rowIndex, const QVariant &row)
 
     if (rowIndex != mRowCount) {
         // Setting an existing row.
-        mRows[rowIndex] = row;
+        if (mColumnar) {
+            const QVariantMap rowAsMap = row.value<QJSValue>().toVariant().toMap();
+            for (ColumnData &column : mColumnData)
+                column.replace(rowIndex, rowAsMap.value(column.name()));
+        } else {
+            mRows[rowIndex] = row;
+        }
 
         // For now we just assume the whole row changed, as it's simpler.
         const QModelIndex topLeftModelIndex(createIndex(rowIndex, 0));
@@ -757,16 +1071,20 @@ QVariant QQmlTableModel::data(const QModelIndex &index, int role) const
     if (column < 0 || column >= columnCount())
         return QVariant();
 
-    const ColumnMetadata columnMetadata = mColumnMetadata.at(index.column());
+    const ColumnMetadata &columnMetadata = mColumnMetadata.at(index.column());
     const QString roleName = QString::fromUtf8(mRoleNames.value(role));
-    if (!columnMetadata.roles.contains(roleName)) {
+    const auto roleIt = columnMetadata.roles.constFind(roleName);
+    if (roleIt == columnMetadata.roles.cend()) {
         qmlWarning(this) << "setData(): no role named " << roleName
             << " at column index " << column << ". The available roles for that column are: "
             << columnMetadata.roles.keys();
         return QVariant();
     }
 
-    const ColumnRoleMetadata roleData = columnMetadata.roles.value(roleName);
+    const ColumnRoleMetadata &roleData = *roleIt;
+    if (roleData.isStringRole && mColumnar)
+        return mColumnData.at(roleData.dataIndex).at(row);
+
     if (roleData.isStringRole) {
         // We know the data structure, so we can get the data for the user.
         const QVariantMap rowData = mRows.at(row).toMap();
@@ -844,7 +1162,9 @@ bool QQmlTableModel::setData(const QModelIndex &index, const QVariant &value, in
         }
     }
 
-    if (roleData.isStringRole) {
+    if (roleData.isStringRole && mColumnar) {
+        mColumnData[roleData.dataIndex].replace(row, effectiveValue);
+    } else if (roleData.isStringRole) {
         // We know the data structure, so we can set it for the user.
         QVariantMap modifiedRow = mRows.at(row).toMap();
         modifiedRow[roleData.name] = value;
@@ -927,6 +1247,162 @@ bool QQmlTableModel::ColumnRoleMetadata::isValid() const
     return !name.isEmpty();
 }
 
+QQmlTableModel::ColumnData::ColumnData(const QString &name, int type) :
+    mName(name),
+    mType(type)
+{
+    switch (type) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        mKind = Number;
+        break;
+    case QMetaType::QString:
+        mKind = String;
+        break;
+    case QMetaType::Bool:
+        mKind = Bool;
+        break;
+    default:
+        mKind = Variant;
+        break;
+    }
+}
+
+template <typename Function>
+void QQmlTableModel::ColumnData::visit(Function &&function)
+{
+    switch (mKind) {
+    case Number:
+        function(mNumbers);
+        break;
+    case String:
+        function(mStrings);
+        break;
+    case Bool:
+        function(mBools);
+        break;
+    case Variant:
+        function(mVariants);
+        break;
+    }
+}
+
+QVariant QQmlTableModel::ColumnData::at(int row) const
+{
+    switch (mKind) {
+    case Number: {
+        // Integers come back with the type the column was created with, as they would
+        // with row storage; JavaScript numbers are doubles either way.
+        const double number = mNumbers.at(row);
+        if (std::trunc(number) == number) {
+            if (mType == QMetaType::Int && number >= std::numeric_limits<int>::min()
+                    && number <= std::numeric_limits<int>::max()) {
+                return int(number);
+            }
+            if (mType == QMetaType::LongLong && std::abs(number) <= 9007199254740992.0)
+                return qint64(number);
+        }
+        return number;
+    }
+    case String:
+        return mStrings.at(row);
+    case Bool:
+        return mBools.at(row);
+    case Variant:
+        break;
+    }
+    return mVariants.at(row);
+}
+
+bool QQmlTableModel::ColumnData::convert(const QVariant &value, QVariant &converted) const
+{
+    converted = value;
+
+    QMetaType storedType;
+    switch (mKind) {
+    case Number:
+        storedType = QMetaType::fromType<double>();
+        break;
+    case String:
+        storedType = QMetaType::fromType<QString>();
+        break;
+    case Bool:
+        storedType = QMetaType::fromType<bool>();
+        break;
+    case Variant:
+        return true;
+    }
+
+    return converted.metaType() == storedType || converted.convert(storedType);
+}
+
+bool QQmlTableModel::ColumnData::insert(int row, const QVariant &value)
+{
+    QVariant converted;
+    if (!convert(value, converted))
+        return false;
+
+    switch (mKind) {
+    case Number:
+        mNumbers.insert(row, converted.toDouble());
+        break;
+    case String:
+        mStrings.insert(row, converted.toString());
+        break;
+    case Bool:
+        mBools.insert(row, converted.toBool());
+        break;
+    case Variant:
+        mVariants.insert(row, converted);
+        break;
+    }
+    return true;
+}
+
+bool QQmlTableModel::ColumnData::replace(int row, const QVariant &value)
+{
+    QVariant converted;
+    if (!convert(value, converted))
+        return false;
+
+    switch (mKind) {
+    case Number:
+        mNumbers[row] = converted.toDouble();
+        break;
+    case String:
+        mStrings[row] = converted.toString();
+        break;
+    case Bool:
+        mBools[row] = converted.toBool();
+        break;
+    case Variant:
+        mVariants[row] = converted;
+        break;
+    }
+    return true;
+}
+
+void QQmlTableModel::ColumnData::remove(int row, int count)
+{
+    visit([&](auto &list) { list.remove(row, count); });
+}
+
+void QQmlTableModel::ColumnData::rotate(int first, int middle, int last)
+{
+    visit([&](auto &list) {
+        std::rotate(list.begin() + first, list.begin() + middle, list.begin() + last);
+    });
+}
+
+void QQmlTableModel::ColumnData::reserve(int size)
+{
+    visit([&](auto &list) { list.reserve(size); });
+}
+
 bool QQmlTableModel::validateRowType(const char *functionName, const QVariant &row) const
 {
     if (!row.canConvert<QJSValue>()) {
@@ -30,6 +30,8 @@ QT_REQUIRE_CONFIG(qml_table_model);
 
 QT_BEGIN_NAMESPACE
 
+class QCborArray;
+
 class Q_LABSQMLMODELS_PRIVATE_EXPORT QQmlTableModel : public QAbstractTableModel, public QQmlParserStatus
 {
     Q_OBJECT
@@ -37,18 +39,30 @@ class Q_LABSQMLMODELS_PRIVATE_EXPORT QQmlTableModel : public QAbstractTableModel
     Q_PROPERTY(int rowCount READ rowCount NOTIFY rowCountChanged FINAL)
     Q_PROPERTY(QVariant rows READ rows WRITE setRows NOTIFY rowsChanged FINAL)
     Q_PROPERTY(QQmlListProperty<QQmlTableModelColumn> columns READ columns CONSTANT FINAL)
+    Q_PROPERTY(Storage storage READ storage WRITE setStorage NOTIFY storageChanged REVISION(6, 6) FINAL)
     Q_INTERFACES(QQmlParserStatus)
     Q_CLASSINFO("DefaultProperty", "columns")
     QML_NAMED_ELEMENT(TableModel)
     QML_ADDED_IN_VERSION(1, 0)
 
 public:
+    enum Storage {
+        RowStorage,
+        ColumnarStorage
+    };
+    Q_ENUM(Storage)
+
     QQmlTableModel(QObject *parent = nullptr);
     ~QQmlTableModel() override;
 
     QVariant rows() const;
     void setRows(const QVariant &rows);
 
+    Storage storage() const;
+    void setStorage(Storage storage);
+
+    Q_REVISION(6, 6) Q_INVOKABLE void setRowsFromCbor(const QByteArray &cbor);
+
     Q_INVOKABLE void appendRow(const QVariant &row);
     Q_INVOKABLE void clear();
     Q_INVOKABLE QVariant getRow(int rowIndex);
@@ -80,6 +94,7 @@ Q_SIGNALS:
     void columnCountChanged();
     void rowCountChanged();
     void rowsChanged();
+    Q_REVISION(6, 6) void storageChanged();
 
 private:
     class ColumnRoleMetadata
@@ -95,6 +110,8 @@ private:
         QString name;
         int type = QMetaType::UnknownType;
         QString typeName;
+        // Index into mColumnData when the model uses columnar storage.
+        int dataIndex = -1;
     };
 
     struct ColumnMetadata
@@ -104,6 +121,37 @@ private:
         QHash<QString, ColumnRoleMetadata> roles;
     };
 
+    // The values of one row property in a contiguous array of the property's type.
+    class ColumnData
+    {
+    public:
+        ColumnData(const QString &name = QString(), int type = QMetaType::UnknownType);
+
+        QString name() const { return mName; }
+        int type() const { return mType; }
+        QVariant at(int row) const;
+        bool insert(int row, const QVariant &value);
+        bool replace(int row, const QVariant &value);
+        void remove(int row, int count);
+        void rotate(int first, int middle, int last);
+        void reserve(int size);
+
+    private:
+        enum Kind { Number, String, Bool, Variant };
+
+        bool convert(const QVariant &value, QVariant &converted) const;
+        template <typename Function>
+        void visit(Function &&function);
+
+        QString mName;
+        int mType = QMetaType::UnknownType;
+        Kind mKind = Variant;
+        QList<double> mNumbers;
+        QList<QString> mStrings;
+        QList<bool> mBools;
+        QVariantList mVariants;
+    };
+
     enum NewRowOperationFlag {
         OtherOperation, // insert(), set(), etc.
         SetRowsOperation,
@@ -111,6 +159,15 @@ private:
     };
 
     void doSetRows(const QVariantList &rowsAsVariantList);
+    void setColumnDataFromJS(const QJSValue &rowsAsJSValue);
+    void setColumnDataFromCbor(const QCborArray &rowsAsCborArray);
+    void resetColumnData(QList<ColumnData> &&columnData, int rowCount);
+    QList<ColumnData> emptyColumnData() const;
+    void setupColumnData();
+    bool storeRow(QList<ColumnData> &columnData, int rowIndex, const QVariantMap &row) const;
+    bool storeCell(const char *functionName, ColumnData &column, int rowIndex,
+        const QVariant &cell, bool found) const;
+    QVariant rowAt(int rowIndex) const;
     ColumnRoleMetadata fetchColumnRoleData(const QString &roleNameKey,
         QQmlTableModelColumn *tableModelColumn, int columnIndex) const;
     void fetchColumnMetadata();
@@ -127,6 +184,10 @@ private:
 
     bool componentCompleted = false;
     QVariantList mRows;
+    Storage mStorage = RowStorage;
+    // True once the rows have moved from mRows into mColumnData.
+    bool mColumnar = false;
+    QList<ColumnData> mColumnData;
     QList<QQmlTableModelColumn *> mColumns;
     int mRowCount = 0;
     int mColumnCount = 0;
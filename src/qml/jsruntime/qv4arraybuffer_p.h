@@ -50,6 +50,13 @@ struct Q_QML_PRIVATE_EXPORT SharedArrayBuffer : Object {
 
     bool arrayDataNeedsDetach() const noexcept { return constArrayDataPointer().needsDetach(); }
 
+    QByteArray sharedArrayData() const noexcept
+    {
+        QByteArray array;
+        array.data_ptr() = *reinterpret_cast<const QArrayDataPointer<char> *>(&arrayDataPointerStorage);
+        return array;
+    }
+
 private:
     const QArrayDataPointer<const char> &constArrayDataPointer() const noexcept
     {
@@ -128,6 +135,8 @@ struct Q_QML_PRIVATE_EXPORT ArrayBuffer : SharedArrayBuffer
     const char *constArrayData() const { return d()->constArrayData(); }
     bool hasSharedArrayData() { return d()->hasSharedArrayData(); }
     void detachArrayData() { d()->detachArrayData(); }
+    // Shares the storage instead of copying it, unlike asByteArray().
+    QByteArray sharedByteArray() const { return d()->sharedArrayData(); }
 
     void detach();
 };
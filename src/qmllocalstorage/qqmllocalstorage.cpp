@@ -10,9 +10,12 @@
 #include <QtQml/private/qv4sqlerrors_p.h>
 #include <QtQml/private/qv4jscall_p.h>
 #include <QtQml/private/qv4objectiterator_p.h>
+#include <QtQml/private/qv4promiseobject_p.h>
 
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qthread.h>
 
 #include <QtSql/qsqldatabase.h>
 #include <QtSql/qsqlquery.h>
@@ -23,6 +26,9 @@
 #include <QtCore/qsettings.h>
 #endif
 
+#include <limits>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 #define V4THROW_SQL(error, desc) { \
@@ -48,15 +54,83 @@ QT_BEGIN_NAMESPACE
 }
 
 
+// The asynchronous API runs jobs on a connection thread, one per engine. Jobs are
+// described by plain data, so that no JavaScript value crosses the thread boundary.
+struct QQmlSqlBinding
+{
+    QStringList names; // bound by position if empty
+    QVariantList values;
+};
+
+struct QQmlSqlStatement
+{
+    QString sql;
+    QList<QQmlSqlBinding> bindings; // the statement is executed once per binding
+};
+
+struct QQmlSqlJob
+{
+    QString connectionName;
+    QString databaseName;
+    QList<QQmlSqlStatement> statements;
+    bool readOnly = false;
+};
+
+struct QQmlSqlStatementResult
+{
+    QStringList columns;
+    QVariantList cells; // row by row
+    int rowsAffected = 0;
+    QString insertId;
+};
+
+struct QQmlSqlJobResult
+{
+    QList<QQmlSqlStatementResult> statements;
+    QString error;
+    int errorCode = 0;
+};
+
+class QQmlSqlConnectionWorker : public QObject
+{
+public:
+    ~QQmlSqlConnectionWorker() override;
+
+    QQmlSqlJobResult run(const QQmlSqlJob &job);
+
+private:
+    QSqlQuery *preparedQuery(const QSqlDatabase &db, const QString &sql, QString *error);
+
+    QCache<QString, QSqlQuery> m_preparedQueries { 64 };
+    QStringList m_connectionNames;
+};
+
 class QQmlSqlDatabaseData : public QV4::ExecutionEngine::Deletable
 {
 public:
     QQmlSqlDatabaseData(QV4::ExecutionEngine *engine);
     ~QQmlSqlDatabaseData() override;
 
+    QV4::ReturnedValue post(QQmlSqlJob &&job, bool singleStatement);
+    void finish(quint64 id, const QQmlSqlJobResult &result);
+
     QV4::PersistentValue databaseProto;
     QV4::PersistentValue queryProto;
     QV4::PersistentValue rowsProto;
+
+private:
+    struct PendingJob
+    {
+        QV4::PersistentValue capability;
+        bool singleStatement = false;
+    };
+
+    QV4::ExecutionEngine *m_engine;
+    QThread *m_connectionThread = nullptr;
+    QQmlSqlConnectionWorker *m_connectionWorker = nullptr;
+    QObject m_resultReceiver;
+    QHash<quint64, PendingJob> m_pendingJobs;
+    quint64 m_nextJobId = 0;
 };
 
 V4_DEFINE_EXTENSION(QQmlSqlDatabaseData, databaseData)
@@ -173,6 +247,12 @@ static ReturnedValue qmlsqldatabase_rows_setForwardOnly(const FunctionObject *b,
 
 QQmlSqlDatabaseData::~QQmlSqlDatabaseData()
 {
+    if (m_connectionThread) {
+        // The worker closes its connections in the connection thread, see the constructor.
+        m_connectionThread->quit();
+        m_connectionThread->wait();
+        delete m_connectionThread;
+    }
 }
 
 static ReturnedValue qmlsqldatabase_rows_index(const QQmlSqlDatabaseWrapper *r, ExecutionEngine *v4, quint32 index, bool *hasProperty = nullptr)
@@ -457,13 +537,388 @@ static ReturnedValue qmlsqldatabase_read_transaction(const FunctionObject *f, co
     return qmlsqldatabase_transaction_shared(f, thisObject, argv, argc, true);
 }
 
+QQmlSqlConnectionWorker::~QQmlSqlConnectionWorker()
+{
+    m_preparedQueries.clear();
+    for (const QString &connectionName : std::as_const(m_connectionNames)) {
+        QSqlDatabase::database(connectionName, false).close();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+}
+
+QSqlQuery *QQmlSqlConnectionWorker::preparedQuery(const QSqlDatabase &db, const QString &sql,
+                                                  QString *error)
+{
+    const QString key = db.connectionName() + QLatin1Char('\n') + sql;
+    if (QSqlQuery *query = m_preparedQueries.object(key))
+        return query;
+
+    auto query = std::make_unique<QSqlQuery>(db);
+    if (!query->prepare(sql)) {
+        *error = query->lastError().text();
+        return nullptr;
+    }
+    QSqlQuery *rv = query.get();
+    m_preparedQueries.insert(key, query.release());
+    return rv;
+}
+
+QQmlSqlJobResult QQmlSqlConnectionWorker::run(const QQmlSqlJob &job)
+{
+    QQmlSqlJobResult result;
+
+    // Connections are bound to the thread that created them, so the connection
+    // thread opens its own one to the database file.
+    QSqlDatabase db = QSqlDatabase::database(job.connectionName);
+    if (!db.isValid()) {
+        db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), job.connectionName);
+        db.setDatabaseName(job.databaseName);
+        // Wait for the locks held by the connection of the engine thread.
+        db.setConnectOptions(QLatin1String("QSQLITE_BUSY_TIMEOUT=5000"));
+        m_connectionNames.append(job.connectionName);
+    }
+    if (!db.isOpen() && !db.open()) {
+        result.errorCode = SQLEXCEPTION_DATABASE_ERR;
+        result.error = db.lastError().text();
+        return result;
+    }
+
+    auto fail = [&](int code, const QString &error) {
+        db.rollback();
+        result.statements.clear();
+        result.errorCode = code;
+        result.error = error;
+        return result;
+    };
+
+    db.transaction();
+    for (const QQmlSqlStatement &statement : job.statements) {
+        if (job.readOnly && !statement.sql.startsWith(QLatin1String("SELECT"), Qt::CaseInsensitive))
+            return fail(SQLEXCEPTION_SYNTAX_ERR, QQmlEngine::tr("Read-only Transaction"));
+
+        QString error;
+        QSqlQuery *query = preparedQuery(db, statement.sql, &error);
+        if (!query)
+            return fail(SQLEXCEPTION_DATABASE_ERR, error);
+
+        QQmlSqlStatementResult &statementResult = result.statements.emplace_back();
+        for (const QQmlSqlBinding &binding : statement.bindings) {
+            for (qsizetype ii = 0; ii < binding.values.size(); ++ii) {
+                if (binding.names.isEmpty())
+                    query->bindValue(int(ii), binding.values.at(ii));
+                else
+                    query->bindValue(binding.names.at(ii), binding.values.at(ii));
+            }
+            if (!query->exec()) {
+                error = query->lastError().text();
+                query->finish();
+                return fail(SQLEXCEPTION_DATABASE_ERR, error);
+            }
+            statementResult.rowsAffected += qMax(0, query->numRowsAffected());
+        }
+
+        if (query->isSelect()) {
+            const QSqlRecord record = query->record();
+            const int columnCount = record.count();
+            statementResult.columns.reserve(columnCount);
+            for (int ii = 0; ii < columnCount; ++ii)
+                statementResult.columns.append(record.fieldName(ii));
+            while (query->next()) {
+                for (int ii = 0; ii < columnCount; ++ii)
+                    statementResult.cells.append(query->value(ii));
+            }
+        }
+        statementResult.insertId = query->lastInsertId().toString();
+        query->finish();
+    }
+
+    if (!db.commit())
+        return fail(SQLEXCEPTION_UNKNOWN_ERR, QQmlEngine::tr("SQL transaction failed"));
+
+    return result;
+}
+
+static ReturnedValue qmlsqldatabase_error(Scope &scope, int code, const QString &desc)
+{
+    QV4::ScopedString v(scope, scope.engine->newString(desc));
+    QV4::ScopedObject ex(scope, scope.engine->newErrorObject(v));
+    ex->put(QV4::ScopedString(scope, scope.engine->newIdentifier(QStringLiteral("code"))).getPointer(),
+            QV4::ScopedValue(scope, Value::fromInt32(code)));
+    return ex.asReturnedValue();
+}
+
+// Converts the types the SQLite driver produces directly, without going
+// through the generic QVariant conversion of the engine.
+static ReturnedValue qmlsqldatabase_cell(ExecutionEngine *v4, const QVariant &value)
+{
+    if (value.isNull())
+        return Encode::null();
+
+    switch (value.typeId()) {
+    case QMetaType::Int:
+        return Encode(value.toInt());
+    case QMetaType::LongLong: {
+        const qint64 number = value.toLongLong();
+        if (number >= std::numeric_limits<int>::min() && number <= std::numeric_limits<int>::max())
+            return Encode(int(number));
+        return Encode(double(number));
+    }
+    case QMetaType::Double:
+        return Encode(value.toDouble());
+    case QMetaType::QString:
+        return Encode(v4->newString(value.toString()));
+    default:
+        return v4->fromVariant(value);
+    }
+}
+
+static ReturnedValue qmlsqldatabase_statementResult(ExecutionEngine *v4,
+                                                    const QQmlSqlStatementResult &result)
+{
+    Scope scope(v4);
+    const qsizetype columnCount = result.columns.size();
+    const qsizetype rowCount = columnCount ? result.cells.size() / columnCount : 0;
+
+    ScopedArrayObject rows(scope, v4->newArrayObject());
+    rows->arrayReserve(rowCount);
+    {
+        // The column names are made identifiers once, not once per row.
+        Value *names = scope.alloc(int(columnCount));
+        for (qsizetype jj = 0; jj < columnCount; ++jj)
+            names[jj] = v4->newIdentifier(result.columns.at(jj));
+
+        ScopedObject row(scope);
+        ScopedString name(scope);
+        ScopedValue cell(scope);
+        for (qsizetype ii = 0; ii < rowCount; ++ii) {
+            row = v4->newObject();
+            for (qsizetype jj = 0; jj < columnCount; ++jj) {
+                name = names[jj];
+                cell = qmlsqldatabase_cell(v4, result.cells.at(ii * columnCount + jj));
+                row->put(name.getPointer(), cell);
+            }
+            rows->arrayPut(ii, row);
+        }
+        rows->setArrayLengthUnchecked(rowCount);
+    }
+
+    ScopedObject resultObject(scope, v4->newObject());
+    ScopedString s(scope);
+    ScopedValue v(scope);
+    resultObject->put((s = v4->newIdentifier(QLatin1String("rowsAffected"))).getPointer(),
+                      (v = Value::fromInt32(result.rowsAffected)));
+    resultObject->put((s = v4->newIdentifier(QLatin1String("insertId"))).getPointer(),
+                      (v = v4->newString(result.insertId)));
+    resultObject->put((s = v4->newIdentifier(QLatin1String("rows"))).getPointer(), rows);
+    return resultObject.asReturnedValue();
+}
+
+ReturnedValue QQmlSqlDatabaseData::post(QQmlSqlJob &&job, bool singleStatement)
+{
+    Scope scope(m_engine);
+    Scoped<PromiseCapability> capability(
+                scope, m_engine->memoryManager->allocate<QV4::PromiseCapability>());
+    ScopedObject promise(scope, m_engine->newPromiseObject(m_engine->promiseCtor(), capability));
+    if (scope.hasException())
+        return Encode::undefined();
+
+    if (!m_connectionThread) {
+        m_connectionThread = new QThread;
+        m_connectionThread->setObjectName(QStringLiteral("QQmlSqlConnectionThread"));
+        m_connectionWorker = new QQmlSqlConnectionWorker;
+        m_connectionWorker->moveToThread(m_connectionThread);
+        QObject::connect(m_connectionThread, &QThread::finished,
+                         m_connectionWorker, &QObject::deleteLater);
+        m_connectionThread->start();
+    }
+
+    const quint64 id = m_nextJobId++;
+    m_pendingJobs.insert(id, { QV4::PersistentValue(m_engine, capability.asReturnedValue()),
+                              singleStatement });
+
+    // Results are delivered through m_resultReceiver, so that they are dropped
+    // rather than delivered to a dead engine.
+    QQmlSqlConnectionWorker *worker = m_connectionWorker;
+    QObject *receiver = &m_resultReceiver;
+    QMetaObject::invokeMethod(worker, [this, worker, receiver, id, job = std::move(job)]() {
+        QQmlSqlJobResult result = worker->run(job);
+        QMetaObject::invokeMethod(receiver, [this, id, result = std::move(result)]() {
+            finish(id, result);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+
+    return promise.asReturnedValue();
+}
+
+void QQmlSqlDatabaseData::finish(quint64 id, const QQmlSqlJobResult &result)
+{
+    const PendingJob job = m_pendingJobs.take(id);
+
+    Scope scope(m_engine);
+    Scoped<PromiseCapability> capability(scope, job.capability.value());
+    Q_ASSERT(capability);
+
+    ScopedValue value(scope);
+    ScopedFunctionObject settle(scope);
+    if (!result.error.isEmpty() || result.errorCode) {
+        value = qmlsqldatabase_error(scope, result.errorCode, result.error);
+        settle = capability->d()->reject;
+    } else if (job.singleStatement) {
+        value = qmlsqldatabase_statementResult(m_engine, result.statements.first());
+        settle = capability->d()->resolve;
+    } else {
+        ScopedArrayObject results(scope, m_engine->newArrayObject());
+        for (const QQmlSqlStatementResult &statement : result.statements) {
+            value = qmlsqldatabase_statementResult(m_engine, statement);
+            results->push_back(value);
+        }
+        value = results.asReturnedValue();
+        settle = capability->d()->resolve;
+    }
+
+    ScopedValue undefined(scope, Value::undefinedValue());
+    settle->call(undefined, value, 1);
+    if (scope.hasException())
+        scope.engine->catchException();
+}
+
+static bool toSqlBinding(Scope &scope, const Value &values, QQmlSqlBinding *binding)
+{
+    if (const ArrayObject *array = values.as<ArrayObject>()) {
+        const quint32 size = array->getLength();
+        binding->values.reserve(size);
+        QV4::ScopedValue v(scope);
+        for (quint32 ii = 0; ii < size; ++ii)
+            binding->values.append(toSqlVariant((v = array->get(ii))));
+    } else if (values.as<Object>()) {
+        ScopedObject object(scope, values);
+        ObjectIterator it(scope, object, ObjectIterator::EnumerableOnly);
+        ScopedValue key(scope);
+        QV4::ScopedValue val(scope);
+        while (1) {
+            key = it.nextPropertyName(val);
+            if (key->isNull())
+                break;
+            binding->names.append(key->isString() ? key->stringValue()->toQString()
+                                                  : QString::number(key->integerValue()));
+            binding->values.append(toSqlVariant(val));
+        }
+    } else if (!values.isUndefined()) {
+        binding->values.append(toSqlVariant(ScopedValue(scope, values)));
+    }
+    return !scope.hasException();
+}
+
+// A statement is either a string or an object with an "sql" string and optional
+// "values", or "batch" array of values to execute the statement with in turn.
+static bool toSqlStatement(Scope &scope, const Value &value, QQmlSqlStatement *statement)
+{
+    ScopedObject object(scope, value);
+    if (!object) {
+        statement->sql = value.toQString();
+        statement->bindings.append(QQmlSqlBinding());
+        return !scope.hasException();
+    }
+
+    ScopedString name(scope, scope.engine->newIdentifier(QStringLiteral("sql")));
+    ScopedValue v(scope, object->get(name));
+    statement->sql = v->toQString();
+
+    name = scope.engine->newIdentifier(QStringLiteral("batch"));
+    ScopedArrayObject batch(scope, object->get(name));
+    if (batch) {
+        const quint32 size = batch->getLength();
+        statement->bindings.resize(size);
+        for (quint32 ii = 0; ii < size; ++ii) {
+            if (!toSqlBinding(scope, (v = batch->get(ii)), &statement->bindings[ii]))
+                return false;
+        }
+        return true;
+    }
+
+    name = scope.engine->newIdentifier(QStringLiteral("values"));
+    v = object->get(name);
+    return toSqlBinding(scope, v, &statement->bindings.emplace_back());
+}
+
+static bool qmlsqldatabase_job(Scope &scope, const QQmlSqlDatabaseWrapper *r, QQmlSqlJob *job)
+{
+    const QSqlDatabase &db = *r->d()->database;
+    job->connectionName = db.connectionName() + QLatin1String("-async-")
+            + QString::number(quintptr(databaseData(scope.engine)), 16);
+    job->databaseName = db.databaseName();
+    return !job->databaseName.isEmpty();
+}
+
+static ReturnedValue qmlsqldatabase_transaction_async_shared(const FunctionObject *b, const Value *thisObject, const Value *argv, int argc, bool readOnly)
+{
+    Scope scope(b);
+    QV4::Scoped<QQmlSqlDatabaseWrapper> r(scope, thisObject->as<QQmlSqlDatabaseWrapper>());
+    if (!r || r->d()->type != Heap::QQmlSqlDatabaseWrapper::Database)
+        V4THROW_REFERENCE("Not a SQLDatabase object");
+
+    ScopedArrayObject statements(scope, argc ? argv[0] : Value::undefinedValue());
+    if (!statements)
+        V4THROW_SQL(SQLEXCEPTION_UNKNOWN_ERR, QQmlEngine::tr("transaction: missing statements"));
+
+    QQmlSqlJob job;
+    if (!qmlsqldatabase_job(scope, r, &job))
+        V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR, QQmlEngine::tr("SQL: database is not open"));
+    job.readOnly = readOnly;
+
+    const quint32 size = statements->getLength();
+    job.statements.resize(size);
+    ScopedValue v(scope);
+    for (quint32 ii = 0; ii < size; ++ii) {
+        if (!toSqlStatement(scope, (v = statements->get(ii)), &job.statements[ii]))
+            RETURN_UNDEFINED();
+    }
+
+    RETURN_RESULT(databaseData(scope.engine)->post(std::move(job), false));
+}
+
+static ReturnedValue qmlsqldatabase_transaction_async(const FunctionObject *f, const Value *thisObject, const Value *argv, int argc)
+{
+    return qmlsqldatabase_transaction_async_shared(f, thisObject, argv, argc, false);
+}
+
+static ReturnedValue qmlsqldatabase_read_transaction_async(const FunctionObject *f, const Value *thisObject, const Value *argv, int argc)
+{
+    return qmlsqldatabase_transaction_async_shared(f, thisObject, argv, argc, true);
+}
+
+static ReturnedValue qmlsqldatabase_executeSql_async(const FunctionObject *b, const Value *thisObject, const Value *argv, int argc)
+{
+    Scope scope(b);
+    QV4::Scoped<QQmlSqlDatabaseWrapper> r(scope, thisObject->as<QQmlSqlDatabaseWrapper>());
+    if (!r || r->d()->type != Heap::QQmlSqlDatabaseWrapper::Database)
+        V4THROW_REFERENCE("Not a SQLDatabase object");
+
+    QQmlSqlJob job;
+    if (!qmlsqldatabase_job(scope, r, &job))
+        V4THROW_SQL(SQLEXCEPTION_DATABASE_ERR, QQmlEngine::tr("SQL: database is not open"));
+
+    QQmlSqlStatement &statement = job.statements.emplace_back();
+    statement.sql = argc ? argv[0].toQString() : QString();
+    if (!toSqlBinding(scope, argc > 1 ? argv[1] : Value::undefinedValue(),
+                      &statement.bindings.emplace_back())) {
+        RETURN_UNDEFINED();
+    }
+
+    RETURN_RESULT(databaseData(scope.engine)->post(std::move(job), true));
+}
+
 QQmlSqlDatabaseData::QQmlSqlDatabaseData(ExecutionEngine *v4)
+    : m_engine(v4)
 {
     Scope scope(v4);
     {
         ScopedObject proto(scope, v4->newObject());
         proto->defineDefaultProperty(QStringLiteral("transaction"), qmlsqldatabase_transaction);
         proto->defineDefaultProperty(QStringLiteral("readTransaction"), qmlsqldatabase_read_transaction);
+        proto->defineDefaultProperty(QStringLiteral("transactionAsync"), qmlsqldatabase_transaction_async);
+        proto->defineDefaultProperty(QStringLiteral("readTransactionAsync"), qmlsqldatabase_read_transaction_async);
+        proto->defineDefaultProperty(QStringLiteral("executeSqlAsync"), qmlsqldatabase_executeSql_async);
         proto->defineAccessorProperty(QStringLiteral("version"), qmlsqldatabase_version, nullptr);
         proto->defineDefaultProperty(QStringLiteral("changeVersion"), qmlsqldatabase_changeVersion);
         databaseProto = proto;
@@ -637,6 +1092,42 @@ In that case, the data could be saved in the following way:
 This method creates a read-only transaction and passed to \e callback. In this function,
 you can call \e executeSql on \e tx to read the database (with \c select statements).
 
+\section3 db.transactionAsync(statements)
+
+Since Qt 6.6, this method runs \e statements in a read/write transaction on a connection thread
+and returns a Promise, so that the GUI thread is not blocked by the database. Transactions queued
+this way run in the order in which they were requested.
+
+Each entry of the \e statements array is either an SQL string or an object with an \c sql
+string and either \c values, bound like the values of \c executeSql, or \c batch, an array of
+values the statement is executed with in turn. Prepared statements are cached by the connection
+thread and reused by later transactions.
+
+The Promise is fulfilled with an array holding a results object for each statement. Unlike the
+results of \c executeSql, \c rows is a plain JavaScript array of row objects. If any statement
+fails, the transaction is rolled back and the Promise is rejected with an error whose \c code is
+SQLException.DATABASE_ERR, SQLException.SYNTAX_ERR, or SQLException.UNKNOWN_ERR.
+
+\badcode
+    db.transactionAsync([
+        { sql: "INSERT INTO trip_log VALUES(?, ?, ?)",
+          batch: [ [ "01/10/2016", "Sylling - Vikersund", "53" ],
+                   [ "02/10/2016", "Vikersund - Noresund", "60" ] ] },
+        "SELECT COUNT(*) AS trips FROM trip_log"
+    ]).then(function(results) {
+        console.log(results[1].rows[0].trips)
+    })
+\endcode
+
+\section3 db.readTransactionAsync(statements)
+
+The read-only variant of \c transactionAsync(). Only \c select statements can be executed.
+
+\section3 db.executeSqlAsync(statement, values)
+
+Runs a single \e statement with \e values in its own transaction on the connection thread, like
+\c transactionAsync(). The returned Promise is fulfilled with the results object of the statement.
+
 \section3 results = tx.executeSql(statement, values)
 
 This method executes an SQL \e statement, binding the list of \e values to SQL positional parameters
@@ -65,6 +65,7 @@ public:
 
     virtual QVariant value(int role) const = 0;
     virtual void setValue(int role, const QVariant &value) = 0;
+    virtual void invalidateFetchedData() {}
 
     void setValue(const QString &role, const QVariant &value) override;
     bool resolveIndex(const QQmlAdaptorModel &model, int idx) override;
@@ -135,6 +136,7 @@ public:
 
             const int idx = item->modelIndex();
             if (idx >= index && idx < index + count) {
+                static_cast<QQmlDMCachedModelData *>(item.data())->invalidateFetchedData();
                 for (int i = 0; i < signalIndexes.size(); ++i)
                     QMetaObject::activate(item, signalIndexes.at(i), nullptr);
             }
@@ -210,6 +212,7 @@ public:
 
     QV4::PersistentValue prototype;
     QList<int> propertyRoles;
+    QList<int> fetchedRoles; // roles read by any delegate, fetched together
     QList<int> watchedRoleIds;
     QList<QByteArray> watchedRoles;
     QHash<QByteArray, int> roleNames;
@@ -375,9 +378,44 @@ public:
 
     QVariant value(int role) const override
     {
-        if (const QAbstractItemModel *aim = type->model->aim())
-            return aim->index(row, column, type->model->rootIndex).data(role);
-        return QVariant();
+        const QAbstractItemModel *aim = type->model->aim();
+        if (!aim)
+            return QVariant();
+
+        const auto fetched = [this](int role) -> const QModelRoleData * {
+            for (const QModelRoleData &roleData : std::as_const(fetchedData)) {
+                if (roleData.role() == role)
+                    return &roleData;
+            }
+            return nullptr;
+        };
+        if (const QModelRoleData *roleData = fetched(role))
+            return roleData->data();
+
+        // Fetch every role the delegates have read so far with one multiData() call, so that
+        // a model backed by a remote source serves a delegate with one request instead of
+        // one data() call per role.
+        if (!type->fetchedRoles.contains(role))
+            type->fetchedRoles.append(role);
+        fetchedData.clear();
+        fetchedData.reserve(type->fetchedRoles.size());
+        for (int fetchedRole : std::as_const(type->fetchedRoles))
+            fetchedData.append(QModelRoleData(fetchedRole));
+        aim->multiData(aim->index(row, column, type->model->rootIndex), fetchedData);
+
+        const QModelRoleData *roleData = fetched(role);
+        return roleData ? roleData->data() : QVariant();
+    }
+
+    void invalidateFetchedData() override
+    {
+        fetchedData.clear();
+    }
+
+    void setModelIndex(int idx, int newRow, int newColumn, bool alwaysEmit = false) override
+    {
+        fetchedData.clear();
+        QQmlDMCachedModelData::setModelIndex(idx, newRow, newColumn, alwaysEmit);
     }
 
     void setValue(int role, const QVariant &value) override
@@ -399,6 +437,10 @@ public:
         ++scriptRef;
         return o.asReturnedValue();
     }
+
+private:
+    // Role values fetched for the current row, until the row or its data changes.
+    mutable QVector<QModelRoleData> fetchedData;
 };
 
 class VDMAbstractItemModelDataType : public VDMModelDelegateDataType
@@ -20,6 +20,9 @@
 #include <private/qv4functionobject_p.h>
 #include <private/qv4objectiterator_p.h>
 
+#include <algorithm>
+#include <numeric>
+
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcItemViewDelegateRecycling, "qt.qml.delegatemodel.recycling")
@@ -167,6 +170,9 @@ QQmlDelegateModelPrivate::QQmlDelegateModelPrivate(QQmlContext *ctxt)
     , m_transaction(false)
     , m_incubatorCleanupScheduled(false)
     , m_waitingToFetchMore(false)
+    , m_coalesceChanges(qEnvironmentVariableIntValue("QT_QML_COALESCE_MODEL_CHANGES") > 0)
+    , m_pendingAllRoles(false)
+    , m_flushScheduled(false)
     , m_cacheItems(nullptr)
     , m_items(nullptr)
     , m_persistedItems(nullptr)
@@ -192,6 +198,15 @@ int QQmlDelegateModelPrivate::adaptorModelCount() const
     return m_adaptorModel.rowCount();
 }
 
+// How many items before the end of the model a view requesting an item makes
+// the model fetch more. Views create items ahead of a flick in proportion to
+// its velocity, so this also fetches earlier the faster the view moves.
+static int fetchAhead()
+{
+    static const int fetchAhead = qMax(0, qEnvironmentVariableIntValue("QML_MODEL_FETCH_AHEAD"));
+    return fetchAhead;
+}
+
 void QQmlDelegateModelPrivate::requestMoreIfNecessary()
 {
     Q_Q(QQmlDelegateModel);
@@ -318,6 +333,7 @@ void QQmlDelegateModel::componentComplete()
             defaultGroups | Compositor::AppendFlag | Compositor::PrependFlag,
             &inserts);
     d->itemsInserted(inserts);
+    d->applyGroupCriteria();
     d->emitChanges();
     d->requestMoreIfNecessary();
 }
@@ -409,6 +425,7 @@ void QQmlDelegateModel::setModel(const QVariant &model)
 
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
+    d->clearQueuedChanges();
 
     d->disconnectFromAbstractItemModel();
     d->m_adaptorModel.setModel(model);
@@ -514,6 +531,7 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     const bool changed = d->m_adaptorModel.rootIndex != modelIndex;
     if (changed || !d->m_adaptorModel.isValid()) {
         const int oldCount = d->m_count;
+        d->clearQueuedChanges();
         d->m_adaptorModel.rootIndex = modelIndex;
         if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim()) {
             // The previous root index was invalidated, so we need to reconnect the model.
@@ -636,7 +654,8 @@ void QQmlDelegateModel::cancel(int index)
         return;
     }
 
-    Compositor::iterator it = d->m_compositor.find(d->m_compositorGroup, index);
+    Compositor::iterator it = d->m_compositor.find(
+            d->m_compositorGroup, d->toGroupIndex(d->m_compositorGroup, index));
     QQmlDelegateModelItem *cacheItem = it->inCache() ? d->m_cache.at(it.cacheIndex()) : 0;
     if (cacheItem) {
         if (cacheItem->incubationTask && !cacheItem->isObjectReferenced()) {
@@ -828,7 +847,15 @@ void QQmlDelegateModelPrivate::updateFilterGroup()
         m_compositor.transition(previousGroup, m_compositorGroup, &removes, &inserts);
 
         QQmlChangeSet changeSet;
-        changeSet.move(removes, inserts);
+        if (isSorted(previousGroup) || isSorted(m_compositorGroup)) {
+            // Items don't keep their relative order going to or from a sorted group.
+            if (const int count = m_compositor.count(previousGroup))
+                changeSet.remove(0, count);
+            if (const int count = m_compositor.count(m_compositorGroup))
+                changeSet.insert(0, count);
+        } else {
+            changeSet.move(removes, inserts);
+        }
         emit q->modelUpdated(changeSet, false);
 
         if (changeSet.difference() != 0)
@@ -1277,7 +1304,7 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, QQ
         }
     }
 
-    if (index == m_compositor.count(group) - 1)
+    if (index >= m_compositor.count(group) - 1 - fetchAhead())
         requestMoreIfNecessary();
 
     // Remove the temporary reference count.
@@ -1310,7 +1337,8 @@ QObject *QQmlDelegateModel::object(int index, QQmlIncubator::IncubationMode incu
         return nullptr;
     }
 
-    return d->object(d->m_compositorGroup, index, incubationMode);
+    return d->object(
+            d->m_compositorGroup, d->toGroupIndex(d->m_compositorGroup, index), incubationMode);
 }
 
 QQmlIncubator::Status QQmlDelegateModel::incubationStatus(int index)
@@ -1318,7 +1346,8 @@ QQmlIncubator::Status QQmlDelegateModel::incubationStatus(int index)
     Q_D(QQmlDelegateModel);
     if (d->m_compositor.count(d->m_compositorGroup) <= index)
         return QQmlIncubator::Null;
-    Compositor::iterator it = d->m_compositor.find(d->m_compositorGroup, index);
+    Compositor::iterator it = d->m_compositor.find(
+            d->m_compositorGroup, d->toGroupIndex(d->m_compositorGroup, index));
     if (!it->inCache())
         return QQmlIncubator::Null;
 
@@ -1353,7 +1382,8 @@ QVariant QQmlDelegateModelPrivate::variantValue(QQmlListCompositor::Group group,
 QVariant QQmlDelegateModel::variantValue(int index, const QString &role)
 {
     Q_D(QQmlDelegateModel);
-    return d->variantValue(d->m_compositorGroup, index, role);
+    return d->variantValue(
+            d->m_compositorGroup, d->toGroupIndex(d->m_compositorGroup, index), role);
 }
 
 int QQmlDelegateModel::indexOf(QObject *item, QObject *) const
@@ -1444,12 +1474,15 @@ void QQmlDelegateModel::_q_itemsChanged(int index, int count, const QVector<int>
     if (count <= 0 || !d->m_complete)
         return;
 
-    if (d->m_adaptorModel.notify(d->m_cache, index, count, roles)) {
+    const bool changed = d->m_adaptorModel.notify(d->m_cache, index, count, roles);
+    if (changed) {
         QVector<Compositor::Change> changes;
         d->m_compositor.listItemsChanged(&d->m_adaptorModel, index, count, &changes);
         d->itemsChanged(changes);
-        d->emitChanges();
     }
+    // The sort and filter roles need not be watched by any delegate.
+    if (d->updateGroupCriteria(index, count, roles) || changed)
+        d->emitChanges();
 }
 
 static void incrementIndexes(QQmlDelegateModelItem *cacheItem, int count, const int *deltas)
@@ -1542,6 +1575,9 @@ void QQmlDelegateModel::_q_itemsInserted(int index, int count)
     if (count <= 0 || !d->m_complete)
         return;
 
+    if (!d->m_pendingChanges.isEmpty())
+        d->queuedItemsInserted(index, count);
+
     d->m_count += count;
 
     const QList<QQmlDelegateModelItem *> cache = d->m_cache;
@@ -1563,6 +1599,7 @@ void QQmlDelegateModel::_q_itemsInserted(int index, int count)
     QVector<Compositor::Insert> inserts;
     d->m_compositor.listItemsInserted(&d->m_adaptorModel, index, count, &inserts);
     d->itemsInserted(inserts);
+    d->updateGroupFilters(index, count);
     d->emitChanges();
 }
 
@@ -1689,6 +1726,9 @@ void QQmlDelegateModel::_q_itemsRemoved(int index, int count)
     if (count <= 0|| !d->m_complete)
         return;
 
+    if (!d->m_pendingChanges.isEmpty())
+        d->queuedItemsRemoved(index, count);
+
     d->m_count -= count;
     Q_ASSERT(d->m_count >= 0);
     const QList<QQmlDelegateModelItem *> cache = d->m_cache;
@@ -1751,6 +1791,9 @@ void QQmlDelegateModel::_q_itemsMoved(int from, int to, int count)
     if (count <= 0 || !d->m_complete)
         return;
 
+    if (!d->m_pendingChanges.isEmpty())
+        d->queuedItemsMoved(from, to, count);
+
     const int minimum = qMin(from, to);
     const int maximum = qMax(from, to) + count;
     const int difference = from > to ? count : -count;
@@ -1840,6 +1883,571 @@ void QQmlDelegateModelPrivate::emitChanges()
     }
 }
 
+/*!
+    \internal
+    Returns the index in \a group and the model row of every model row in [index, index + count)
+    that belongs to \a group, in group order.
+*/
+QVector<std::pair<int, int>> QQmlDelegateModelPrivate::groupRows(
+        Compositor::Group group, int index, int count)
+{
+    QVector<std::pair<int, int>> rows;
+    const int groupCount = m_compositor.count(group);
+    if (groupCount == 0 || count <= 0)
+        return rows;
+
+    // One pass over the ranges rather than one find() per row.
+    Compositor::iterator it = m_compositor.find(group, 0);
+    while (it.index[group] < groupCount) {
+        if (it->list == &m_adaptorModel) {
+            const int first = qMax(index, it->start());
+            const int last = qMin(index + count, it->end());
+            for (int row = first; row < last; ++row)
+                rows.append({ it.index[group] + row - it->start(), row });
+        }
+        it += it->count;
+    }
+    return rows;
+}
+
+/*!
+    \internal
+    Re-applies the sort and filter criteria of every group to the model rows in
+    [index, index + count) after their \a roles changed.
+
+    Returns whether any group has criteria depending on the change.
+*/
+bool QQmlDelegateModelPrivate::updateGroupCriteria(int index, int count, const QVector<int> &roles)
+{
+    const QAbstractItemModel *aim = m_adaptorModel.adaptsAim() ? m_adaptorModel.aim() : nullptr;
+    bool updated = false;
+    for (int i = 1; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *group = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        if ((group->isSorted() || group->isFiltered()) && group->dependsOnRoles(aim, roles)) {
+            updateGroupCriteria(group, index, count);
+            updated = true;
+        }
+    }
+    return updated;
+}
+
+void QQmlDelegateModelPrivate::updateGroupCriteria(
+        QQmlDelegateModelGroupPrivate *group, int index, int count)
+{
+    if (!m_context || !m_context->isValid())
+        return;
+
+    if (group->isFiltered() && group->group != Compositor::Default)
+        filterGroupRows(group, groupRows(Compositor::Default, index, count));
+
+    if (group->isSorted()) {
+        const QVector<std::pair<int, int>> rows = groupRows(group->group, index, count);
+        // Placing k rows costs O(k log n) comparisons; past a point one full sort is cheaper,
+        // and views handle a single reset better than thousands of moves.
+        if (rows.size() > 64 && rows.size() * 16 > m_compositor.count(group->group))
+            sortGroup(group);
+        else if (!rows.isEmpty())
+            sortGroupRows(group, rows);
+    }
+}
+
+/*!
+    \internal
+    Applies the filters of every group to the model rows in [index, index + count) after they
+    were inserted. Sorted groups place new items when their changes are translated.
+*/
+void QQmlDelegateModelPrivate::updateGroupFilters(int index, int count)
+{
+    if (!m_context || !m_context->isValid())
+        return;
+
+    for (int i = 1; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *group = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        if (group->isFiltered() && group->group != Compositor::Default)
+            filterGroupRows(group, groupRows(Compositor::Default, index, count));
+    }
+}
+
+/*!
+    \internal
+    Applies the sort and filter criteria of \a group to all items, after the criteria changed.
+*/
+void QQmlDelegateModelPrivate::applyGroupCriteria(QQmlDelegateModelGroupPrivate *group)
+{
+    if (!m_context || !m_context->isValid())
+        return;
+
+    if (group->isFiltered() && group->group != Compositor::Default)
+        filterGroupRows(group, groupRows(Compositor::Default, 0, m_count));
+    if (group->isSorted())
+        sortGroup(group);
+    else if (group->sortActive)
+        unsortGroup(group);
+}
+
+void QQmlDelegateModelPrivate::applyGroupCriteria()
+{
+    for (int i = 1; i < m_groupCount; ++i) {
+        QQmlDelegateModelGroupPrivate *group = QQmlDelegateModelGroupPrivate::get(m_groups[i]);
+        if (group->isSorted() || group->isFiltered())
+            applyGroupCriteria(group);
+    }
+}
+
+void QQmlDelegateModelPrivate::filterGroupRows(
+        QQmlDelegateModelGroupPrivate *group, const QVector<std::pair<int, int>> &rows)
+{
+    Q_Q(QQmlDelegateModel);
+    QJSEngine *engine = m_context->engine();
+
+    QVector<bool> accepted(rows.size());
+    for (int i = 0; i < rows.size(); ++i) {
+        const QVariant value = m_adaptorModel.value(rows.at(i).second, group->filterRole);
+        const QJSValue result = group->filter.call({ engine->toScriptValue(value) });
+        if (result.isError()) {
+            qmlWarning(q) << result.toString();
+            return;
+        }
+        accepted[i] = result.toBool();
+    }
+
+    // Membership of the items group is untouched, so the items group indexes of the rows stay
+    // valid while consecutive runs of accepted or rejected rows are applied.
+    const uint groupFlag = 1 << group->group;
+    for (int i = 0, run = 1; i < rows.size(); i += run) {
+        run = 1;
+        while (i + run < rows.size()
+               && rows.at(i + run).first == rows.at(i).first + run
+               && accepted.at(i + run) == accepted.at(i)) {
+            ++run;
+        }
+
+        Compositor::iterator it = m_compositor.find(Compositor::Default, rows.at(i).first);
+        if (accepted.at(i)) {
+            QVector<Compositor::Insert> inserts;
+            m_compositor.setFlags(it, run, Compositor::Default, groupFlag, &inserts);
+            itemsInserted(inserts);
+        } else {
+            QVector<Compositor::Remove> removes;
+            m_compositor.clearFlags(it, run, Compositor::Default, groupFlag, &removes);
+            itemsRemoved(removes);
+        }
+    }
+}
+
+QVariant QQmlDelegateModelPrivate::sortKey(
+        QQmlDelegateModelGroupPrivate *group, const Compositor::iterator &it)
+{
+    if (QQmlAdaptorModel *model = it.list<QQmlAdaptorModel>())
+        return model->value(it.modelIndex(), group->sortRole);
+    return QVariant();
+}
+
+static bool sortsBefore(const QVariant &left, const QVariant &right, Qt::SortOrder order)
+{
+    const QPartialOrdering ordering = QVariant::compare(left, right);
+    return order == Qt::AscendingOrder
+            ? ordering == QPartialOrdering::Less
+            : ordering == QPartialOrdering::Greater;
+}
+
+/*!
+    \internal
+    Translates the changes \a group collected by group index into changes by sorted position,
+    and updates its sorted order to match.
+
+    Items that left the group are removed from the order, moved items keep their place and new
+    items are placed by their sort key, so k changes cost O(k log n). Many new items at once are
+    placed with a full sort, which is reported as a reset of the group.
+*/
+void QQmlDelegateModelPrivate::updateSortedOrder(QQmlDelegateModelGroupPrivate *group)
+{
+    if (!group->sortActive || group->changeSet.isEmpty())
+        return;
+
+    const Compositor::Group groupId = group->group;
+    const int count = m_compositor.count(groupId);
+    const Qt::SortOrder order = group->sortOrder;
+    const auto lessThan = [order](const QVariant &left, const QVariant &right) {
+        return sortsBefore(left, right, order);
+    };
+    const QQmlChangeSet &changeSet = group->changeSet;
+    QQmlChangeSet &sortedChangeSet = group->sortedChangeSet;
+    QQmlSortedOrder &sortedOrder = group->sortedOrder;
+
+    // Moved items only leave the group order, keeping their place in the sorted order.
+    QHash<QQmlChangeSet::MoveKey, int> moved;
+    for (const QQmlChangeSet::Change &remove : changeSet.removes()) {
+        for (int i = remove.start(); i < remove.end(); ++i) {
+            const int item = sortedOrder.at(QQmlSortedOrder::GroupOrder, remove.index);
+            sortedOrder.remove(QQmlSortedOrder::GroupOrder, item);
+            if (remove.isMove()) {
+                moved.insert(remove.moveKey(i), item);
+            } else {
+                sortedChangeSet.remove(sortedOrder.remove(QQmlSortedOrder::SortedOrder, item), 1);
+                sortedOrder.destroy(item);
+            }
+        }
+    }
+
+    int added = 0;
+    for (const QQmlChangeSet::Change &insert : changeSet.inserts()) {
+        if (!insert.isMove())
+            added += insert.count;
+    }
+    const bool resort = added > 64 && added * 16 > count;
+
+    for (const QQmlChangeSet::Change &insert : changeSet.inserts()) {
+        Compositor::iterator it = m_compositor.find(groupId, insert.index);
+        for (int i = insert.start(); i < insert.end(); ++i) {
+            if (i > insert.start())
+                it += 1;
+            int item = -1;
+            if (insert.isMove()) {
+                item = moved.value(insert.moveKey(i), -1);
+                moved.remove(insert.moveKey(i));
+            }
+            if (item < 0) {
+                item = sortedOrder.create(sortKey(group, it));
+                if (!resort) {
+                    const int position = sortedOrder.upperBound(sortedOrder.key(item), lessThan);
+                    sortedOrder.insert(QQmlSortedOrder::SortedOrder, position, item);
+                    sortedChangeSet.insert(position, 1);
+                }
+            }
+            sortedOrder.insert(QQmlSortedOrder::GroupOrder, i, item);
+        }
+    }
+
+    // Items moved out of the group without a matching insert are gone.
+    for (int item : std::as_const(moved)) {
+        sortedChangeSet.remove(sortedOrder.remove(QQmlSortedOrder::SortedOrder, item), 1);
+        sortedOrder.destroy(item);
+    }
+    Q_ASSERT(sortedOrder.count(QQmlSortedOrder::GroupOrder) == count);
+
+    if (resort) {
+        if (const int previousCount = sortedOrder.count())
+            sortedChangeSet.remove(0, previousCount);
+        sortedOrder.sort(lessThan);
+        sortedChangeSet.insert(0, count);
+    }
+
+    QVector<int> changed;
+    for (const QQmlChangeSet::Change &change : changeSet.changes()) {
+        for (int i = change.start(); i < change.end(); ++i)
+            changed.append(sortedOrder.toSortedPosition(i));
+    }
+    std::sort(changed.begin(), changed.end());
+    for (int i = 0, run = 1; i < changed.size(); i += run) {
+        run = 1;
+        while (i + run < changed.size() && changed.at(i + run) == changed.at(i) + run)
+            ++run;
+        sortedChangeSet.change(changed.at(i), run);
+    }
+
+    group->changeSet.clear();
+}
+
+/*!
+    \internal
+    Moves the \a rows of \a group, whose sort keys changed, to their sorted positions, assuming
+    the rest of the group is already sorted. Only the kept sort keys are compared, so placing
+    k rows costs O(k log n).
+*/
+void QQmlDelegateModelPrivate::sortGroupRows(
+        QQmlDelegateModelGroupPrivate *group, const QVector<std::pair<int, int>> &rows)
+{
+    if (!group->sortActive)
+        return;
+    updateSortedOrder(group);
+
+    const Qt::SortOrder order = group->sortOrder;
+    const auto lessThan = [order](const QVariant &left, const QVariant &right) {
+        return sortsBefore(left, right, order);
+    };
+    QQmlSortedOrder &sortedOrder = group->sortedOrder;
+    QVector<int> items;
+    items.reserve(rows.size());
+    for (const auto &row : rows) {
+        const int item = sortedOrder.at(QQmlSortedOrder::GroupOrder, row.first);
+        sortedOrder.setKey(item, m_adaptorModel.value(row.second, group->sortRole));
+        items.append(item);
+    }
+
+    // Nothing moves if every row still sorts between its neighbors.
+    const auto keyAt = [&](int position) -> const QVariant & {
+        return sortedOrder.key(sortedOrder.at(QQmlSortedOrder::SortedOrder, position));
+    };
+    const bool sorted = std::all_of(items.cbegin(), items.cend(), [&](int item) {
+        const int position = sortedOrder.indexOf(QQmlSortedOrder::SortedOrder, item);
+        const QVariant &key = sortedOrder.key(item);
+        return (position == 0 || !lessThan(key, keyAt(position - 1)))
+                && (position == sortedOrder.count() - 1 || !lessThan(keyAt(position + 1), key));
+    });
+    if (sorted)
+        return;
+
+    // Take the rows out, leaving the unchanged items sorted, and place them back one by one.
+    QVector<std::pair<int, int>> from;
+    from.reserve(items.size());
+    for (int item : std::as_const(items))
+        from.append({ sortedOrder.indexOf(QQmlSortedOrder::SortedOrder, item), item });
+    std::sort(from.begin(), from.end());
+
+    QVector<QQmlChangeSet::Change> removes;
+    QHash<int, int> moveIds;
+    for (int i = 0; i < from.size(); ++i) {
+        const int moveId = group->sortMoveId++;
+        moveIds.insert(from.at(i).second, moveId);
+        removes.append(QQmlChangeSet::Change(from.at(i).first - i, 1, moveId));
+    }
+    for (const auto &entry : std::as_const(from))
+        sortedOrder.remove(QQmlSortedOrder::SortedOrder, entry.second);
+
+    // Placed in order of their keys, each row goes after the ones placed before it, so the
+    // positions ascend as the changeset expects.
+    std::stable_sort(items.begin(), items.end(), [&](int left, int right) {
+        return lessThan(sortedOrder.key(left), sortedOrder.key(right));
+    });
+    QVector<QQmlChangeSet::Change> inserts;
+    for (int item : std::as_const(items)) {
+        const int position = sortedOrder.upperBound(sortedOrder.key(item), lessThan);
+        sortedOrder.insert(QQmlSortedOrder::SortedOrder, position, item);
+        inserts.append(QQmlChangeSet::Change(position, 1, moveIds.value(item)));
+    }
+
+    group->sortedChangeSet.move(removes, inserts);
+}
+
+/*!
+    \internal
+    Sorts all items of \a group.
+
+    The order is kept by the group alone, so the items group and the other groups are
+    unaffected, and the new order is reported to the views of this group as one reset.
+*/
+void QQmlDelegateModelPrivate::sortGroup(QQmlDelegateModelGroupPrivate *group)
+{
+    const Compositor::Group groupId = group->group;
+    const Qt::SortOrder order = group->sortOrder;
+    const int count = m_compositor.count(groupId);
+
+    QVector<int> previous;
+    if (group->sortActive) {
+        updateSortedOrder(group);
+        previous = group->sortedOrder.sortedGroupIndexes();
+    } else {
+        // The changes collected so far lead up to the unsorted order replaced below.
+        group->sortActive = true;
+        group->sortedChangeSet = group->changeSet;
+        group->changeSet.clear();
+        previous.resize(count);
+        std::iota(previous.begin(), previous.end(), 0);
+    }
+
+    QVector<QVariant> keys;
+    keys.reserve(count);
+    Compositor::iterator it = m_compositor.find(groupId, 0);
+    while (it.index[groupId] < count) {
+        QQmlAdaptorModel *model = it.list<QQmlAdaptorModel>();
+        for (int i = 0; i < it->count; ++i)
+            keys.append(model ? model->value(it->index + i, group->sortRole) : QVariant());
+        it += it->count;
+    }
+
+    QVector<int> sorted(count);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::stable_sort(sorted.begin(), sorted.end(), [&](int left, int right) {
+        return sortsBefore(keys.at(left), keys.at(right), order);
+    });
+    const bool reordered = sorted != previous;
+    group->sortedOrder.reset(std::move(keys), sorted);
+
+    if (reordered) {
+        group->sortedChangeSet.remove(0, count);
+        group->sortedChangeSet.insert(0, count);
+    }
+}
+
+/*!
+    \internal
+    Returns \a group to the order of its items in the compositor after its sort role was
+    cleared.
+*/
+void QQmlDelegateModelPrivate::unsortGroup(QQmlDelegateModelGroupPrivate *group)
+{
+    updateSortedOrder(group);
+
+    const QVector<int> sortedGroupIndexes = group->sortedOrder.sortedGroupIndexes();
+    QQmlChangeSet changeSet = group->sortedChangeSet;
+    for (int position = 0; position < sortedGroupIndexes.size(); ++position) {
+        if (sortedGroupIndexes.at(position) != position) {
+            changeSet.remove(0, sortedGroupIndexes.size());
+            changeSet.insert(0, sortedGroupIndexes.size());
+            break;
+        }
+    }
+
+    group->changeSet = changeSet;
+    group->sortedChangeSet.clear();
+    group->sortedOrder.clear();
+    group->sortActive = false;
+}
+
+// Adds the rows [index, index + count) to a sorted list of disjoint ranges, merging the ranges
+// it overlaps or touches.
+static void addChangedRange(QVector<QQmlChangeSet::Change> *ranges, int index, int count)
+{
+    if (count <= 0)
+        return;
+
+    // Models usually report changes row by row in ascending order, which only extends the last range.
+    if (!ranges->isEmpty() && ranges->last().index <= index && ranges->last().end() >= index) {
+        QQmlChangeSet::Change &last = ranges->last();
+        last.count = qMax(last.end(), index + count) - last.index;
+        return;
+    }
+
+    auto first = std::lower_bound(ranges->begin(), ranges->end(), index,
+            [](const QQmlChangeSet::Change &range, int index) { return range.end() < index; });
+    int start = index;
+    int end = index + count;
+    auto last = first;
+    for (; last != ranges->end() && last->index <= end; ++last) {
+        start = qMin(start, last->index);
+        end = qMax(end, last->end());
+    }
+    if (first == last) {
+        ranges->insert(first, QQmlChangeSet::Change(start, end - start));
+    } else {
+        *first = QQmlChangeSet::Change(start, end - start);
+        ranges->erase(first + 1, last);
+    }
+}
+
+/*!
+    \internal
+    Records a data change to be applied on the next pass of the event loop.
+
+    Models commonly emit dataChanged() once per row while updating many rows. The queued rows are
+    kept as a sorted list of disjoint ranges, and the roles of all queued changes are combined, so
+    that delegates are refreshed once per pass rather than once per signal. Rows inserted,
+    removed or moved in the meantime shift the queued ranges, and rows inserted after a change
+    was queued can themselves be queued as changed.
+*/
+void QQmlDelegateModelPrivate::queueItemsChanged(int index, int count, const QVector<int> &roles)
+{
+    Q_Q(QQmlDelegateModel);
+    if (count <= 0)
+        return;
+
+    addChangedRange(&m_pendingChanges, index, count);
+    if (roles.isEmpty()) {
+        m_pendingAllRoles = true;
+        m_pendingRoles.clear();
+    } else if (!m_pendingAllRoles) {
+        for (int role : roles) {
+            if (!m_pendingRoles.contains(role))
+                m_pendingRoles.append(role);
+        }
+    }
+
+    if (!m_flushScheduled) {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(q, [this]() { flushItemsChanged(); }, Qt::QueuedConnection);
+    }
+}
+
+/*!
+    \internal
+    Shifts the queued changes after \a index by \a count inserted rows. The inserted rows are not
+    marked as changed.
+*/
+void QQmlDelegateModelPrivate::queuedItemsInserted(int index, int count)
+{
+    for (int i = 0; i < m_pendingChanges.size(); ++i) {
+        QQmlChangeSet::Change &range = m_pendingChanges[i];
+        if (range.index >= index) {
+            range.index += count;
+        } else if (range.end() > index) {
+            const int end = range.end();
+            range.count = index - range.index;
+            m_pendingChanges.insert(++i, QQmlChangeSet::Change(index + count, end - index));
+        }
+    }
+}
+
+/*!
+    \internal
+    Drops the queued changes of \a count removed rows at \a index and shifts the ones after them.
+*/
+void QQmlDelegateModelPrivate::queuedItemsRemoved(int index, int count)
+{
+    const int removedEnd = index + count;
+    const QVector<QQmlChangeSet::Change> ranges = std::exchange(m_pendingChanges, {});
+    for (const QQmlChangeSet::Change &range : ranges) {
+        if (range.index < index)
+            addChangedRange(&m_pendingChanges, range.index, qMin(range.end(), index) - range.index);
+        if (range.end() > removedEnd) {
+            const int start = qMax(range.index, removedEnd);
+            addChangedRange(&m_pendingChanges, start - count, range.end() - start);
+        }
+    }
+}
+
+/*!
+    \internal
+    Moves the queued changes of \a count rows at \a from along with the rows, \a to being the
+    index of the rows after they were taken out.
+*/
+void QQmlDelegateModelPrivate::queuedItemsMoved(int from, int to, int count)
+{
+    QVector<QQmlChangeSet::Change> moved;
+    for (const QQmlChangeSet::Change &range : std::as_const(m_pendingChanges)) {
+        const int start = qMax(range.index, from);
+        const int end = qMin(range.end(), from + count);
+        if (start < end)
+            moved.append(QQmlChangeSet::Change(start - from, end - start));
+    }
+    queuedItemsRemoved(from, count);
+    queuedItemsInserted(to, count);
+    for (const QQmlChangeSet::Change &range : std::as_const(moved))
+        addChangedRange(&m_pendingChanges, to + range.index, range.count);
+}
+
+void QQmlDelegateModelPrivate::clearQueuedChanges()
+{
+    m_pendingChanges.clear();
+    m_pendingRoles.clear();
+    m_pendingAllRoles = false;
+}
+
+void QQmlDelegateModelPrivate::flushItemsChanged()
+{
+    m_flushScheduled = false;
+    const QVector<QQmlChangeSet::Change> changes = std::exchange(m_pendingChanges, {});
+    const QVector<int> roles = std::exchange(m_pendingRoles, {});
+    m_pendingAllRoles = false;
+    if (!m_complete || changes.isEmpty())
+        return;
+
+    bool changed = false;
+    for (const QQmlChangeSet::Change &change : changes) {
+        if (m_adaptorModel.notify(m_cache, change.index, change.count, roles)) {
+            QVector<Compositor::Change> compositorChanges;
+            m_compositor.listItemsChanged(
+                    &m_adaptorModel, change.index, change.count, &compositorChanges);
+            itemsChanged(compositorChanges);
+            changed = true;
+        }
+        if (updateGroupCriteria(change.index, change.count, roles))
+            changed = true;
+    }
+    if (changed)
+        emitChanges();
+}
+
 void QQmlDelegateModel::_q_modelReset()
 {
     Q_D(QQmlDelegateModel);
@@ -1848,6 +2456,7 @@ void QQmlDelegateModel::_q_modelReset()
 
     int oldCount = d->m_count;
     d->m_adaptorModel.rootIndex = QModelIndex();
+    d->clearQueuedChanges();
 
     if (d->m_complete) {
         d->m_count = d->adaptorModelCount();
@@ -1876,6 +2485,7 @@ void QQmlDelegateModel::_q_modelReset()
         if (d->m_count)
             d->m_compositor.listItemsInserted(&d->m_adaptorModel, 0, d->m_count, &inserts);
         d->itemsMoved(removes, inserts);
+        d->applyGroupCriteria();
         d->m_reset = true;
 
         if (d->m_adaptorModel.canFetchMore())
@@ -1902,6 +2512,7 @@ void QQmlDelegateModel::_q_rowsAboutToBeRemoved(const QModelIndex &parent, int b
     if (index.parent() == parent && index.row() >= begin && index.row() <= end) {
         const int oldCount = d->m_count;
         d->m_count = 0;
+        d->clearQueuedChanges();
         d->disconnectFromAbstractItemModel();
         d->m_adaptorModel.invalidateModel();
 
@@ -1971,7 +2582,11 @@ void QQmlDelegateModel::_q_columnsMoved(const QModelIndex &parent, int start, in
 void QQmlDelegateModel::_q_dataChanged(const QModelIndex &begin, const QModelIndex &end, const QVector<int> &roles)
 {
     Q_D(QQmlDelegateModel);
-    if (begin.parent() == d->m_adaptorModel.rootIndex)
+    if (begin.parent() != d->m_adaptorModel.rootIndex)
+        return;
+    if (d->m_coalesceChanges && d->m_complete)
+        d->queueItemsChanged(begin.row(), end.row() - begin.row() + 1, roles);
+    else
         _q_itemsChanged(begin.row(), end.row() - begin.row() + 1, roles);
 }
 
@@ -2440,7 +3055,8 @@ int QQmlDelegateModelItem::groupIndex(Compositor::Group group)
     if (QQmlDelegateModelPrivate * const model = metaType->model
             ? QQmlDelegateModelPrivate::get(metaType->model)
             : nullptr) {
-        return model->m_compositor.find(Compositor::Cache, model->m_cache.indexOf(this)).index[group];
+        return model->toSortedIndex(group, model->m_compositor.find(
+                Compositor::Cache, model->m_cache.indexOf(this)).index[group]);
     }
     return -1;
 }
@@ -2476,7 +3092,7 @@ int QQmlDelegateModelAttachedMetaObject::metaCall(QObject *object, QMetaObject::
     if (call == QMetaObject::ReadProperty) {
         if (_id >= indexPropertyOffset) {
             Compositor::Group group = Compositor::Group(_id - indexPropertyOffset + 1);
-            *static_cast<int *>(arguments[0]) = attached->m_currentIndex[group];
+            *static_cast<int *>(arguments[0]) = attached->sortedIndex(group);
             return -1;
         } else if (_id >= memberPropertyOffset) {
             Compositor::Group group = Compositor::Group(_id - memberPropertyOffset + 1);
@@ -2525,8 +3141,10 @@ QQmlDelegateModelAttached::QQmlDelegateModelAttached(
 {
     QQml_setParent_noEvent(this, parent);
     resetCurrentIndex();
-    // Let m_previousIndex be equal to m_currentIndex
+    // Let m_previousIndex be equal to m_currentIndex, as seen by the views of each group
     std::copy(std::begin(m_currentIndex), std::end(m_currentIndex), std::begin(m_previousIndex));
+    for (int i = 1; i < qMin<int>(cacheItem->metaType->groupCount, Compositor::MaximumGroupCount); ++i)
+        m_previousIndex[i] = sortedIndex(i);
 
     if (!cacheItem->metaType->metaObject)
         cacheItem->metaType->initializeMetaObject();
@@ -2549,6 +3167,19 @@ void QQmlDelegateModelAttached::resetCurrentIndex()
     }
 }
 
+/*!
+    \internal
+    Returns the index of the item in \a group as seen by the group's views, which is its
+    sorted position if the group is sorted.
+*/
+int QQmlDelegateModelAttached::sortedIndex(int group) const
+{
+    if (!m_cacheItem->metaType->model)
+        return m_currentIndex[group];
+    return QQmlDelegateModelPrivate::get(m_cacheItem->metaType->model)->toSortedIndex(
+            Compositor::Group(group), m_currentIndex[group]);
+}
+
 void QQmlDelegateModelAttached::setInPersistedItems(bool inPersisted)
 {
     setInGroup(QQmlListCompositor::Persisted, inPersisted);
@@ -2721,8 +3352,9 @@ void QQmlDelegateModelAttached::emitChanges()
 
     int indexChanges = 0;
     for (int i = 1; i < m_cacheItem->metaType->groupCount; ++i) {
-        if (m_previousIndex[i] != m_currentIndex[i]) {
-            m_previousIndex[i] = m_currentIndex[i];
+        const int index = sortedIndex(i);
+        if (m_previousIndex[i] != index) {
+            m_previousIndex[i] = index;
             indexChanges |= (1 << i);
         }
     }
@@ -2760,33 +3392,78 @@ bool QQmlDelegateModelGroupPrivate::isChangedConnected()
 void QQmlDelegateModelGroupPrivate::emitChanges(QV4::ExecutionEngine *v4)
 {
     Q_Q(QQmlDelegateModelGroup);
-    if (isChangedConnected() && !changeSet.isEmpty()) {
+    const QQmlChangeSet &changes = pendingChanges();
+    if (isChangedConnected() && !changes.isEmpty()) {
         emit q->changed(QJSValuePrivate::fromReturnedValue(
-                            engineData(v4)->array(v4, changeSet.removes())),
+                            engineData(v4)->array(v4, changes.removes())),
                         QJSValuePrivate::fromReturnedValue(
-                            engineData(v4)->array(v4, changeSet.inserts())));
+                            engineData(v4)->array(v4, changes.inserts())));
     }
-    if (changeSet.difference() != 0)
+    if (changes.difference() != 0)
         emit q->countChanged();
 }
 
 void QQmlDelegateModelGroupPrivate::emitModelUpdated(bool reset)
 {
+    const QQmlChangeSet &changes = pendingChanges();
     for (QQmlDelegateModelGroupEmitterList::iterator it = emitters.begin(); it != emitters.end(); ++it)
-        it->emitModelUpdated(changeSet, reset);
+        it->emitModelUpdated(changes, reset);
     changeSet.clear();
+    sortedChangeSet.clear();
+    sortMoveId = 0;
+}
+
+/*!
+    \internal
+    Returns the changes to report to the views of the group, by sorted position if the group
+    is sorted.
+*/
+const QQmlChangeSet &QQmlDelegateModelGroupPrivate::pendingChanges()
+{
+    if (!sortActive)
+        return changeSet;
+    QQmlDelegateModelPrivate::get(model)->updateSortedOrder(this);
+    return sortedChangeSet;
+}
+
+/*!
+    \internal
+    Returns the group index of the item at the sorted position \a index.
+*/
+int QQmlDelegateModelGroupPrivate::toGroupIndex(int index)
+{
+    if (!sortActive)
+        return index;
+    QQmlDelegateModelPrivate::get(model)->updateSortedOrder(this);
+    return index >= 0 && index < sortedOrder.count() ? sortedOrder.toGroupIndex(index) : index;
+}
+
+/*!
+    \internal
+    Returns the sorted position of the item at the group index \a index.
+*/
+int QQmlDelegateModelGroupPrivate::toSortedIndex(int index)
+{
+    if (!sortActive)
+        return index;
+    QQmlDelegateModelPrivate::get(model)->updateSortedOrder(this);
+    return index >= 0 && index < sortedOrder.count(QQmlSortedOrder::GroupOrder)
+            ? sortedOrder.toSortedPosition(index)
+            : index;
 }
 
 typedef QQmlDelegateModelGroupEmitterList::iterator GroupEmitterListIt;
 
 void QQmlDelegateModelGroupPrivate::createdPackage(int index, QQuickPackage *package)
 {
+    index = toSortedIndex(index);
     for (GroupEmitterListIt it = emitters.begin(), end = emitters.end(); it != end; ++it)
         it->createdPackage(index, package);
 }
 
 void QQmlDelegateModelGroupPrivate::initPackage(int index, QQuickPackage *package)
 {
+    index = toSortedIndex(index);
     for (GroupEmitterListIt it = emitters.begin(), end = emitters.end(); it != end; ++it)
         it->initPackage(index, package);
 }
@@ -2918,6 +3595,167 @@ void QQmlDelegateModelGroup::setDefaultInclude(bool include)
     }
 }
 
+/*!
+    \qmlproperty string QtQml.Models::DelegateModelGroup::sortRole
+    \since 6.6
+
+    This property holds the name of the model role the items in the group are ordered by.
+
+    While a sort role is set the group keeps its items ordered by the value of that role, as
+    compared by QVariant. Items that are inserted into the model, or whose sort role changes, are
+    moved into place individually with a binary search, so keeping a large group sorted costs
+    O(log n) comparisons per changed item rather than a full sort.
+
+    The sorted order belongs to this group alone: the \l {QtQml.Models::DelegateModel::items}
+    {items} group and the other groups keep their own order. Items cannot be reordered with
+    move() while the group is sorted, and clearing the sort role returns them to the order of
+    the items group.
+
+    By default this property is empty and the group is not sorted.
+
+    \sa sortOrder
+*/
+
+QString QQmlDelegateModelGroup::sortRole() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->sortRole;
+}
+
+void QQmlDelegateModelGroup::setSortRole(const QString &role)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->sortRole == role)
+        return;
+    d->sortRole = role;
+    d->criteriaChanged();
+    emit sortRoleChanged();
+}
+
+/*!
+    \qmlproperty enumeration QtQml.Models::DelegateModelGroup::sortOrder
+    \since 6.6
+
+    This property holds the order the items are sorted in when \l sortRole is set.
+
+    \value Qt.AscendingOrder    (default) Items with the smallest value come first.
+    \value Qt.DescendingOrder   Items with the largest value come first.
+*/
+
+Qt::SortOrder QQmlDelegateModelGroup::sortOrder() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->sortOrder;
+}
+
+void QQmlDelegateModelGroup::setSortOrder(Qt::SortOrder order)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->sortOrder == order)
+        return;
+    d->sortOrder = order;
+    if (d->isSorted())
+        d->criteriaChanged();
+    emit sortOrderChanged();
+}
+
+/*!
+    \qmlproperty string QtQml.Models::DelegateModelGroup::filterRole
+    \since 6.6
+
+    This property holds the name of the model role whose value is passed to \l filter.
+
+    \sa filter
+*/
+
+QString QQmlDelegateModelGroup::filterRole() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->filterRole;
+}
+
+void QQmlDelegateModelGroup::setFilterRole(const QString &role)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->filterRole == role)
+        return;
+    d->filterRole = role;
+    d->criteriaChanged();
+    emit filterRoleChanged();
+}
+
+/*!
+    \qmlproperty function QtQml.Models::DelegateModelGroup::filter
+    \since 6.6
+
+    This property holds a function deciding which items belong to the group.
+
+    While both \l filterRole and a filter function are set, the group contains exactly those
+    items of the \l {QtQml.Models::DelegateModel::items}{items} group for which the function,
+    called with the item's \l filterRole value, returns \c true. The function is only called
+    again for items that are inserted into the model or whose filter role changes, so a filter
+    on a large model costs O(k) calls for k changed items.
+
+    \qml
+    DelegateModel {
+        groups: DelegateModelGroup {
+            name: "cheap"
+            filterRole: "cost"
+            filter: function(cost) { return cost < 10 }
+            sortRole: "name"
+        }
+        filterOnGroup: "cheap"
+    }
+    \endqml
+
+    A filter cannot be set on the \l {QtQml.Models::DelegateModel::items}{items} group itself.
+*/
+
+QJSValue QQmlDelegateModelGroup::filter() const
+{
+    Q_D(const QQmlDelegateModelGroup);
+    return d->filter;
+}
+
+void QQmlDelegateModelGroup::setFilter(const QJSValue &filter)
+{
+    Q_D(QQmlDelegateModelGroup);
+    if (d->filter.strictlyEquals(filter))
+        return;
+    if (d->model && d->group == Compositor::Default) {
+        qmlWarning(this) << tr("filter: the items group cannot be filtered");
+        return;
+    }
+    d->filter = filter;
+    d->criteriaChanged();
+    emit filterChanged();
+}
+
+bool QQmlDelegateModelGroupPrivate::dependsOnRoles(
+        const QAbstractItemModel *aim, const QVector<int> &roles) const
+{
+    if (roles.isEmpty() || !aim)
+        return true;
+    const QHash<int, QByteArray> roleNames = aim->roleNames();
+    for (int role : roles) {
+        const QString name = QString::fromUtf8(roleNames.value(role));
+        if ((isSorted() && name == sortRole) || (isFiltered() && name == filterRole))
+            return true;
+    }
+    return false;
+}
+
+void QQmlDelegateModelGroupPrivate::criteriaChanged()
+{
+    if (!model)
+        return;
+    QQmlDelegateModelPrivate *modelPrivate = QQmlDelegateModelPrivate::get(model);
+    if (!modelPrivate->m_complete)
+        return;
+    modelPrivate->applyGroupCriteria(this);
+    modelPrivate->emitChanges();
+}
+
 /*!
     \qmlmethod object QtQml.Models::DelegateModelGroup::get(int index)
 
@@ -2956,7 +3794,7 @@ QJSValue QQmlDelegateModelGroup::get(int index)
         return QJSValue();
     }
 
-    Compositor::iterator it = model->m_compositor.find(d->group, index);
+    Compositor::iterator it = model->m_compositor.find(d->group, d->toGroupIndex(index));
     QQmlDelegateModelItem *cacheItem = it->inCache()
             ? model->m_cache.at(it.cacheIndex())
             : 0;
@@ -3050,6 +3888,8 @@ void QQmlDelegateModelGroup::insert(QQmlV4Function *args)
         if (++i == args->length())
             return;
         v = (*args)[i];
+        if (group == d->group)
+            index = d->toGroupIndex(index);
     }
 
     Compositor::insert_iterator before = index < model->m_compositor.count(group)
@@ -3104,8 +3944,11 @@ void QQmlDelegateModelGroup::create(QQmlV4Function *args)
     int  i = 0;
     QV4::Scope scope(args->v4engine());
     QV4::ScopedValue v(scope, (*args)[i]);
-    if (d->parseIndex(v, &index, &group))
+    if (d->parseIndex(v, &index, &group)) {
+        if (group == d->group)
+            index = d->toGroupIndex(index);
         ++i;
+    }
 
     if (i < args->length() && index >= 0 && index <= model->m_compositor.count(group)) {
         v = (*args)[i];
@@ -3201,6 +4044,8 @@ void QQmlDelegateModelGroup::resolve(QQmlV4Function *args)
         return;
     }
 
+    from = model->toGroupIndex(fromGroup, from);
+    to = model->toGroupIndex(toGroup, to);
     Compositor::iterator fromIt = model->m_compositor.find(fromGroup, from);
     Compositor::iterator toIt = model->m_compositor.find(toGroup, to);
 
@@ -3260,6 +4105,32 @@ void QQmlDelegateModelGroup::resolve(QQmlV4Function *args)
     model->emitChanges();
 }
 
+// Applies a membership change to the count items from the sorted position index of a sorted
+// group, one run of consecutive group indexes at a time. The runs are applied last first so
+// that the indexes of those still to come stay valid, and their changes are emitted together.
+template <typename Apply>
+static void applyToSortedRange(QQmlDelegateModelGroupPrivate *group, int index, int count, Apply apply)
+{
+    QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(group->model);
+    model->updateSortedOrder(group);
+    QVector<int> indexes;
+    indexes.reserve(count);
+    for (int position = index; position < index + count; ++position)
+        indexes.append(group->sortedOrder.toGroupIndex(position));
+    std::sort(indexes.begin(), indexes.end(), std::greater<int>());
+
+    const bool transaction = model->m_transaction;
+    model->m_transaction = true;
+    for (int i = 0, run = 1; i < indexes.size(); i += run) {
+        run = 1;
+        while (i + run < indexes.size() && indexes.at(i + run) == indexes.at(i) - run)
+            ++run;
+        apply(model->m_compositor.find(group->group, indexes.at(i + run - 1)), run);
+    }
+    model->m_transaction = transaction;
+    model->emitChanges();
+}
+
 /*!
     \qmlmethod QtQml.Models::DelegateModelGroup::remove(int index, int count)
 
@@ -3295,6 +4166,14 @@ void QQmlDelegateModelGroup::remove(QQmlV4Function *args)
     QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(d->model);
     if (index < 0 || index >= model->m_compositor.count(group)) {
         qmlWarning(this) << tr("remove: index out of range");
+    } else if (count != 0 && group == d->group && d->sortActive) {
+        if (count < 0 || count > model->m_compositor.count(d->group) - index) {
+            qmlWarning(this) << tr("remove: invalid count");
+        } else {
+            applyToSortedRange(d, index, count, [&](Compositor::iterator it, int run) {
+                model->removeGroups(it, run, d->group, 1 << d->group);
+            });
+        }
     } else if (count != 0) {
         Compositor::iterator it = model->m_compositor.find(group, index);
         if (count < 0 || count > model->m_compositor.count(d->group) - it.index[d->group]) {
@@ -3354,6 +4233,14 @@ void QQmlDelegateModelGroup::addGroups(QQmlV4Function *args)
     QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(d->model);
     if (index < 0 || index >= model->m_compositor.count(group)) {
         qmlWarning(this) << tr("addGroups: index out of range");
+    } else if (count != 0 && group == d->group && d->sortActive) {
+        if (count < 0 || count > model->m_compositor.count(d->group) - index) {
+            qmlWarning(this) << tr("addGroups: invalid count");
+        } else {
+            applyToSortedRange(d, index, count, [&](Compositor::iterator it, int run) {
+                model->addGroups(it, run, d->group, groups);
+            });
+        }
     } else if (count != 0) {
         Compositor::iterator it = model->m_compositor.find(group, index);
         if (count < 0 || count > model->m_compositor.count(d->group) - it.index[d->group]) {
@@ -3384,6 +4271,14 @@ void QQmlDelegateModelGroup::removeGroups(QQmlV4Function *args)
     QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(d->model);
     if (index < 0 || index >= model->m_compositor.count(group)) {
         qmlWarning(this) << tr("removeGroups: index out of range");
+    } else if (count != 0 && group == d->group && d->sortActive) {
+        if (count < 0 || count > model->m_compositor.count(d->group) - index) {
+            qmlWarning(this) << tr("removeGroups: invalid count");
+        } else {
+            applyToSortedRange(d, index, count, [&](Compositor::iterator it, int run) {
+                model->removeGroups(it, run, d->group, groups);
+            });
+        }
     } else if (count != 0) {
         Compositor::iterator it = model->m_compositor.find(group, index);
         if (count < 0 || count > model->m_compositor.count(d->group) - it.index[d->group]) {
@@ -3415,6 +4310,14 @@ void QQmlDelegateModelGroup::setGroups(QQmlV4Function *args)
     QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(d->model);
     if (index < 0 || index >= model->m_compositor.count(group)) {
         qmlWarning(this) << tr("setGroups: index out of range");
+    } else if (count != 0 && group == d->group && d->sortActive) {
+        if (count < 0 || count > model->m_compositor.count(d->group) - index) {
+            qmlWarning(this) << tr("setGroups: invalid count");
+        } else {
+            applyToSortedRange(d, index, count, [&](Compositor::iterator it, int run) {
+                model->setGroups(it, run, d->group, groups);
+            });
+        }
     } else if (count != 0) {
         Compositor::iterator it = model->m_compositor.find(group, index);
         if (count < 0 || count > model->m_compositor.count(d->group) - it.index[d->group]) {
@@ -3434,6 +4337,8 @@ void QQmlDelegateModelGroup::setGroups(QQmlV4Function *args)
     different order than the \l{dm-model-property}{underlying model} has them.
     Any subsequent changes to the underlying model will not undo whatever
     reordering you have done via this function.
+
+    Items cannot be moved within a group that has a \l sortRole.
 */
 
 void QQmlDelegateModelGroup::move(QQmlV4Function *args)
@@ -3470,7 +4375,9 @@ void QQmlDelegateModelGroup::move(QQmlV4Function *args)
 
     QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(d->model);
 
-    if (count < 0) {
+    if (d->sortActive) {
+        qmlWarning(this) << tr("move: a sorted group cannot be reordered");
+    } else if (count < 0) {
         qmlWarning(this) << tr("move: invalid count");
     } else if (from < 0 || from + count > model->m_compositor.count(fromGroup)) {
         qmlWarning(this) << tr("move: from index out of range");
@@ -3582,7 +4489,14 @@ void QQmlPartsModel::updateFilterGroup()
         model->m_compositor.transition(previousGroup, m_compositorGroup, &removes, &inserts);
 
         QQmlChangeSet changeSet;
-        changeSet.move(removes, inserts);
+        if (model->isSorted(previousGroup) || model->isSorted(m_compositorGroup)) {
+            if (const int count = model->m_compositor.count(previousGroup))
+                changeSet.remove(0, count);
+            if (const int count = model->m_compositor.count(m_compositorGroup))
+                changeSet.insert(0, count);
+        } else {
+            changeSet.move(removes, inserts);
+        }
         if (!changeSet.isEmpty())
             emit modelUpdated(changeSet, false);
 
@@ -3631,7 +4545,8 @@ QObject *QQmlPartsModel::object(int index, QQmlIncubator::IncubationMode incubat
         return nullptr;
     }
 
-    QObject *object = model->object(m_compositorGroup, index, incubationMode);
+    QObject *object = model->object(
+            m_compositorGroup, model->toGroupIndex(m_compositorGroup, index), incubationMode);
 
     if (QQuickPackage *package = qmlobject_cast<QQuickPackage *>(object)) {
         QObject *part = package->part(m_part);
@@ -3671,7 +4586,9 @@ QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item, ReusableF
 
 QVariant QQmlPartsModel::variantValue(int index, const QString &role)
 {
-    return QQmlDelegateModelPrivate::get(m_model)->variantValue(m_compositorGroup, index, role);
+    QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(m_model);
+    return model->variantValue(
+            m_compositorGroup, model->toGroupIndex(m_compositorGroup, index), role);
 }
 
 void QQmlPartsModel::setWatchedRoles(const QList<QByteArray> &roles)
@@ -3684,7 +4601,8 @@ void QQmlPartsModel::setWatchedRoles(const QList<QByteArray> &roles)
 QQmlIncubator::Status QQmlPartsModel::incubationStatus(int index)
 {
     QQmlDelegateModelPrivate *model = QQmlDelegateModelPrivate::get(m_model);
-    Compositor::iterator it = model->m_compositor.find(model->m_compositorGroup, index);
+    Compositor::iterator it = model->m_compositor.find(
+            model->m_compositorGroup, model->toGroupIndex(model->m_compositorGroup, index));
     if (!it->inCache())
         return QQmlIncubator::Null;
 
@@ -3737,7 +4655,9 @@ void QQmlPartsModel::emitModelUpdated(const QQmlChangeSet &changeSet, bool reset
     for (int index : pendingPackageInitializations) {
         if (!model->m_delegate || index < 0 || index >= model->m_compositor.count(m_compositorGroup))
             continue;
-        QObject *object = model->object(m_compositorGroup, index, QQmlIncubator::Asynchronous);
+        QObject *object = model->object(
+                m_compositorGroup, model->toGroupIndex(m_compositorGroup, index),
+                QQmlIncubator::Asynchronous);
         if (QQuickPackage *package = qmlobject_cast<QQuickPackage *>(object))
             emit initItem(index, package->part(m_part));
         model->release(object);
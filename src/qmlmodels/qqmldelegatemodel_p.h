@@ -138,6 +138,10 @@ class Q_QMLMODELS_PRIVATE_EXPORT QQmlDelegateModelGroup : public QObject
     Q_PROPERTY(int count READ count NOTIFY countChanged)
     Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
     Q_PROPERTY(bool includeByDefault READ defaultInclude WRITE setDefaultInclude NOTIFY defaultIncludeChanged)
+    Q_PROPERTY(QString sortRole READ sortRole WRITE setSortRole NOTIFY sortRoleChanged REVISION(6, 6))
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortOrderChanged REVISION(6, 6))
+    Q_PROPERTY(QString filterRole READ filterRole WRITE setFilterRole NOTIFY filterRoleChanged REVISION(6, 6))
+    Q_PROPERTY(QJSValue filter READ filter WRITE setFilter NOTIFY filterChanged REVISION(6, 6))
     QML_NAMED_ELEMENT(DelegateModelGroup)
     QML_ADDED_IN_VERSION(2, 1)
 public:
@@ -153,6 +157,18 @@ public:
     bool defaultInclude() const;
     void setDefaultInclude(bool include);
 
+    QString sortRole() const;
+    void setSortRole(const QString &role);
+
+    Qt::SortOrder sortOrder() const;
+    void setSortOrder(Qt::SortOrder order);
+
+    QString filterRole() const;
+    void setFilterRole(const QString &role);
+
+    QJSValue filter() const;
+    void setFilter(const QJSValue &filter);
+
     Q_INVOKABLE QJSValue get(int index);
 
 public Q_SLOTS:
@@ -170,6 +186,10 @@ Q_SIGNALS:
     void nameChanged();
     void defaultIncludeChanged();
     void changed(const QJSValue &removed, const QJSValue &inserted);
+    Q_REVISION(6, 6) void sortRoleChanged();
+    Q_REVISION(6, 6) void sortOrderChanged();
+    Q_REVISION(6, 6) void filterRoleChanged();
+    Q_REVISION(6, 6) void filterChanged();
 private:
     Q_DECLARE_PRIVATE(QQmlDelegateModelGroup)
 };
@@ -214,6 +234,8 @@ public:
 
     void emitUnresolvedChanged() { Q_EMIT unresolvedChanged(); }
 
+    int sortedIndex(int group) const;
+
 Q_SIGNALS:
     void groupsChanged();
     void unresolvedChanged();
@@ -12,6 +12,7 @@
 
 #include <private/qqmladaptormodel_p.h>
 #include <private/qqmlopenmetaobject_p.h>
+#include <private/qqmlsortedorder_p.h>
 
 #include <QtCore/qloggingcategory.h>
 
@@ -233,11 +234,31 @@ public:
     bool parseGroupArgs(
             QQmlV4Function *args, Compositor::Group *group, int *index, int *count, int *groups) const;
 
+    bool isSorted() const { return !sortRole.isEmpty(); }
+    bool isFiltered() const { return !filterRole.isEmpty() && filter.isCallable(); }
+    bool dependsOnRoles(const QAbstractItemModel *aim, const QVector<int> &roles) const;
+    void criteriaChanged();
+
+    int toGroupIndex(int index);
+    int toSortedIndex(int index);
+    const QQmlChangeSet &pendingChanges();
+
     Compositor::Group group;
     QPointer<QQmlDelegateModel> model;
     QQmlDelegateModelGroupEmitterList emitters;
     QQmlChangeSet changeSet;
+    // A sorted group keeps its order here rather than moving items in the compositor, which
+    // would reorder every other group too. changeSet then holds changes by group index until
+    // they are translated to sortedChangeSet, which holds them by sorted position.
+    QQmlChangeSet sortedChangeSet;
+    QQmlSortedOrder sortedOrder;
+    int sortMoveId = 0;
+    bool sortActive = false;
     QString name;
+    QString sortRole;
+    QString filterRole;
+    QJSValue filter;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
     bool defaultInclude;
 };
 
@@ -266,9 +287,11 @@ public:
     void emitCreatedPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitInitPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitCreatedItem(QQDMIncubationTask *incubationTask, QObject *item) {
-        Q_EMIT q_func()->createdItem(incubationTask->index[m_compositorGroup], item); }
+        Q_EMIT q_func()->createdItem(
+                toSortedIndex(m_compositorGroup, incubationTask->index[m_compositorGroup]), item); }
     void emitInitItem(QQDMIncubationTask *incubationTask, QObject *item) {
-        Q_EMIT q_func()->initItem(incubationTask->index[m_compositorGroup], item); }
+        Q_EMIT q_func()->initItem(
+                toSortedIndex(m_compositorGroup, incubationTask->index[m_compositorGroup]), item); }
     void emitDestroyingPackage(QQuickPackage *package);
     void emitDestroyingItem(QObject *item) { Q_EMIT q_func()->destroyingItem(item); }
     void addCacheItem(QQmlDelegateModelItem *item, Compositor::iterator it);
@@ -298,6 +321,37 @@ public:
             const QVector<Compositor::Remove> &removes, const QVector<Compositor::Insert> &inserts);
     void itemsChanged(const QVector<Compositor::Change> &changes);
     void emitChanges();
+
+    QVector<std::pair<int, int>> groupRows(Compositor::Group group, int index, int count);
+    bool updateGroupCriteria(int index, int count, const QVector<int> &roles);
+    void updateGroupCriteria(QQmlDelegateModelGroupPrivate *group, int index, int count);
+    void updateGroupFilters(int index, int count);
+    void applyGroupCriteria(QQmlDelegateModelGroupPrivate *group);
+    void applyGroupCriteria();
+    void filterGroupRows(QQmlDelegateModelGroupPrivate *group, const QVector<std::pair<int, int>> &rows);
+    void sortGroupRows(QQmlDelegateModelGroupPrivate *group, const QVector<std::pair<int, int>> &rows);
+    void sortGroup(QQmlDelegateModelGroupPrivate *group);
+    void unsortGroup(QQmlDelegateModelGroupPrivate *group);
+    void updateSortedOrder(QQmlDelegateModelGroupPrivate *group);
+    QVariant sortKey(QQmlDelegateModelGroupPrivate *group, const Compositor::iterator &it);
+    int toGroupIndex(Compositor::Group group, int index) {
+        return group != Compositor::Cache
+                ? QQmlDelegateModelGroupPrivate::get(m_groups[group])->toGroupIndex(index)
+                : index; }
+    int toSortedIndex(Compositor::Group group, int index) {
+        return group != Compositor::Cache
+                ? QQmlDelegateModelGroupPrivate::get(m_groups[group])->toSortedIndex(index)
+                : index; }
+    bool isSorted(Compositor::Group group) const {
+        return group != Compositor::Cache
+                && QQmlDelegateModelGroupPrivate::get(m_groups[group])->sortActive; }
+
+    void queueItemsChanged(int index, int count, const QVector<int> &roles);
+    void queuedItemsInserted(int index, int count);
+    void queuedItemsRemoved(int index, int count);
+    void queuedItemsMoved(int from, int to, int count);
+    void clearQueuedChanges();
+    void flushItemsChanged();
     void emitModelUpdated(const QQmlChangeSet &changeSet, bool reset) override;
     void delegateChanged(bool add = true, bool remove = true);
 
@@ -330,6 +384,9 @@ public:
 
     QString m_filterGroup;
 
+    QVector<QQmlChangeSet::Change> m_pendingChanges;
+    QVector<int> m_pendingRoles;
+
     int m_count;
     int m_groupCount;
 
@@ -340,6 +397,9 @@ public:
     bool m_transaction : 1;
     bool m_incubatorCleanupScheduled : 1;
     bool m_waitingToFetchMore : 1;
+    bool m_coalesceChanges : 1;
+    bool m_pendingAllRoles : 1;
+    bool m_flushScheduled : 1;
 
     union {
         struct {
@@ -16,6 +16,7 @@
 #include <private/qv4dateobject_p.h>
 #include <private/qv4urlobject_p.h>
 #include <private/qv4objectiterator_p.h>
+#include <private/qv4typedarray_p.h>
 #include <private/qv4alloca_p.h>
 #include <private/qv4lookup_p.h>
 #include <private/qv4qmlcontext_p.h>
@@ -494,6 +495,14 @@ void ListModel::insertElement(int index)
     updateCacheIndices(index);
 }
 
+void ListModel::insertElements(int index, int count)
+{
+    elements.insertBlank(index, count);
+    for (int i = 0; i < count; ++i)
+        elements[index + i] = new ListElement;
+    updateCacheIndices(index + count);
+}
+
 void ListModel::move(int from, int to, int n)
 {
     if (from > to) {
@@ -772,6 +781,121 @@ int ListModel::append(QV4::Object *object)
     return elementIndex;
 }
 
+static ListLayout::Role::DataType valueRoleType(const QV4::Value &value)
+{
+    if (value.isString())
+        return ListLayout::Role::String;
+    if (value.isNumber())
+        return ListLayout::Role::Number;
+    if (value.isBoolean())
+        return ListLayout::Role::Bool;
+    if (value.as<QV4::ArrayObject>())
+        return ListLayout::Role::List;
+    if (value.as<QV4::DateObject>())
+        return ListLayout::Role::DateTime;
+    if (value.as<QV4::UrlObject>())
+        return ListLayout::Role::Url;
+    if (value.as<QV4::FunctionObject>())
+        return ListLayout::Role::Function;
+    if (value.as<QV4::QObjectWrapper>())
+        return ListLayout::Role::QObject;
+    if (value.isObject())
+        return ListLayout::Role::VariantMap;
+    return ListLayout::Role::Invalid;
+}
+
+// Objects are left to ListElement::setJsProperty(), which converts them where it can
+static bool columnValueFits(const ListLayout::Role &r, const QV4::Value &value)
+{
+    const ListLayout::Role::DataType type = valueRoleType(value);
+    switch (type) {
+    case ListLayout::Role::QObject:
+    case ListLayout::Role::VariantMap:
+        return true;
+    default:
+        return type == r.type;
+    }
+}
+
+static ListLayout::Role::DataType columnRoleType(QV4::Object *column)
+{
+    if (column->as<QV4::TypedArray>())
+        return ListLayout::Role::Number;
+
+    QV4::Scope scope(column->engine());
+    QV4::ScopedValue value(scope);
+    const int length = column->getLength();
+    for (int i = 0; i < length; ++i) {
+        value = column->get(i);
+        const ListLayout::Role::DataType type = valueRoleType(value);
+        if (type != ListLayout::Role::Invalid)
+            return type;
+    }
+    return ListLayout::Role::Invalid;
+}
+
+/*!
+    \internal
+
+    Inserts \a count new elements at \a elementIndex and fills them from the
+    arrays in \a columns, one per role in \a names. Each role is looked up
+    once for the whole batch, with its type taken from the first defined value
+    in the column. Typed arrays are read directly from their buffer. Values
+    that do not fit the type of an existing role are skipped with the same
+    warning as append() gives.
+*/
+void ListModel::insertColumns(int elementIndex, int count, const QStringList &names,
+                              const QV4::Value *columns, QV4::ExecutionEngine *eng)
+{
+    insertElements(elementIndex, count);
+
+    QV4::Scope scope(eng);
+    QV4::ScopedObject column(scope);
+    QV4::ScopedValue value(scope);
+    for (int c = 0; c < names.size(); ++c) {
+        column = columns[c];
+        const ListLayout::Role::DataType type = columnRoleType(column);
+        if (type == ListLayout::Role::Invalid)
+            continue;
+        // Values that do not fit an existing role are reported below
+        const ListLayout::Role *existing = m_layout->getExistingRole(names.at(c));
+        const ListLayout::Role &r = existing ? *existing : m_layout->getRoleOrCreate(names.at(c), type);
+
+        if (QV4::TypedArray *typed = column->as<QV4::TypedArray>()) {
+            if (r.type != ListLayout::Role::Number) {
+                // None of the values fit, so report the column once rather than every element
+                qmlWarning(nullptr) << QStringLiteral("Can't assign to existing role '%1' of different type [%2 -> %3]").arg(r.name).arg(roleTypeName(type)).arg(roleTypeName(r.type));
+                continue;
+            }
+            const char *data = typed->constArrayData() + typed->byteOffset();
+            const int stride = typed->bytesPerElement();
+            const auto read = typed->d()->type->read;
+            for (int i = 0; i < count; ++i) {
+                const double n = QV4::Value::fromReturnedValue(read(data + i * stride)).toNumber();
+                elements[elementIndex + i]->setDoublePropertyFast(r, n);
+            }
+            continue;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            value = column->get(i);
+            ListElement *e = elements[elementIndex + i];
+            if (r.type == ListLayout::Role::String && value->isString())
+                e->setStringPropertyFast(r, value->toQString());
+            else if (r.type == ListLayout::Role::Number && value->isNumber())
+                e->setDoublePropertyFast(r, value->asDouble());
+            else if (r.type == ListLayout::Role::Bool && value->isBoolean())
+                e->setBoolPropertyFast(r, value->booleanValue());
+            else if (value->isNullOrUndefined())
+                continue;
+            else if (!columnValueFits(r, value))
+                qmlWarning(nullptr) << QStringLiteral("Can't assign to existing role '%1' of different type [%2 -> %3]").arg(r.name).arg(roleTypeName(valueRoleType(value))).arg(roleTypeName(r.type));
+            else
+                e->setJsProperty(r, value, eng);
+        }
+    }
+}
+
 int ListModel::setOrCreateProperty(int elementIndex, const QString &key, const QVariant &data)
 {
     int roleIndex = -1;
@@ -2664,6 +2788,8 @@ void QQmlListModel::append(QQmlV4Function *args)
             if (objectArrayLength > 0) {
                 int index = count();
                 emitItemsAboutToBeInserted(index, objectArrayLength);
+                if (!m_dynamicRoles)
+                    m_listModel->reserveElements(index + objectArrayLength);
 
                 for (int i=0 ; i < objectArrayLength ; ++i) {
                     argObject = objectArray->get(i);
@@ -2699,6 +2825,137 @@ void QQmlListModel::append(QQmlV4Function *args)
     }
 }
 
+/*!
+    \qmlmethod ListModel::appendColumns(jsobject columns)
+    \since 6.6
+
+    Adds new items to the end of the list model, with the values given
+    column by column: each property of \a columns is an array (or a typed
+    array such as \c Float64Array) holding the values of that role for
+    all the new items. All arrays must have the same length.
+
+    \code
+        fruitModel.appendColumns({
+            "name": ["Apple", "Banana", "Cherry"],
+            "cost": new Float64Array([1.2, 0.8, 3.5])
+        })
+    \endcode
+
+    This is equivalent to appending one object per item, but the roles are
+    looked up once for the whole batch and the model emits a single
+    insertion, which makes it much faster for large amounts of data. The
+    type of each new role is taken from the first value in its column that
+    is neither \c null nor \c undefined.
+
+    \sa append(), insertColumns()
+*/
+void QQmlListModel::appendColumns(QQmlV4Function *args)
+{
+    if (args->length() == 1) {
+        QV4::Scope scope(args->v4engine());
+        QV4::ScopedObject columns(scope, (*args)[0]);
+        insertColumnData(count(), columns, QLatin1String("appendColumns"));
+    } else {
+        qmlWarning(this) << tr("appendColumns: value is not an object");
+    }
+}
+
+/*!
+    \qmlmethod ListModel::insertColumns(int index, jsobject columns)
+    \since 6.6
+
+    Adds new items to the list model at position \a index, with the values
+    given column by column as in appendColumns().
+
+    The \a index must be to an existing item in the list, or one past
+    the end of the list (equivalent to appendColumns()).
+
+    \sa insert(), appendColumns()
+*/
+void QQmlListModel::insertColumns(QQmlV4Function *args)
+{
+    if (args->length() == 2) {
+        QV4::Scope scope(args->v4engine());
+        QV4::ScopedValue arg0(scope, (*args)[0]);
+        int index = arg0->toInt32();
+
+        if (index < 0 || index > count()) {
+            qmlWarning(this) << tr("insertColumns: index %1 out of range").arg(index);
+            return;
+        }
+
+        QV4::ScopedObject columns(scope, (*args)[1]);
+        insertColumnData(index, columns, QLatin1String("insertColumns"));
+    } else {
+        qmlWarning(this) << tr("insertColumns: value is not an object");
+    }
+}
+
+void QQmlListModel::insertColumnData(int index, QV4::Object *columns, QLatin1String method)
+{
+    if (!columns || columns->as<QV4::ArrayObject>()) {
+        qmlWarning(this) << tr("%1: value is not an object").arg(method);
+        return;
+    }
+
+    QV4::Scope scope(columns->engine());
+    QStringList names;
+    {
+        QV4::ObjectIterator it(scope, columns, QV4::ObjectIterator::EnumerableOnly);
+        QV4::ScopedString name(scope);
+        QV4::ScopedValue value(scope);
+        while ((name = it.nextPropertyNameAsString(value)))
+            names.append(name->toQString());
+    }
+
+    QV4::Value *columnValues = scope.alloc(names.size());
+    QV4::ScopedString name(scope);
+    int rowCount = -1;
+    for (int c = 0; c < names.size(); ++c) {
+        name = scope.engine->newString(names.at(c));
+        columnValues[c] = columns->get(name);
+        const QV4::Object *column = columnValues[c].as<QV4::Object>();
+        int length = -1;
+        if (const QV4::TypedArray *typed = column ? column->as<QV4::TypedArray>() : nullptr) {
+            if (!typed->hasDetachedArrayData())
+                length = typed->length();
+        } else if (column && column->as<QV4::ArrayObject>()) {
+            length = column->getLength();
+        }
+        if (length < 0) {
+            qmlWarning(this) << tr("%1: role %2 is not an array").arg(method, names.at(c));
+            return;
+        }
+        if (rowCount >= 0 && length != rowCount) {
+            qmlWarning(this) << tr("%1: all roles must have the same number of values").arg(method);
+            return;
+        }
+        rowCount = length;
+    }
+
+    if (rowCount <= 0)
+        return;
+
+    emitItemsAboutToBeInserted(index, rowCount);
+    if (m_dynamicRoles) {
+        QV4::ScopedObject column(scope);
+        QV4::ScopedValue value(scope);
+        for (int i = 0; i < rowCount; ++i) {
+            QVariantMap values;
+            for (int c = 0; c < names.size(); ++c) {
+                column = columnValues[c];
+                value = column->get(i);
+                if (!value->isNullOrUndefined())
+                    values.insert(names.at(c), QV4::ExecutionEngine::toVariant(value, QMetaType {}));
+            }
+            m_modelObjects.insert(index + i, DynamicRoleModelNode::create(values, this));
+        }
+    } else {
+        m_listModel->insertColumns(index, rowCount, names, columnValues, scope.engine);
+    }
+    emitItemsInserted();
+}
+
 /*!
     \qmlmethod object ListModel::get(int index)
 
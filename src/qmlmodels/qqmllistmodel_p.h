@@ -39,6 +39,7 @@ class ListLayout;
 
 namespace QV4 {
 struct ModelObject;
+struct Object;
 }
 
 class Q_QMLMODELS_PRIVATE_EXPORT QQmlListModel : public QAbstractListModel
@@ -73,6 +74,8 @@ public:
     Q_INVOKABLE void setProperty(int index, const QString& property, const QVariant& value);
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
+    Q_REVISION(6, 6) Q_INVOKABLE void appendColumns(QQmlV4Function *args);
+    Q_REVISION(6, 6) Q_INVOKABLE void insertColumns(QQmlV4Function *args);
 
     QQmlListModelWorkerAgent *agent();
 
@@ -134,6 +137,7 @@ private:
     void emitItemsInserted();
 
     void removeElements(int index, int removeCount);
+    void insertColumnData(int index, QV4::Object *columns, QLatin1String method);
 
     void updateTranslations();
 };
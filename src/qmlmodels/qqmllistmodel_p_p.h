@@ -397,11 +397,15 @@ public:
 
     int append(QV4::Object *object);
     void insert(int elementIndex, QV4::Object *object);
+    void insertColumns(int elementIndex, int count, const QStringList &names,
+                       const QV4::Value *columns, QV4::ExecutionEngine *eng);
 
     Q_REQUIRED_RESULT QVector<std::function<void()>> remove(int index, int count);
 
     int appendElement();
     void insertElement(int index);
+    void insertElements(int index, int count);
+    void reserveElements(int count) { elements.reserve(count); }
 
     void move(int from, int to, int n);
 
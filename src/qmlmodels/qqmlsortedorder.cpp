@@ -0,0 +1,301 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmlsortedorder_p.h"
+
+#include <QtCore/qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QQmlSortedOrder
+    \brief The QQmlSortedOrder class keeps the items of a sorted group in group order and in
+    sorted order at the same time.
+    \internal
+
+    A sorted DelegateModelGroup reports its items by sorted position, while the changes of the
+    model arrive by group index. Both orders shift whenever an item is inserted or removed, so
+    rather than storing one as indexes into the other, every item is a node in two trees, one per
+    order. The trees are treaps keyed by position: each node knows the size of its subtree and
+    its parent, which makes finding the item at a position, the position of an item, inserting
+    and removing all O(log n), expected.
+
+    An item is identified by an int that stays the same while it is moved around in either
+    order. Items are created with create() and taken out of both orders before destroy().
+    Since the keys are kept with the items, placing an item by its key with upperBound() only
+    compares keys, without looking up the model.
+*/
+
+void QQmlSortedOrder::clear()
+{
+    m_items.clear();
+    m_free.clear();
+    m_roots[GroupOrder] = -1;
+    m_roots[SortedOrder] = -1;
+}
+
+/*!
+    \internal
+    Replaces the items with one for each of the \a keys, in group order, and sorts them as in
+    \a sortedGroupIndexes, which holds the group index of the item at each sorted position.
+
+    The items are numbered by their group index afterwards.
+*/
+void QQmlSortedOrder::reset(QVector<QVariant> keys, const QVector<int> &sortedGroupIndexes)
+{
+    Q_ASSERT(keys.size() == sortedGroupIndexes.size());
+
+    clear();
+    QVector<int> items;
+    items.reserve(keys.size());
+    for (QVariant &key : keys)
+        items.append(create(std::move(key)));
+    assign(GroupOrder, items);
+    assign(SortedOrder, sortedGroupIndexes);
+}
+
+/*!
+    \internal
+    Returns a new item with the sort key \a key, which is in neither order yet.
+*/
+int QQmlSortedOrder::create(const QVariant &key)
+{
+    // A xorshift generator is plenty to keep the trees balanced.
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    Item item;
+    item.priority = m_seed;
+    item.key = key;
+    if (m_free.isEmpty()) {
+        m_items.append(std::move(item));
+        return m_items.size() - 1;
+    }
+    const int index = m_free.takeLast();
+    m_items[index] = std::move(item);
+    return index;
+}
+
+void QQmlSortedOrder::destroy(int item)
+{
+    Q_ASSERT(m_items.at(item).links[GroupOrder].size == 0);
+    Q_ASSERT(m_items.at(item).links[SortedOrder].size == 0);
+    m_items[item].key = QVariant();
+    m_free.append(item);
+}
+
+/*!
+    \internal
+    Returns the item at \a position in \a order.
+*/
+int QQmlSortedOrder::at(Order order, int position) const
+{
+    Q_ASSERT(position >= 0 && position < count(order));
+
+    int item = m_roots[order];
+    for (;;) {
+        const Link &link = m_items.at(item).links[order];
+        const int leftSize = size(order, link.left);
+        if (position < leftSize) {
+            item = link.left;
+        } else if (position == leftSize) {
+            return item;
+        } else {
+            position -= leftSize + 1;
+            item = link.right;
+        }
+    }
+}
+
+/*!
+    \internal
+    Returns the position of \a item in \a order.
+*/
+int QQmlSortedOrder::indexOf(Order order, int item) const
+{
+    const Link *link = &m_items.at(item).links[order];
+    Q_ASSERT(link->size > 0);
+
+    int position = size(order, link->left);
+    for (int parent = link->parent; parent >= 0; parent = link->parent) {
+        const Link &parentLink = m_items.at(parent).links[order];
+        if (parentLink.right == item)
+            position += size(order, parentLink.left) + 1;
+        item = parent;
+        link = &parentLink;
+    }
+    return position;
+}
+
+/*!
+    \internal
+    Inserts \a item, which must not be in \a order yet, at \a position in \a order.
+*/
+void QQmlSortedOrder::insert(Order order, int position, int item)
+{
+    Q_ASSERT(m_items.at(item).links[order].size == 0);
+    Q_ASSERT(position >= 0 && position <= count(order));
+
+    Link &link = m_items[item].links[order];
+    link = Link();
+    link.size = 1;
+
+    int left, right;
+    split(order, m_roots[order], position, &left, &right);
+    m_roots[order] = merge(order, merge(order, left, item), right);
+    m_items[m_roots[order]].links[order].parent = -1;
+}
+
+/*!
+    \internal
+    Removes \a item from \a order and returns the position it had.
+*/
+int QQmlSortedOrder::remove(Order order, int item)
+{
+    const int position = indexOf(order, item);
+
+    int left, middle, right;
+    split(order, m_roots[order], position, &left, &right);
+    split(order, right, 1, &middle, &right);
+    Q_ASSERT(middle == item);
+    m_roots[order] = merge(order, left, right);
+    if (m_roots[order] >= 0)
+        m_items[m_roots[order]].links[order].parent = -1;
+
+    m_items[item].links[order] = Link();
+    return position;
+}
+
+int QQmlSortedOrder::toGroupIndex(int sortedPosition) const
+{
+    return indexOf(GroupOrder, at(SortedOrder, sortedPosition));
+}
+
+int QQmlSortedOrder::toSortedPosition(int groupIndex) const
+{
+    return indexOf(SortedOrder, at(GroupOrder, groupIndex));
+}
+
+/*!
+    \internal
+    Returns the group index of the item at each sorted position.
+*/
+QVector<int> QQmlSortedOrder::sortedGroupIndexes() const
+{
+    const QVector<int> groupOrder = items(GroupOrder);
+    QVector<int> groupIndexes(m_items.size(), -1);
+    for (int index = 0; index < groupOrder.size(); ++index)
+        groupIndexes[groupOrder.at(index)] = index;
+
+    QVector<int> sortedOrder = items(SortedOrder);
+    for (int &index : sortedOrder)
+        index = groupIndexes.at(index);
+    return sortedOrder;
+}
+
+// Recounts the size of item's subtree in order, and makes item the parent of its children.
+void QQmlSortedOrder::update(Order order, int item)
+{
+    Link &link = m_items[item].links[order];
+    link.size = 1 + size(order, link.left) + size(order, link.right);
+    if (link.left >= 0)
+        m_items[link.left].links[order].parent = item;
+    if (link.right >= 0)
+        m_items[link.right].links[order].parent = item;
+}
+
+// Splits the subtree of item into the first position items and the rest. The parents of the
+// two new roots are left for the caller to set.
+void QQmlSortedOrder::split(Order order, int item, int position, int *left, int *right)
+{
+    if (item < 0) {
+        *left = *right = -1;
+        return;
+    }
+
+    Link &link = m_items[item].links[order];
+    const int leftSize = size(order, link.left);
+    if (leftSize < position) {
+        int rest;
+        split(order, link.right, position - leftSize - 1, &link.right, &rest);
+        update(order, item);
+        *left = item;
+        *right = rest;
+    } else {
+        int first;
+        split(order, link.left, position, &first, &link.left);
+        update(order, item);
+        *left = first;
+        *right = item;
+    }
+}
+
+// Joins two subtrees, all of left coming before right, and returns the new root. Its parent is
+// left for the caller to set.
+int QQmlSortedOrder::merge(Order order, int left, int right)
+{
+    if (left < 0)
+        return right;
+    if (right < 0)
+        return left;
+
+    if (m_items.at(left).priority > m_items.at(right).priority) {
+        Link &link = m_items[left].links[order];
+        link.right = merge(order, link.right, right);
+        update(order, left);
+        return left;
+    }
+    Link &link = m_items[right].links[order];
+    link.left = merge(order, left, link.left);
+    update(order, right);
+    return right;
+}
+
+// Replaces order with the items, in the given sequence, building the tree in O(n). The right
+// spine of the tree built so far is kept on a stack; an item with a higher priority than the
+// items at the end of the spine takes them as its left subtree.
+void QQmlSortedOrder::assign(Order order, const QVector<int> &items)
+{
+    QVarLengthArray<int, 64> spine;
+    for (int item : items) {
+        int last = -1;
+        while (!spine.isEmpty() && m_items.at(spine.last()).priority < m_items.at(item).priority) {
+            last = spine.takeLast();
+            update(order, last);
+        }
+        Link &link = m_items[item].links[order];
+        link = Link();
+        link.left = last;
+        if (!spine.isEmpty())
+            m_items[spine.last()].links[order].right = item;
+        spine.append(item);
+    }
+
+    m_roots[order] = spine.isEmpty() ? -1 : spine.first();
+    while (!spine.isEmpty())
+        update(order, spine.takeLast());
+    if (m_roots[order] >= 0)
+        m_items[m_roots[order]].links[order].parent = -1;
+}
+
+// Returns the items of order, in order.
+QVector<int> QQmlSortedOrder::items(Order order) const
+{
+    QVector<int> result;
+    result.reserve(count(order));
+    QVarLengthArray<int, 64> stack;
+    int item = m_roots[order];
+    while (item >= 0 || !stack.isEmpty()) {
+        while (item >= 0) {
+            stack.append(item);
+            item = m_items.at(item).links[order].left;
+        }
+        item = stack.takeLast();
+        result.append(item);
+        item = m_items.at(item).links[order].right;
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,123 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLSORTEDORDER_P_H
+#define QQMLSORTEDORDER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+class Q_AUTOTEST_EXPORT QQmlSortedOrder
+{
+public:
+    enum Order { GroupOrder, SortedOrder };
+
+    int count() const { return size(SortedOrder, m_roots[SortedOrder]); }
+    int count(Order order) const { return size(order, m_roots[order]); }
+    void clear();
+    void reset(QVector<QVariant> keys, const QVector<int> &sortedGroupIndexes);
+
+    int create(const QVariant &key);
+    void destroy(int item);
+    const QVariant &key(int item) const { return m_items.at(item).key; }
+    void setKey(int item, const QVariant &key) { m_items[item].key = key; }
+
+    int at(Order order, int position) const;
+    int indexOf(Order order, int item) const;
+    void insert(Order order, int position, int item);
+    int remove(Order order, int item);
+
+    int toGroupIndex(int sortedPosition) const;
+    int toSortedPosition(int groupIndex) const;
+    QVector<int> sortedGroupIndexes() const;
+
+    template <typename LessThan>
+    int upperBound(const QVariant &key, LessThan lessThan) const;
+    template <typename LessThan>
+    void sort(LessThan lessThan);
+
+private:
+    struct Link
+    {
+        int parent = -1;
+        int left = -1;
+        int right = -1;
+        int size = 0; // 0 if the item is not in the order
+    };
+
+    struct Item
+    {
+        Link links[2];
+        quint32 priority = 0;
+        QVariant key;
+    };
+
+    int size(Order order, int item) const { return item < 0 ? 0 : m_items.at(item).links[order].size; }
+    void update(Order order, int item);
+    void split(Order order, int item, int position, int *left, int *right);
+    int merge(Order order, int left, int right);
+    void assign(Order order, const QVector<int> &items);
+    QVector<int> items(Order order) const;
+
+    QVector<Item> m_items;
+    QVector<int> m_free;
+    int m_roots[2] = { -1, -1 };
+    quint32 m_seed = 0x9e3779b9;
+};
+
+/*!
+    \internal
+    Returns the position in the sorted order of the first item whose key \a key sorts before
+    according to \a lessThan. This is where an item with that key goes, after any items with an
+    equal key.
+*/
+template <typename LessThan>
+int QQmlSortedOrder::upperBound(const QVariant &key, LessThan lessThan) const
+{
+    int position = 0;
+    for (int item = m_roots[SortedOrder]; item >= 0;) {
+        const Link &link = m_items.at(item).links[SortedOrder];
+        if (lessThan(key, m_items.at(item).key)) {
+            item = link.left;
+        } else {
+            position += size(SortedOrder, link.left) + 1;
+            item = link.right;
+        }
+    }
+    return position;
+}
+
+/*!
+    \internal
+    Replaces the sorted order with all items of the group order, stably sorted by their keys
+    according to \a lessThan.
+*/
+template <typename LessThan>
+void QQmlSortedOrder::sort(LessThan lessThan)
+{
+    QVector<int> sorted = items(GroupOrder);
+    std::stable_sort(sorted.begin(), sorted.end(), [&](int left, int right) {
+        return lessThan(m_items.at(left).key, m_items.at(right).key);
+    });
+    assign(SortedOrder, sorted);
+}
+
+QT_END_NAMESPACE
+
+#endif // QQMLSORTEDORDER_P_H
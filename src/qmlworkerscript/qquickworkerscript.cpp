@@ -15,6 +15,7 @@
 #include <QtCore/qwaitcondition.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qdatetime.h>
+#include <QtCore/qthread.h>
 #include <QtQml/qqmlinfo.h>
 #include <QtQml/qqmlfile.h>
 #if QT_CONFIG(qml_network)
@@ -30,6 +31,8 @@
 #include <private/qv4scopedvalue_p.h>
 #include <private/qv4jscall_p.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 class WorkerDataEvent : public QEvent
@@ -37,15 +40,19 @@ class WorkerDataEvent : public QEvent
 public:
     enum Type { WorkerData = QEvent::User };
 
-    WorkerDataEvent(int workerId, const QByteArray &data);
+    WorkerDataEvent(int workerId, const QByteArray &data,
+                    const QList<QByteArray> &transferredBuffers = {});
     virtual ~WorkerDataEvent();
 
     int workerId() const;
     QByteArray data() const;
+    QList<QByteArray> transferredBuffers() const;
 
 private:
     int m_id;
     QByteArray m_data;
+    // The storage of transferred ArrayBuffers, owned by the event until it is delivered.
+    QList<QByteArray> m_transferredBuffers;
 };
 
 class WorkerLoadEvent : public QEvent
@@ -137,7 +144,7 @@ protected:
     bool event(QEvent *) override;
 
 private:
-    void processMessage(int, const QByteArray &);
+    void processMessage(int, const QByteArray &, const QList<QByteArray> &);
     void processLoad(int, const QUrl &);
     void reportScriptException(WorkerScript *, const QQmlError &error);
 };
@@ -155,11 +162,17 @@ QV4::ReturnedValue QQuickWorkerScriptEnginePrivate::method_sendMessage(const QV4
     Q_ASSERT(script);
 
     QV4::ScopedValue v(scope, argc > 0 ? argv[0] : QV4::Value::undefinedValue());
-    QByteArray data = QV4::Serialize::serialize(v, scope.engine);
+    QV4::ScopedValue transfer(scope, argc > 1 ? argv[1] : QV4::Value::undefinedValue());
+    QList<QByteArray> transferredBuffers;
+    QByteArray data = QV4::Serialize::serialize(v, transfer, scope.engine, &transferredBuffers);
+    if (scope.hasException())
+        return QV4::Encode::undefined();
 
     QMutexLocker locker(&script->p->m_lock);
-    if (script->owner)
-        QCoreApplication::postEvent(script->owner, new WorkerDataEvent(0, data));
+    if (script->owner) {
+        QCoreApplication::postEvent(script->owner,
+                                    new WorkerDataEvent(0, data, transferredBuffers));
+    }
 
     return QV4::Encode::undefined();
 }
@@ -168,7 +181,8 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
 {
     if (event->type() == (QEvent::Type)WorkerDataEvent::WorkerData) {
         WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
-        processMessage(workerEvent->workerId(), workerEvent->data());
+        processMessage(workerEvent->workerId(), workerEvent->data(),
+                       workerEvent->transferredBuffers());
         return true;
     } else if (event->type() == (QEvent::Type)WorkerLoadEvent::WorkerLoad) {
         WorkerLoadEvent *workerEvent = static_cast<WorkerLoadEvent *>(event);
@@ -209,7 +223,8 @@ QV4::ExecutionEngine *QQuickWorkerScriptEnginePrivate::workerEngine(int id)
     return engine;
 }
 
-void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data,
+                                                     const QList<QByteArray> &transferredBuffers)
 {
     QV4::ExecutionEngine *engine = workerEngine(id);
     if (!engine)
@@ -225,7 +240,8 @@ void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &d
     if (!onmessage)
         return;
 
-    QV4::ScopedValue value(scope, QV4::Serialize::deserialize(data, engine));
+    QV4::ScopedValue value(scope,
+                           QV4::Serialize::deserialize(data, engine, transferredBuffers));
 
     QV4::JSCallArguments jsCallData(scope, 1);
     *jsCallData.thisObject = engine->global();
@@ -290,8 +306,10 @@ void QQuickWorkerScriptEnginePrivate::reportScriptException(WorkerScript *script
         QCoreApplication::postEvent(script->owner, new WorkerErrorEvent(error));
 }
 
-WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data)
-: QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data)
+WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data,
+                                 const QList<QByteArray> &transferredBuffers)
+: QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data),
+  m_transferredBuffers(transferredBuffers)
 {
 }
 
@@ -309,6 +327,11 @@ QByteArray WorkerDataEvent::data() const
     return m_data;
 }
 
+QList<QByteArray> WorkerDataEvent::transferredBuffers() const
+{
+    return m_transferredBuffers;
+}
+
 WorkerLoadEvent::WorkerLoadEvent(int workerId, const QUrl &url)
 : QEvent((QEvent::Type)WorkerLoad), m_id(workerId), m_url(url)
 {
@@ -344,12 +367,12 @@ QQmlError WorkerErrorEvent::error() const
     return m_error;
 }
 
-QQuickWorkerScriptEngine::QQuickWorkerScriptEngine(QQmlEngine *parent)
+QQuickWorkerScriptEngine::QQuickWorkerScriptEngine(QQmlEngine *parent, QThread::Priority priority)
 : QThread(parent), d(new QQuickWorkerScriptEnginePrivate(parent))
 {
     d->m_lock.lock();
     connect(d, SIGNAL(stopThread()), this, SLOT(quit()), Qt::DirectConnection);
-    start(QThread::LowestPriority);
+    start(priority);
     d->m_wait.wait(&d->m_lock);
     d->moveToThread(this);
     d->m_lock.unlock();
@@ -412,6 +435,7 @@ int QQuickWorkerScriptEngine::registerWorkerScript(QQuickWorkerScript *owner)
     d->workers.insert(id, owner);
     d->m_lock.unlock();
 
+    ++m_workerCount;
     return id;
 }
 
@@ -425,6 +449,9 @@ void QQuickWorkerScriptEngine::removeWorkerScript(int id)
         QV4::ExecutionEngine *engine = it->asT1();
         workerScriptExtension(engine)->owner = nullptr;
     }
+    --m_workerCount;
+    if (m_workerPriorities.remove(id))
+        updatePriority();
     QCoreApplication::postEvent(d, new WorkerRemoveEvent(id));
 }
 
@@ -433,9 +460,84 @@ void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
     QCoreApplication::postEvent(d, new WorkerLoadEvent(id, url));
 }
 
-void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data,
+                                           const QList<QByteArray> &transferredBuffers)
+{
+    QCoreApplication::postEvent(d, new WorkerDataEvent(id, data, transferredBuffers));
+}
+
+static int maxPoolThreads()
+{
+    static const int max = []() {
+        bool ok = false;
+        const int value = qEnvironmentVariableIntValue("QT_QML_WORKERSCRIPT_MAX_THREADS", &ok);
+        return ok ? qMax(0, value) : QThread::idealThreadCount();
+    }();
+    return max;
+}
+
+/*!
+    \internal
+
+    Returns the thread that runs workers of \a group, starting one with
+    \a priority if needed. The priority of an existing thread is only
+    adjusted by setWorkerPriority() once the worker is registered. An empty \a group asks for a thread of its own.
+    Once QT_QML_WORKERSCRIPT_MAX_THREADS (by default the ideal thread count)
+    pool threads exist, the one with the fewest workers is shared instead.
+    Must be called on the engine shared by the ungrouped workers.
+*/
+QQuickWorkerScriptEngine *QQuickWorkerScriptEngine::poolEngine(const QString &group,
+                                                               QThread::Priority priority)
+{
+    if (!group.isEmpty()) {
+        if (QQuickWorkerScriptEngine *engine = m_groups.value(group))
+            return engine;
+    }
+
+    QQuickWorkerScriptEngine *engine = nullptr;
+    if (m_pool.size() < maxPoolThreads()) {
+        engine = new QQuickWorkerScriptEngine(d->qmlengine, priority);
+        m_pool.append(engine);
+    } else if (!m_pool.isEmpty()) {
+        engine = *std::min_element(m_pool.cbegin(), m_pool.cend(),
+                                   [](QQuickWorkerScriptEngine *a, QQuickWorkerScriptEngine *b) {
+            return a->m_workerCount < b->m_workerCount;
+        });
+    } else {
+        return this;
+    }
+
+    if (!group.isEmpty())
+        m_groups.insert(group, engine);
+    return engine;
+}
+
+/*!
+    \internal
+
+    Records that the worker \a id asks for \a priority. A pool thread runs at
+    the highest priority any of its workers asks for, so that one worker
+    cannot lower the priority another worker on the same thread relies on.
+*/
+void QQuickWorkerScriptEngine::setWorkerPriority(int id, QThread::Priority priority)
+{
+    if (priority == QThread::InheritPriority)
+        m_workerPriorities.remove(id);
+    else
+        m_workerPriorities.insert(id, priority);
+    updatePriority();
+}
+
+void QQuickWorkerScriptEngine::updatePriority()
 {
-    QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
+    if (m_workerPriorities.isEmpty())
+        return;
+
+    // InheritPriority is never stored, so the enum order is the priority order.
+    const QThread::Priority highest = *std::max_element(m_workerPriorities.cbegin(),
+                                                        m_workerPriorities.cend());
+    if (highest != priority())
+        setPriority(highest);
 }
 
 void QQuickWorkerScriptEngine::run()
@@ -494,6 +596,11 @@ void QQuickWorkerScriptEngine::run()
     isolation and thread-safety. If the impact of that results in a memory consumption that is too
     high for your environment, then consider sharing a WorkerScript element.
 
+    By default all WorkerScript elements of a QML engine run on one shared
+    thread, so a long running handler delays the messages of every other
+    worker. Setting \l group or \l priority moves a worker onto a thread pool
+    instead; see those properties for details.
+
     \section3 Restrictions
 
     Since the \c WorkerScript.onMessage() function is run in a separate thread, the
@@ -564,7 +671,89 @@ bool QQuickWorkerScript::ready() const
 }
 
 /*!
-    \qmlmethod WorkerScript::sendMessage(jsobject message)
+    \qmlproperty string WorkerScript::group
+    \since 6.6
+
+    This holds the name of the thread group the worker runs in.
+
+    Workers with the same non-empty group share one thread of the worker
+    thread pool, while workers of different groups run in parallel. The pool
+    starts at most as many threads as the system has cores, or as given by the
+    \c QT_QML_WORKERSCRIPT_MAX_THREADS environment variable; beyond that the
+    least busy thread is shared.
+
+    By default the group is empty and the worker runs on the thread shared by
+    all ungrouped workers, unless a \l priority is set.
+
+    The group is only taken into account when the worker is established.
+*/
+QString QQuickWorkerScript::group() const
+{
+    return m_group;
+}
+
+void QQuickWorkerScript::setGroup(const QString &group)
+{
+    if (m_group == group)
+        return;
+
+    if (m_engine)
+        qmlWarning(this) << "Changing the group of an established WorkerScript has no effect";
+
+    m_group = group;
+    emit groupChanged();
+}
+
+/*!
+    \qmlproperty enumeration WorkerScript::priority
+    \since 6.6
+
+    This holds the priority of the thread the worker runs on.
+
+    \value WorkerScript.IdlePriority
+    \value WorkerScript.LowestPriority (default)
+    \value WorkerScript.LowPriority
+    \value WorkerScript.NormalPriority
+    \value WorkerScript.HighPriority
+    \value WorkerScript.HighestPriority
+    \value WorkerScript.TimeCriticalPriority
+    \value WorkerScript.InheritPriority
+
+    A worker with a priority other than the default and no \l group gets a
+    pool thread of its own. When workers sharing a pool thread ask for
+    different priorities, the thread runs at the highest of them, also after
+    the priority of an established worker changes. The priority of the thread
+    shared by ungrouped workers is never changed.
+
+    \c WorkerScript.InheritPriority can only be set before the worker is
+    established.
+
+    \sa QThread::Priority
+*/
+QQuickWorkerScript::Priority QQuickWorkerScript::priority() const
+{
+    return m_priority;
+}
+
+void QQuickWorkerScript::setPriority(Priority priority)
+{
+    if (m_priority == priority)
+        return;
+
+    if (m_engine && priority == InheritPriority) {
+        qmlWarning(this) << "Cannot inherit the priority of an established WorkerScript";
+        return;
+    }
+
+    m_priority = priority;
+    if (m_engine && m_engine != QQmlEnginePrivate::get(qmlEngine(this))->workerScriptEngine)
+        m_engine->setWorkerPriority(m_scriptId, QThread::Priority(priority));
+
+    emit priorityChanged();
+}
+
+/*!
+    \qmlmethod WorkerScript::sendMessage(jsobject message, list transfer)
 
     Sends the given \a message to a worker script handler in another
     thread. The other worker script handler can receive this message
@@ -576,12 +765,23 @@ bool QQuickWorkerScript::ready() const
     \list
     \li boolean, number, string
     \li JavaScript objects and arrays
+    \li ArrayBuffer and typed array objects
     \li ListModel objects (any other type of QObject* is not allowed)
     \endlist
 
     All objects and arrays are copied to the \c message. With the exception
     of ListModel objects, any modifications by the other thread to an object
     passed in \c message will not be reflected in the original object.
+
+    Since Qt 6.6, the optional \a transfer array can list ArrayBuffer objects
+    whose storage is moved to the other thread instead of being copied. After
+    the call these buffers, and any typed arrays viewing them, are detached
+    and have a length of zero in the sending thread. The same applies to
+    \c WorkerScript.sendMessage() in the worker script:
+
+    \code
+    worker.sendMessage({ samples: samples }, [ samples.buffer ])
+    \endcode
 */
 void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
 {
@@ -594,8 +794,17 @@ void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
     QV4::ScopedValue argument(scope, QV4::Value::undefinedValue());
     if (args->length() != 0)
         argument = (*args)[0];
+    QV4::ScopedValue transfer(scope, QV4::Value::undefinedValue());
+    if (args->length() > 1)
+        transfer = (*args)[1];
+
+    QList<QByteArray> transferredBuffers;
+    const QByteArray data = QV4::Serialize::serialize(argument, transfer, scope.engine,
+                                                      &transferredBuffers);
+    if (scope.hasException())
+        return;
 
-    m_engine->sendMessage(m_scriptId, QV4::Serialize::serialize(argument, scope.engine));
+    m_engine->sendMessage(m_scriptId, data, transferredBuffers);
 }
 
 void QQuickWorkerScript::classBegin()
@@ -619,7 +828,11 @@ QQuickWorkerScriptEngine *QQuickWorkerScript::engine()
             enginePrivate->workerScriptEngine = new QQuickWorkerScriptEngine(engine);
         m_engine = qobject_cast<QQuickWorkerScriptEngine *>(enginePrivate->workerScriptEngine);
         Q_ASSERT(m_engine);
+        if (!m_group.isEmpty() || m_priority != LowestPriority)
+            m_engine = m_engine->poolEngine(m_group, QThread::Priority(m_priority));
         m_scriptId = m_engine->registerWorkerScript(this);
+        if (m_engine != enginePrivate->workerScriptEngine)
+            m_engine->setWorkerPriority(m_scriptId, QThread::Priority(m_priority));
 
         if (m_source.isValid())
             m_engine->executeUrl(m_scriptId, context->resolvedUrl(m_source));
@@ -651,7 +864,8 @@ bool QQuickWorkerScript::event(QEvent *event)
             QV4::ExecutionEngine *v4 = engine->handle();
             WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
             emit message(QJSValuePrivate::fromReturnedValue(
-                             QV4::Serialize::deserialize(workerEvent->data(), v4)));
+                             QV4::Serialize::deserialize(workerEvent->data(), v4,
+                                                         workerEvent->transferredBuffers())));
         }
         return true;
     } else if (event->type() == (QEvent::Type)WorkerErrorEvent::WorkerError) {
@@ -22,6 +22,8 @@
 #include <QtCore/qthread.h>
 #include <QtQml/qjsvalue.h>
 #include <QtCore/qurl.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -32,19 +34,32 @@ class QQuickWorkerScriptEngine : public QThread
 {
 Q_OBJECT
 public:
-    QQuickWorkerScriptEngine(QQmlEngine *parent = nullptr);
+    QQuickWorkerScriptEngine(QQmlEngine *parent = nullptr,
+                             QThread::Priority priority = QThread::LowestPriority);
     ~QQuickWorkerScriptEngine();
 
     int registerWorkerScript(QQuickWorkerScript *);
     void removeWorkerScript(int);
     void executeUrl(int, const QUrl &);
-    void sendMessage(int, const QByteArray &);
+    void sendMessage(int, const QByteArray &, const QList<QByteArray> &transferredBuffers = {});
+
+    QQuickWorkerScriptEngine *poolEngine(const QString &group, QThread::Priority priority);
+    void setWorkerPriority(int id, QThread::Priority priority);
 
 protected:
     void run() override;
 
 private:
+    void updatePriority();
+
     QQuickWorkerScriptEnginePrivate *d;
+
+    // Only used on the engine shared by all ungrouped workers. The pool
+    // threads are owned by the QQmlEngine, like the shared one.
+    QList<QQuickWorkerScriptEngine *> m_pool;
+    QHash<QString, QQuickWorkerScriptEngine *> m_groups;
+    QHash<int, QThread::Priority> m_workerPriorities;
+    int m_workerCount = 0;
 };
 
 class QQmlV4Function;
@@ -54,12 +69,26 @@ class Q_QMLWORKERSCRIPT_PRIVATE_EXPORT QQuickWorkerScript : public QObject, publ
     Q_DISABLE_COPY_MOVE(QQuickWorkerScript)
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged)
     Q_PROPERTY(bool ready READ ready NOTIFY readyChanged REVISION(2, 15))
+    Q_PROPERTY(QString group READ group WRITE setGroup NOTIFY groupChanged REVISION(6, 6))
+    Q_PROPERTY(Priority priority READ priority WRITE setPriority NOTIFY priorityChanged REVISION(6, 6))
 
     QML_NAMED_ELEMENT(WorkerScript);
     QML_ADDED_IN_VERSION(2, 0)
 
     Q_INTERFACES(QQmlParserStatus)
 public:
+    enum Priority {
+        IdlePriority = QThread::IdlePriority,
+        LowestPriority = QThread::LowestPriority,
+        LowPriority = QThread::LowPriority,
+        NormalPriority = QThread::NormalPriority,
+        HighPriority = QThread::HighPriority,
+        HighestPriority = QThread::HighestPriority,
+        TimeCriticalPriority = QThread::TimeCriticalPriority,
+        InheritPriority = QThread::InheritPriority
+    };
+    Q_ENUM(Priority)
+
     QQuickWorkerScript(QObject *parent = nullptr);
     ~QQuickWorkerScript();
 
@@ -68,12 +97,20 @@ public:
 
     bool ready() const;
 
+    QString group() const;
+    void setGroup(const QString &);
+
+    Priority priority() const;
+    void setPriority(Priority);
+
 public Q_SLOTS:
     void sendMessage(QQmlV4Function*);
 
 Q_SIGNALS:
     void sourceChanged();
     Q_REVISION(2, 15) void readyChanged();
+    Q_REVISION(6, 6) void groupChanged();
+    Q_REVISION(6, 6) void priorityChanged();
     void message(const QJSValue &messageObject);
 
 protected:
@@ -86,6 +123,8 @@ private:
     QQuickWorkerScriptEngine *m_engine;
     int m_scriptId;
     QUrl m_source;
+    QString m_group;
+    Priority m_priority = LowestPriority;
     bool m_componentComplete;
 };
 
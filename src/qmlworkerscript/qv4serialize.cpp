@@ -9,6 +9,10 @@
 #include <private/qv4sequenceobject_p.h>
 #include <private/qv4objectproto_p.h>
 #include <private/qv4qobjectwrapper_p.h>
+#include <private/qv4arraybuffer_p.h>
+#include <private/qv4typedarray_p.h>
+
+#include <QtCore/qhash.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -26,7 +30,16 @@ using namespace QV4;
 //    + Number
 //    + Date
 //    + RegExp
+//    + ArrayBuffer
+//    + TypedArray
 // <quint8 type><quint24 size><data>
+//
+// ArrayBuffers are copied, unless they are listed in the transfer list. The
+// storage of a transferred buffer travels next to the data, in the list of
+// transferred buffers, and the buffer is detached in the sending engine. Each
+// buffer is serialized once; further references to it, for example from typed
+// arrays viewing it, refer back to the first one so that they share the
+// buffer again after deserialization.
 
 enum Type {
     WorkerUndefined,
@@ -44,7 +57,30 @@ enum Type {
     WorkerRegexp,
     WorkerListModel,
     WorkerUrl,
-    WorkerSequence
+    WorkerSequence,
+    WorkerArrayBuffer,
+    WorkerTransferredArrayBuffer,
+    WorkerArrayBufferReference,
+    WorkerTypedArray
+};
+
+struct Serialize::SerializeState
+{
+    QList<const Heap::ArrayBuffer *> transfer;
+    QList<QByteArray> *transferredBuffers = nullptr;
+    // The ArrayBuffers serialized so far, by the order they were serialized in.
+    QHash<const Heap::ArrayBuffer *, quint32> buffers;
+};
+
+struct Serialize::DeserializeState
+{
+    DeserializeState(Scope &scope, const QList<QByteArray> &transferredBuffers)
+        : transferredBuffers(transferredBuffers), buffers(scope, scope.engine->newArrayObject())
+    {}
+
+    const QList<QByteArray> &transferredBuffers;
+    // The ArrayBuffers deserialized so far, by the order they were serialized in.
+    ScopedArrayObject buffers;
 };
 
 static inline quint32 valueheader(Type type, quint32 size = 0)
@@ -126,7 +162,8 @@ static inline void serializeString(QByteArray &data, const QString &str, Type ty
 // XXX TODO: Check that worker script is exception safe in the case of
 // serialization/deserialization failures
 
-void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine)
+void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine,
+                          SerializeState &state)
 {
     QV4::Scope scope(engine);
 
@@ -154,7 +191,7 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         push(data, valueheader(WorkerArray, length));
         ScopedValue val(scope);
         for (uint ii = 0; ii < length; ++ii)
-            serialize(data, (val = array->get(ii)), engine);
+            serialize(data, (val = array->get(ii)), engine, state);
     } else if (v.isInteger()) {
         reserve(data, 2 * sizeof(quint32));
         push(data, valueheader(WorkerInt32));
@@ -190,6 +227,38 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         char *buffer = data.data() + offset;
 
         memcpy(buffer, pattern.constData(), length*sizeof(QChar));
+    } else if (const ArrayBuffer *buffer = v.as<ArrayBuffer>()) {
+        const auto seen = state.buffers.constFind(buffer->d());
+        if (seen != state.buffers.cend()) {
+            push(data, valueheader(WorkerArrayBufferReference, *seen));
+            return;
+        }
+        state.buffers.insert(buffer->d(), quint32(state.buffers.size()));
+
+        if (state.transfer.contains(buffer->d())) {
+            // The caller detaches the buffer once the whole message is serialized.
+            push(data, valueheader(WorkerTransferredArrayBuffer,
+                                   quint32(state.transferredBuffers->size())));
+            state.transferredBuffers->append(buffer->sharedByteArray());
+            return;
+        }
+
+        const quint32 length = buffer->arrayDataLength();
+        reserve(data, 2 * sizeof(quint32) + ALIGN(length));
+        push(data, valueheader(WorkerArrayBuffer));
+        push(data, length);
+
+        int offset = data.size();
+        data.resize(data.size() + ALIGN(length));
+        if (length)
+            memcpy(data.data() + offset, buffer->constArrayData(), length);
+    } else if (const TypedArray *typedArray = v.as<TypedArray>()) {
+        reserve(data, 3 * sizeof(quint32));
+        push(data, valueheader(WorkerTypedArray, typedArray->arrayType()));
+        push(data, quint32(typedArray->byteOffset()));
+        push(data, quint32(typedArray->byteLength()));
+        ScopedValue arrayBuffer(scope, typedArray->d()->buffer);
+        serialize(data, arrayBuffer, engine, state);
     } else if (const QObjectWrapper *qobjectWrapper = v.as<QV4::QObjectWrapper>()) {
         // XXX TODO: Generalize passing objects between the main thread and worker scripts so
         // that others can trivially plug in their elements.
@@ -217,11 +286,12 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
 
         // sequence type
         serialize(data, QV4::Value::fromInt32(
-                                QV4::SequencePrototype::metaTypeForSequence(s).id()), engine);
+                                QV4::SequencePrototype::metaTypeForSequence(s).id()), engine,
+                  state);
 
         ScopedValue val(scope);
         for (uint ii = 0; ii < seqLength; ++ii)
-            serialize(data, (val = s->get(ii)), engine); // sequence elements
+            serialize(data, (val = s->get(ii)), engine, state); // sequence elements
 
         return;
     } else if (const Object *o = v.as<Object>()) {
@@ -245,14 +315,14 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         QV4::ScopedValue s(scope);
         for (quint32 ii = 0; ii < length; ++ii) {
             s = properties->get(ii);
-            serialize(data, s, engine);
+            serialize(data, s, engine, state);
 
             QV4::String *str = s->as<String>();
             val = o->get(str);
             if (scope.hasException())
                 scope.engine->catchException();
 
-            serialize(data, val, engine);
+            serialize(data, val, engine, state);
         }
         return;
     } else {
@@ -295,7 +365,8 @@ Q_DECLARE_METATYPE(VariantRef)
 Q_DECLARE_METATYPE(QV4::ExecutionEngine *)
 QT_BEGIN_NAMESPACE
 
-ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
+ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine,
+                                     DeserializeState &state)
 {
     quint32 header = popUint32(data);
     Type type = headertype(header);
@@ -330,7 +401,7 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         ScopedArrayObject a(scope, engine->newArrayObject());
         ScopedValue v(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            v = deserialize(data, engine);
+            v = deserialize(data, engine, state);
             a->put(ii, v);
         }
         return a.asReturnedValue();
@@ -343,8 +414,8 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         ScopedString n(scope);
         ScopedValue value(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            name = deserialize(data, engine);
-            value = deserialize(data, engine);
+            name = deserialize(data, engine, state);
+            value = deserialize(data, engine, state);
             n = name->asReturnedValue();
             o->put(n, value);
         }
@@ -381,17 +452,51 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         agent->setProperty("engine", QVariant::fromValue(engine));
         return rv->asReturnedValue();
     }
+    case WorkerArrayBuffer:
+    {
+        quint32 length = popUint32(data);
+        const QByteArray array(data, length);
+        data += ALIGN(length);
+        ScopedValue buffer(scope, engine->newArrayBuffer(array));
+        state.buffers->push_back(buffer);
+        return buffer->asReturnedValue();
+    }
+    case WorkerTransferredArrayBuffer:
+    {
+        ScopedValue buffer(scope, engine->newArrayBuffer(
+                                          state.transferredBuffers.value(headersize(header))));
+        state.buffers->push_back(buffer);
+        return buffer->asReturnedValue();
+    }
+    case WorkerArrayBufferReference:
+        return state.buffers->get(headersize(header));
+    case WorkerTypedArray:
+    {
+        const auto arrayType = Heap::TypedArray::Type(headersize(header));
+        quint32 byteOffset = popUint32(data);
+        quint32 byteLength = popUint32(data);
+        Scoped<ArrayBuffer> buffer(scope, deserialize(data, engine, state));
+        if (!buffer || arrayType >= NTypedArrayTypes
+                || byteOffset + quint64(byteLength) > buffer->arrayDataLength()) {
+            return QV4::Encode::undefined();
+        }
+        Scoped<TypedArray> array(scope, TypedArray::create(engine, arrayType));
+        array->d()->buffer.set(engine, buffer->d());
+        array->d()->byteOffset = byteOffset;
+        array->d()->byteLength = byteLength;
+        return array.asReturnedValue();
+    }
     case WorkerSequence:
     {
         ScopedValue value(scope);
         quint32 length = headersize(header);
         quint32 seqLength = length - 1;
-        value = deserialize(data, engine);
+        value = deserialize(data, engine, state);
         int sequenceType = value->integerValue();
         ScopedArrayObject array(scope, engine->newArrayObject());
         array->arrayReserve(seqLength);
         for (quint32 ii = 0; ii < seqLength; ++ii) {
-            value = deserialize(data, engine);
+            value = deserialize(data, engine, state);
             array->arrayPut(ii, value);
         }
         array->setArrayLengthUnchecked(seqLength);
@@ -406,14 +511,63 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
 QByteArray Serialize::serialize(const QV4::Value &value, ExecutionEngine *engine)
 {
     QByteArray rv;
-    serialize(rv, value, engine);
+    SerializeState state;
+    serialize(rv, value, engine, state);
     return rv;
 }
 
-ReturnedValue Serialize::deserialize(const QByteArray &data, ExecutionEngine *engine)
+// Serializes \a value, handing over the storage of the ArrayBuffers in the \a transfer
+// array through \a transferredBuffers instead of copying it. The transferred buffers are
+// detached afterwards. Throws a TypeError and returns an empty array if \a transfer is not
+// an array of distinct, attached ArrayBuffers.
+QByteArray Serialize::serialize(const QV4::Value &value, const QV4::Value &transfer,
+                                ExecutionEngine *engine, QList<QByteArray> *transferredBuffers)
 {
+    Q_ASSERT(transferredBuffers);
+    if (transfer.isNullOrUndefined())
+        return serialize(value, engine);
+
+    Scope scope(engine);
+    ScopedArrayObject transferArray(scope, transfer);
+    if (!transferArray) {
+        engine->throwTypeError(QStringLiteral("sendMessage: transfer list must be an array"));
+        return QByteArray();
+    }
+
+    SerializeState state;
+    state.transferredBuffers = transferredBuffers;
+    const uint length = transferArray->getLength();
+    state.transfer.reserve(length);
+    Scoped<ArrayBuffer> buffer(scope);
+    for (uint ii = 0; ii < length; ++ii) {
+        buffer = transferArray->get(ii);
+        if (!buffer || buffer->hasDetachedArrayData() || state.transfer.contains(buffer->d())) {
+            engine->throwTypeError(QStringLiteral(
+                    "sendMessage: transfer list must only contain distinct, attached ArrayBuffers"));
+            return QByteArray();
+        }
+        state.transfer.append(buffer->d());
+    }
+
+    QByteArray rv;
+    serialize(rv, value, engine, state);
+
+    // The transfer array keeps the buffers alive. Buffers listed but not referenced
+    // by the message are detached all the same.
+    for (uint ii = 0; ii < length; ++ii) {
+        buffer = transferArray->get(ii);
+        buffer->detachArrayData();
+    }
+    return rv;
+}
+
+ReturnedValue Serialize::deserialize(const QByteArray &data, ExecutionEngine *engine,
+                                     const QList<QByteArray> &transferredBuffers)
+{
+    Scope scope(engine);
+    DeserializeState state(scope, transferredBuffers);
     const char *stream = data.constData();
-    return deserialize(stream, engine);
+    return deserialize(stream, engine, state);
 }
 
 QT_END_NAMESPACE
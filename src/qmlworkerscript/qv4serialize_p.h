@@ -16,21 +16,32 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
 #include <private/qv4value_p.h>
 
 QT_BEGIN_NAMESPACE
 
 namespace QV4 {
 
+namespace Heap {
+struct ArrayBuffer;
+}
+
 class Serialize {
 public:
 
     static QByteArray serialize(const Value &, ExecutionEngine *);
-    static ReturnedValue deserialize(const QByteArray &, ExecutionEngine *);
+    static QByteArray serialize(const Value &, const Value &transfer, ExecutionEngine *,
+                                QList<QByteArray> *transferredBuffers);
+    static ReturnedValue deserialize(const QByteArray &, ExecutionEngine *,
+                                     const QList<QByteArray> &transferredBuffers = {});
 
 private:
-    static void serialize(QByteArray &, const Value &, ExecutionEngine *);
-    static ReturnedValue deserialize(const char *&, ExecutionEngine *);
+    struct SerializeState;
+    struct DeserializeState;
+
+    static void serialize(QByteArray &, const Value &, ExecutionEngine *, SerializeState &);
+    static ReturnedValue deserialize(const char *&, ExecutionEngine *, DeserializeState &);
 };
 
 }
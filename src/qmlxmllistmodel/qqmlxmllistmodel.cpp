@@ -11,9 +11,15 @@
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfuturewatcher.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qtimer.h>
+#include <QtCore/qwaitcondition.h>
 #include <QtCore/qxmlstream.h>
 
+#include <functional>
+
 #if QT_CONFIG(qml_network)
 #include <QtNetwork/qnetworkreply.h>
 #include <QtNetwork/qnetworkrequest.h>
@@ -23,6 +29,118 @@ Q_DECLARE_METATYPE(QQmlXmlListModelQueryResult)
 
 QT_BEGIN_NAMESPACE
 
+/*
+    A sequential device that hands the data of a network reply over to the
+    query runnable while it is still arriving. Reads block until more data is
+    appended, or until the feed is finished or canceled.
+
+    The data is kept as a queue of the chunks it arrived in, so that reading
+    never has to move what is left. At most MaxBufferSize bytes are meant to
+    be buffered: the model stops reading the reply when room() reaches 0, and
+    the resume handler is called from the reading thread once the parser has
+    consumed half of the buffer again.
+*/
+class QQmlXmlListModelFeed : public QIODevice
+{
+public:
+    static constexpr qsizetype MaxBufferSize = 256 * 1024;
+
+    QQmlXmlListModelFeed() { open(QIODevice::ReadOnly | QIODevice::Unbuffered); }
+
+    void setResumeHandler(std::function<void()> handler)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_resumeHandler = std::move(handler);
+    }
+
+    qsizetype room() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return qMax(MaxBufferSize - m_buffered, qsizetype(0));
+    }
+
+    void append(const QByteArray &data)
+    {
+        if (data.isEmpty())
+            return;
+        QMutexLocker locker(&m_mutex);
+        m_chunks.enqueue(data);
+        m_buffered += data.size();
+        if (m_buffered >= MaxBufferSize)
+            m_waitingForRoom = true;
+        m_condition.wakeAll();
+    }
+
+    void finish()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_finished = true;
+        m_resumeHandler = nullptr;
+        m_condition.wakeAll();
+    }
+
+    void cancel()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_chunks.clear();
+        m_offset = 0;
+        m_buffered = 0;
+        m_finished = true;
+        m_resumeHandler = nullptr;
+        m_condition.wakeAll();
+    }
+
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        QMutexLocker locker(&m_mutex);
+        while (m_chunks.isEmpty() && !m_finished)
+            m_condition.wait(&m_mutex);
+
+        qint64 size = 0;
+        while (size < maxSize && !m_chunks.isEmpty()) {
+            const QByteArray &chunk = m_chunks.head();
+            const qint64 n = qMin(maxSize - size, qint64(chunk.size() - m_offset));
+            memcpy(data + size, chunk.constData() + m_offset, n);
+            size += n;
+            m_offset += n;
+            if (m_offset == chunk.size()) {
+                m_chunks.dequeue();
+                m_offset = 0;
+            }
+        }
+        m_buffered -= size;
+
+        // The handler only posts to the model's thread, so it is fine to call it
+        // while locked. Doing so keeps cancel() from returning while it runs.
+        if (m_waitingForRoom && m_buffered <= MaxBufferSize / 2) {
+            m_waitingForRoom = false;
+            if (m_resumeHandler)
+                m_resumeHandler();
+        }
+        return size;
+    }
+
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    mutable QMutex m_mutex;
+    QWaitCondition m_condition;
+    QQueue<QByteArray> m_chunks;
+    qsizetype m_offset = 0; // into m_chunks.head()
+    qsizetype m_buffered = 0;
+    std::function<void()> m_resumeHandler;
+    bool m_waitingForRoom = false;
+    bool m_finished = false;
+};
+
+// A query that reads from a feed keeps its thread blocked until the whole
+// document has been downloaded. Those queries get a pool of their own, so
+// that a slow download cannot starve QThreadPool::globalInstance().
+Q_GLOBAL_STATIC(QThreadPool, feedQueryThreadPool)
+
 /*!
     \qmlmodule QtQml.XmlListModel
     \title Qt XmlListModel QML Types
@@ -333,13 +451,15 @@ bool QQmlXmlListModelRole::isValid() const
     The \l XmlListModel data is loaded asynchronously, and \l status
     is set to \c XmlListModel.Ready when loading is complete.
     Note this means when \l XmlListModel is used for a view, the view is not
-    populated until the model is loaded.
+    populated until the model is loaded, unless \l chunkSize is set.
 */
 
 QQmlXmlListModel::QQmlXmlListModel(QObject *parent) : QAbstractListModel(parent) { }
 
 QQmlXmlListModel::~QQmlXmlListModel()
 {
+    // A streaming query could otherwise wait for data forever
+    cancelFeed();
     // Cancel all objects
     for (auto &w : m_watchers.values())
         w->cancel();
@@ -433,6 +553,38 @@ void QQmlXmlListModel::setQuery(const QString &query)
     }
 }
 
+/*!
+    \qmlproperty int QtQml.XmlListModel::XmlListModel::chunkSize
+    \since 6.6
+
+    The number of model items that are added at a time while the XML data is
+    parsed. By default this is \c 0, and all items are added at once when
+    parsing is complete.
+
+    When set, the model streams the data: items are added in chunks of this
+    size while the rest of the data is still being parsed, and \l status stays
+    \c XmlListModel.Loading until the last chunk is added. Local files are read
+    block by block and network replies are parsed while they are downloaded,
+    so that neither is held in memory as a whole. The items of the previous
+    query are removed when the first chunk arrives.
+
+    Changing the chunk size takes effect the next time the model is loaded.
+*/
+int QQmlXmlListModel::chunkSize() const
+{
+    return m_chunkSize;
+}
+
+void QQmlXmlListModel::setChunkSize(int chunkSize)
+{
+    chunkSize = qMax(0, chunkSize);
+    if (m_chunkSize == chunkSize)
+        return;
+
+    m_chunkSize = chunkSize;
+    Q_EMIT chunkSizeChanged();
+}
+
 /*!
     \qmlproperty list<XmlListModelRole> QtQml.XmlListModel::XmlListModel::roles
 
@@ -488,8 +640,13 @@ void QQmlXmlListModel::clearRole(QQmlListProperty<QQmlXmlListModelRole> *list)
 
 void QQmlXmlListModel::tryExecuteQuery(const QByteArray &data)
 {
-    auto job = createJob(data);
+    tryExecuteQuery(createJob(data));
+}
+
+void QQmlXmlListModel::tryExecuteQuery(QQmlXmlListModelQueryJob &&job)
+{
     m_queryId = job.queryId;
+    QThreadPool *pool = job.feed ? feedQueryThreadPool() : QThreadPool::globalInstance();
     QQmlXmlListModelQueryRunnable *runnable = new QQmlXmlListModelQueryRunnable(std::move(job));
     if (runnable) {
         auto future = runnable->future();
@@ -515,7 +672,7 @@ void QQmlXmlListModel::tryExecuteQuery(const QByteArray &data)
         });
         m_watchers[m_queryId] = watcher;
         watcher->setFuture(future);
-        QThreadPool::globalInstance()->start(runnable);
+        pool->start(runnable);
     } else {
         m_errorString = tr("Failed to create an instance of QRunnable query object");
         m_status = QQmlXmlListModel::Error;
@@ -529,6 +686,8 @@ QQmlXmlListModelQueryJob QQmlXmlListModel::createJob(const QByteArray &data)
     QQmlXmlListModelQueryJob job;
     job.queryId = nextQueryId();
     job.data = data;
+    job.receiver = this;
+    job.chunkSize = m_chunkSize;
     job.query = m_query;
 
     for (int i = 0; i < m_roleObjects.size(); i++) {
@@ -629,8 +788,10 @@ void QQmlXmlListModel::reload()
 
     if (m_queryId > 0 && m_watchers.contains(m_queryId))
         m_watchers[m_queryId]->cancel();
+    cancelFeed();
 
     m_queryId = -1;
+    m_streamStarted = false;
 
     if (m_size < 0)
         m_size = 0;
@@ -655,9 +816,15 @@ void QQmlXmlListModel::reload()
         if (!opened)
             qWarning("Failed to open file %s: %s", qPrintable(file.fileName()),
                      qPrintable(file.errorString()));
-        QByteArray data = opened ? file.readAll() : QByteArray();
+        // When streaming, the query runnable reads the file itself, a block at a time
+        const bool stream = opened && m_chunkSize > 0 && file.size() > 0;
+        QByteArray data = opened && !stream ? file.readAll() : QByteArray();
         notifyQueryStarted(false);
-        if (data.isEmpty()) {
+        if (stream) {
+            auto job = createJob(QByteArray());
+            job.fileName = file.fileName();
+            tryExecuteQuery(std::move(job));
+        } else if (data.isEmpty()) {
             m_queryId = 0;
             QTimer::singleShot(0, this, &QQmlXmlListModel::dataCleared);
         } else {
@@ -674,6 +841,21 @@ void QQmlXmlListModel::reload()
                          &QQmlXmlListModel::requestFinished);
         QObject::connect(m_reply, &QNetworkReply::downloadProgress, this,
                          &QQmlXmlListModel::requestProgress);
+
+        if (m_chunkSize > 0) {
+            // Let the network layer stop reading while the parser is behind
+            m_reply->setReadBufferSize(QQmlXmlListModelFeed::MaxBufferSize);
+            m_feed = std::make_shared<QQmlXmlListModelFeed>();
+            m_feed->setResumeHandler([this]() {
+                QMetaObject::invokeMethod(this, &QQmlXmlListModel::requestReadyRead,
+                                          Qt::QueuedConnection);
+            });
+            auto job = createJob(QByteArray());
+            job.feed = m_feed;
+            tryExecuteQuery(std::move(job));
+            QObject::connect(m_reply, &QNetworkReply::readyRead, this,
+                             &QQmlXmlListModel::requestReadyRead);
+        }
 #else
         m_queryId = 0;
         notifyQueryStarted(false);
@@ -702,6 +884,12 @@ void QQmlXmlListModel::requestFinished()
     if (m_reply->error() != QNetworkReply::NoError) {
         m_errorString = m_reply->errorString();
         deleteReply();
+        if (m_feed) {
+            cancelFeed();
+            if (m_queryId > 0 && m_watchers.contains(m_queryId))
+                m_watchers[m_queryId]->cancel();
+            m_streamStarted = false;
+        }
 
         if (m_size > 0) {
             beginRemoveRows(QModelIndex(), 0, m_size - 1);
@@ -714,6 +902,15 @@ void QQmlXmlListModel::requestFinished()
         m_status = Error;
         m_queryId = -1;
         Q_EMIT statusChanged(m_status);
+    } else if (m_feed) {
+        // Whatever is left is limited by the read buffer size of the reply
+        m_feed->append(m_reply->readAll());
+        m_feed->finish();
+        m_feed.reset();
+        deleteReply();
+
+        m_progress = 1.0;
+        Q_EMIT progressChanged(m_progress);
     } else {
         QByteArray data = m_reply->readAll();
         if (data.isEmpty()) {
@@ -729,6 +926,19 @@ void QQmlXmlListModel::requestFinished()
     }
 }
 
+void QQmlXmlListModel::requestReadyRead()
+{
+    // Redirections are followed by reloading, their body is not part of the document
+    if (!m_feed || !m_reply
+            || m_reply->attribute(QNetworkRequest::RedirectionTargetAttribute).isValid()) {
+        return;
+    }
+    // Leave the rest in the reply until the feed asks for more
+    const qsizetype room = m_feed->room();
+    if (room > 0)
+        m_feed->append(m_reply->read(room));
+}
+
 void QQmlXmlListModel::deleteReply()
 {
     if (m_reply) {
@@ -747,6 +957,14 @@ void QQmlXmlListModel::requestProgress(qint64 received, qint64 total)
     }
 }
 
+void QQmlXmlListModel::cancelFeed()
+{
+    if (m_feed) {
+        m_feed->cancel();
+        m_feed.reset();
+    }
+}
+
 void QQmlXmlListModel::dataCleared()
 {
     QQmlXmlListModelQueryResult r;
@@ -781,6 +999,15 @@ void QQmlXmlListModel::queryCompleted(const QQmlXmlListModelQueryResult &result)
     m_errorString.clear();
     m_queryId = -1;
 
+    if (m_streamStarted) {
+        appendRows(result);
+        m_streamStarted = false;
+        if (m_size != origCount)
+            Q_EMIT countChanged();
+        Q_EMIT statusChanged(m_status);
+        return;
+    }
+
     if (origCount > 0) {
         beginRemoveRows(QModelIndex(), 0, origCount - 1);
         endRemoveRows();
@@ -799,6 +1026,42 @@ void QQmlXmlListModel::queryCompleted(const QQmlXmlListModelQueryResult &result)
     Q_EMIT statusChanged(m_status);
 }
 
+void QQmlXmlListModel::queryChunkReady(const QQmlXmlListModelQueryResult &result)
+{
+    if (result.queryId != m_queryId)
+        return;
+
+    for (const auto &errorInfo : result.errors)
+        queryError(errorInfo.first, errorInfo.second);
+
+    const int origCount = m_size;
+    appendRows(result);
+    if (m_size != origCount)
+        Q_EMIT countChanged();
+}
+
+void QQmlXmlListModel::appendRows(const QQmlXmlListModelQueryResult &result)
+{
+    // The first chunk of a streamed query replaces the items of the previous one
+    if (!m_streamStarted) {
+        m_streamStarted = true;
+        if (m_size > 0) {
+            beginRemoveRows(QModelIndex(), 0, m_size - 1);
+            m_data.clear();
+            m_size = 0;
+            endRemoveRows();
+        }
+    }
+
+    if (result.data.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), m_size, m_size + result.data.size() - 1);
+    m_data.append(result.data);
+    m_size = m_data.size();
+    endInsertRows();
+}
+
 void QQmlXmlListModel::notifyQueryStarted(bool remoteSource)
 {
     m_progress = remoteSource ? 0.0 : 1.0;
@@ -847,7 +1110,16 @@ void QQmlXmlListModelQueryRunnable::doQueryJob(QQmlXmlListModelQueryResult *curr
 
     QByteArray data(m_job.data);
     QXmlStreamReader reader;
-    reader.addData(data);
+    QFile file;
+    if (m_job.feed) {
+        reader.setDevice(m_job.feed.get());
+    } else if (!m_job.fileName.isEmpty()) {
+        file.setFileName(m_job.fileName);
+        if (file.open(QIODevice::ReadOnly))
+            reader.setDevice(&file);
+    } else {
+        reader.addData(data);
+    }
 
     QStringList items = m_job.query.split(QLatin1Char('/'), Qt::SkipEmptyParts);
 
@@ -861,6 +1133,8 @@ void QQmlXmlListModelQueryRunnable::doQueryJob(QQmlXmlListModelQueryResult *curr
                         continue;
                     } else {
                         processElement(currentResult, items.at(i), reader);
+                        if (m_job.chunkSize > 0 && currentResult->data.size() >= m_job.chunkSize)
+                            flushChunk(currentResult);
                     }
                 } else {
                     reader.skipCurrentElement();
@@ -877,6 +1151,20 @@ void QQmlXmlListModelQueryRunnable::doQueryJob(QQmlXmlListModelQueryResult *curr
     }
 }
 
+void QQmlXmlListModelQueryRunnable::flushChunk(QQmlXmlListModelQueryResult *currentResult)
+{
+    if (m_promise.isCanceled())
+        return;
+
+    QQmlXmlListModelQueryResult chunk;
+    chunk.queryId = currentResult->queryId;
+    chunk.data.swap(currentResult->data);
+    chunk.errors.swap(currentResult->errors);
+    // The model waits for the query to finish before it is destroyed
+    QMetaObject::invokeMethod(m_job.receiver, "queryChunkReady", Qt::QueuedConnection,
+                              Q_ARG(QQmlXmlListModelQueryResult, chunk));
+}
+
 void QQmlXmlListModelQueryRunnable::processElement(QQmlXmlListModelQueryResult *currentResult,
                                                    const QString &element, QXmlStreamReader &reader)
 {
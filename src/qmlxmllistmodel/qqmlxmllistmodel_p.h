@@ -30,6 +30,8 @@
 #include <QtCore/qstringlist.h>
 #include <QtCore/qurl.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 #if QT_CONFIG(qml_network)
@@ -38,10 +40,17 @@ class QNetworkReply;
 
 class QXmlStreamReader;
 class QQmlContext;
+class QQmlXmlListModelFeed;
 struct QQmlXmlListModelQueryJob
 {
     int queryId;
     QByteArray data;
+    // In streaming mode the document is read from a file or a feed instead of data,
+    // and every chunkSize rows are sent to the receiver as soon as they are parsed.
+    QString fileName;
+    std::shared_ptr<QQmlXmlListModelFeed> feed;
+    QObject *receiver = nullptr;
+    int chunkSize = 0;
     QString query;
     QStringList roleNames;
     QStringList elementNames;
@@ -102,6 +111,8 @@ class Q_QMLXMLLISTMODEL_PRIVATE_EXPORT QQmlXmlListModel : public QAbstractListMo
     Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
     Q_PROPERTY(QQmlListProperty<QQmlXmlListModelRole> roles READ roleObjects)
     Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int chunkSize READ chunkSize WRITE setChunkSize NOTIFY chunkSizeChanged
+               REVISION(6, 6))
     QML_NAMED_ELEMENT(XmlListModel)
     Q_CLASSINFO("DefaultProperty", "roles")
 
@@ -122,6 +133,9 @@ public:
     QString query() const;
     void setQuery(const QString &);
 
+    int chunkSize() const;
+    void setChunkSize(int);
+
     QQmlListProperty<QQmlXmlListModelRole> roleObjects();
 
     void appendRole(QQmlXmlListModelRole *);
@@ -143,6 +157,7 @@ Q_SIGNALS:
     void countChanged();
     void sourceChanged();
     void queryChanged();
+    Q_REVISION(6, 6) void chunkSizeChanged();
 
 public Q_SLOTS:
     void reload();
@@ -150,10 +165,12 @@ public Q_SLOTS:
 private Q_SLOTS:
 #if QT_CONFIG(qml_network)
     void requestFinished();
+    void requestReadyRead();
 #endif
     void requestProgress(qint64, qint64);
     void dataCleared();
     void queryCompleted(const QQmlXmlListModelQueryResult &);
+    void queryChunkReady(const QQmlXmlListModelQueryResult &);
     void queryError(void *object, const QString &error);
 
 private:
@@ -165,6 +182,9 @@ private:
     static void clearRole(QQmlListProperty<QQmlXmlListModelRole> *);
 
     void tryExecuteQuery(const QByteArray &data);
+    void tryExecuteQuery(QQmlXmlListModelQueryJob &&job);
+    void appendRows(const QQmlXmlListModelQueryResult &result);
+    void cancelFeed();
 
     QQmlXmlListModelQueryJob createJob(const QByteArray &data);
     int nextQueryId();
@@ -182,6 +202,9 @@ private:
     QList<int> m_roles;
     QList<QQmlXmlListModelRole *> m_roleObjects;
     QList<QFlatMap<int, QString>> m_data;
+    std::shared_ptr<QQmlXmlListModelFeed> m_feed;
+    int m_chunkSize = 0;
+    bool m_streamStarted = false;
     bool m_isComponentComplete = true;
     Status m_status = QQmlXmlListModel::Null;
     QString m_errorString;
@@ -204,6 +227,7 @@ public:
 
 private:
     void doQueryJob(QQmlXmlListModelQueryResult *currentResult);
+    void flushChunk(QQmlXmlListModelQueryResult *currentResult);
     void processElement(QQmlXmlListModelQueryResult *currentResult, const QString &element,
                         QXmlStreamReader &reader);
     void readSubTree(const QString &prefix, QXmlStreamReader &reader,
@@ -50,6 +50,8 @@ QQuickPointerHandler::~QQuickPointerHandler()
     if (parItem) {
         QQuickItemPrivate *p = QQuickItemPrivate::get(parItem);
         p->extra.value().pointerHandlers.removeOne(this);
+        if (!p->inDestructor)
+            p->invalidatePointerBounds();
     }
 }
 
@@ -83,6 +85,8 @@ void QQuickPointerHandler::setMargin(qreal pointDistanceThreshold)
         return;
 
     d->m_margin = pointDistanceThreshold;
+    if (QQuickItem *par = parentItem())
+        QQuickItemPrivate::get(par)->invalidatePointerBounds();
     emit marginChanged();
 }
 
@@ -36,7 +36,7 @@ static Q_ALWAYS_INLINE qreal readHeight(const QQuickItem *item)
 
 static Q_ALWAYS_INLINE qreal readBaselineOffset(const QQuickItem *item)
 {
-    return QQuickItemPrivate::get(item)->baselineOffset;
+    return QQuickItemPrivate::get(item)->getBaselineOffset();
 }
 
 //TODO: should we cache relationships, so we don't have to check each time (parent-child or sibling)?
@@ -55,6 +55,8 @@ QQuickImageBase::QQuickImageBase(QQuickImageBasePrivate &dd, QQuickItem *parent)
 
 QQuickImageBase::~QQuickImageBase()
 {
+    Q_D(QQuickImageBase);
+    d->unwatchLoadPriority();
 }
 
 QQuickImageBase::Status QQuickImageBase::status() const
@@ -252,6 +254,7 @@ int QQuickImageBase::frameCount() const
 void QQuickImageBase::loadEmptyUrl()
 {
     Q_D(QQuickImageBase);
+    d->unwatchLoadPriority();
     d->pix.clear(this);
     if (d->progress != 0.0) {
         d->progress = 0.0;
@@ -273,6 +276,63 @@ void QQuickImageBase::loadEmptyUrl()
     update(); // .. but double updating should be harmless
 }
 
+static bool isOnScreen(const QQuickItem *item)
+{
+    if (!item->isVisible())
+        return false;
+    for (; item; item = item->parentItem()) {
+        if (QQuickItemPrivate::get(item)->culled)
+            return false;
+    }
+    return true;
+}
+
+/*
+    Images that are not on screen yet, such as the ones in delegates that a view
+    creates for its cacheBuffer, are decoded after the visible ones. While such an
+    image is loading, listen to the changes that can bring it on screen: its own
+    (effective) visibility and parent, and the culling of the ancestors that hide it.
+*/
+void QQuickImageBasePrivate::watchLoadPriority()
+{
+    Q_Q(QQuickImageBase);
+    Q_ASSERT(!watchingLoadPriority);
+    watchingLoadPriority = true;
+    addItemChangeListener(this, QQuickItemPrivate::Visibility | QQuickItemPrivate::Parent
+                                | QQuickItemPrivate::Culled);
+    for (QQuickItem *item = q->parentItem(); item; item = item->parentItem()) {
+        QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+        if (itemPrivate->culled) {
+            itemPrivate->addItemChangeListener(this, QQuickItemPrivate::Culled | QQuickItemPrivate::Destroyed);
+            culledAncestors.append(item);
+        }
+    }
+}
+
+void QQuickImageBasePrivate::unwatchLoadPriority()
+{
+    if (!watchingLoadPriority)
+        return;
+    watchingLoadPriority = false;
+    removeItemChangeListener(this, QQuickItemPrivate::Visibility | QQuickItemPrivate::Parent
+                                   | QQuickItemPrivate::Culled);
+    for (QQuickItem *item : std::as_const(culledAncestors))
+        QQuickItemPrivate::get(item)->removeItemChangeListener(this, QQuickItemPrivate::Culled | QQuickItemPrivate::Destroyed);
+    culledAncestors.clear();
+}
+
+void QQuickImageBasePrivate::updateLoadPriority()
+{
+    Q_Q(QQuickImageBase);
+    unwatchLoadPriority();
+    if (!pix.isLoading())
+        return;
+    if (q->window() && !isOnScreen(q))
+        watchLoadPriority();
+    else
+        pix.setLoadPriority(QQuickPixmap::NormalPriority);
+}
+
 void QQuickImageBase::loadPixmap(const QUrl &url, LoadPixmapOptions loadOptions)
 {
     Q_D(QQuickImageBase);
@@ -332,6 +392,15 @@ void QQuickImageBase::loadPixmap(const QUrl &url, LoadPixmapOptions loadOptions)
 
         d->pix.connectFinished(this, thisRequestFinished);
         d->pix.connectDownloadProgress(this, thisRequestProgress);
+
+        // Decode images that are not on screen after the visible ones, and raise the
+        // priority once the item gets shown while the image is still loading.
+        d->unwatchLoadPriority();
+        if (window() && !isOnScreen(this)) {
+            d->pix.setLoadPriority(QQuickPixmap::LowPriority);
+            d->watchLoadPriority();
+        }
+
         update(); //pixmap may have invalidated texture, updatePaintNode needs to be called before the next repaint
     } else {
         requestFinished();
@@ -353,6 +422,7 @@ void QQuickImageBase::load()
 void QQuickImageBase::requestFinished()
 {
     Q_D(QQuickImageBase);
+    d->unwatchLoadPriority();
 
     if (d->pix.isError()) {
         qmlWarning(this) << d->pix.error();
@@ -18,12 +18,13 @@
 #include "qquickimplicitsizeitem_p_p.h"
 #include "qquickimagebase_p.h"
 
+#include <QtQuick/private/qquickitemchangelistener_p.h>
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
 QT_BEGIN_NAMESPACE
 
 class QNetworkReply;
-class Q_QUICK_PRIVATE_EXPORT QQuickImageBasePrivate : public QQuickImplicitSizeItemPrivate
+class Q_QUICK_PRIVATE_EXPORT QQuickImageBasePrivate : public QQuickImplicitSizeItemPrivate, public QQuickItemChangeListener
 {
     Q_DECLARE_PUBLIC(QQuickImageBase)
 
@@ -38,13 +39,25 @@ public:
         cache(true),
         mirrorHorizontally(false),
         mirrorVertically(false),
-        oldAutoTransform(false)
+        oldAutoTransform(false),
+        watchingLoadPriority(false)
     {
     }
 
     virtual bool updateDevicePixelRatio(qreal targetDevicePixelRatio);
 
+    void watchLoadPriority();
+    void unwatchLoadPriority();
+    void updateLoadPriority();
+
+    void itemVisibilityChanged(QQuickItem *) override { updateLoadPriority(); }
+    void itemCulledChanged(QQuickItem *) override { updateLoadPriority(); }
+    void itemParentChanged(QQuickItem *, QQuickItem *) override { updateLoadPriority(); }
+    void itemDestroyed(QQuickItem *item) override { culledAncestors.removeOne(item); }
+
     QQuickPixmap pix;
+    // culled ancestors watched while the image is loading with low priority
+    QList<QQuickItem *> culledAncestors;
     QQuickImageBase::Status status;
     QUrl url;
     qreal progress;
@@ -61,6 +74,7 @@ public:
     bool mirrorHorizontally: 1;
     bool mirrorVertically : 1;
     bool oldAutoTransform : 1;
+    bool watchingLoadPriority : 1;
 };
 
 QT_END_NAMESPACE
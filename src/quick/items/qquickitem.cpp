@@ -3201,6 +3201,7 @@ QQuickItemPrivate::QQuickItemPrivate()
     , maybeHasSubsceneDeliveryAgent(true)
     , subtreeTransformChangedEnabled(true)
     , inDestructor(false)
+    , pointerBoundsDirty(true)
     , dirtyAttributes(0)
     , nextDirtyItem(nullptr)
     , prevDirtyItem(nullptr)
@@ -4428,7 +4429,12 @@ QQuickAnchorLine QQuickItemPrivate::baseline() const
 qreal QQuickItem::baselineOffset() const
 {
     Q_D(const QQuickItem);
-    return d->baselineOffset;
+    return d->getBaselineOffset();
+}
+
+qreal QQuickItemPrivate::getBaselineOffset() const
+{
+    return baselineOffset;
 }
 
 void QQuickItem::setBaselineOffset(qreal offset)
@@ -6564,6 +6570,10 @@ void QQuickItemPrivate::dirty(DirtyType type)
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged(q);
 
+    if (type & (TransformOrigin | Transform | BasicTransform | Position | Size
+                | ChildrenChanged | Clip | Visible | Window))
+        invalidatePointerBounds();
+
     if (!(dirtyAttributes & type) || (window && !prevDirtyItem)) {
         dirtyAttributes |= type;
         if (window && componentComplete) {
@@ -6591,6 +6601,27 @@ void QQuickItemPrivate::addToDirtyList()
     Q_ASSERT(prevDirtyItem);
 }
 
+/*!
+    \internal
+
+    Marks the pointer hit testing bounds of this item, and of all the
+    ancestors that include them, as out of date. The descendants keep
+    theirs, since those are relative to their own coordinate systems.
+
+    The walk stops at the first ancestor that is already out of date,
+    because its own ancestors have been marked along with it.
+*/
+void QQuickItemPrivate::invalidatePointerBounds()
+{
+    pointerBoundsDirty = true;
+    for (QQuickItem *ancestor = parentItem; ancestor; ancestor = QQuickItemPrivate::get(ancestor)->parentItem) {
+        QQuickItemPrivate *ancestorPrivate = QQuickItemPrivate::get(ancestor);
+        if (ancestorPrivate->pointerBoundsDirty)
+            break;
+        ancestorPrivate->pointerBoundsDirty = true;
+    }
+}
+
 void QQuickItemPrivate::removeFromDirtyList()
 {
     if (prevDirtyItem) {
@@ -6658,6 +6689,9 @@ void QQuickItemPrivate::setCulled(bool cull)
     culled = cull;
     if ((cull && ++extra.value().hideRefCount == 1) || (!cull && --extra.value().hideRefCount == 0))
         dirty(HideReference);
+
+    Q_Q(QQuickItem);
+    notifyChangeListeners(QQuickItemPrivate::Culled, &QQuickItemChangeListener::itemCulledChanged, q);
 }
 
 void QQuickItemPrivate::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &data)
@@ -8485,6 +8519,7 @@ void QQuickItem::setContainmentMask(QObject *mask)
         QQuickItemPrivate *maskPrivate = QQuickItemPrivate::get(quickMask);
         maskPrivate->registerAsContainmentMask(this, true); // telling maskPrivate that "this" is using it as mask
     }
+    d->invalidatePointerBounds();
     emit containmentMaskChanged();
 }
 
@@ -9120,6 +9155,7 @@ void QQuickItemPrivate::addPointerHandler(QQuickPointerHandler *h)
     auto &handlers = extra.value().pointerHandlers;
     if (!handlers.contains(h))
         handlers.prepend(h);
+    invalidatePointerBounds();
     auto &res = extra.value().resourcesList;
     if (!res.contains(h)) {
         res.append(h);
@@ -9135,6 +9171,7 @@ void QQuickItemPrivate::removePointerHandler(QQuickPointerHandler *h)
     Q_Q(QQuickItem);
     auto &handlers = extra.value().pointerHandlers;
     handlers.removeOne(h);
+    invalidatePointerBounds();
     auto &res = extra.value().resourcesList;
     res.removeOne(h);
     QObject::disconnect(h, &QObject::destroyed, q, nullptr);
@@ -9717,7 +9754,8 @@ QQuickItemPrivate::ExtraData::ExtraData()
   recursiveEffectRefCount(0),
   opacityNode(nullptr), clipNode(nullptr), rootNode(nullptr),
   origin(QQuickItem::Center),
-  transparentForPositioner(false)
+  transparentForPositioner(false),
+  pointerBoundsUnbounded(false)
 {
 }
 
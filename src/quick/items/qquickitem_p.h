@@ -303,6 +303,7 @@ public:
         ImplicitHeight = 0x200,
         Enabled = 0x400,
         Focus = 0x800,
+        Culled = 0x1000,
         AllChanges = 0xFFFFFFFF
     };
 
@@ -410,10 +411,16 @@ public:
         Qt::MouseButtons acceptedMouseButtons;
         Qt::MouseButtons acceptedMouseButtonsWithoutHandlers;
 
+        // Bounds of what a pointer can hit in this item's subtree, in its own coordinates.
+        // Only measured when the pointer bounds index is enabled, see
+        // QQuickDeliveryAgentPrivate::pointerBoundsContain().
+        QRectF pointerBounds;
+
         uint origin:5; // QQuickItem::TransformOrigin
         uint transparentForPositioner : 1;
+        uint pointerBoundsUnbounded : 1;
 
-        // 26 bits padding
+        // 25 bits padding
     };
 
     enum ExtraDataTag {
@@ -494,6 +501,8 @@ public:
     // (e.g. when parent has ItemIsViewport and child has ItemObservesViewport)
     quint32 subtreeTransformChangedEnabled:1;
     quint32 inDestructor:1; // has entered ~QQuickItem
+    // set when extra->pointerBounds needs to be measured again; always set on the ancestors too
+    quint32 pointerBoundsDirty:1;
 
     enum DirtyType {
         TransformOrigin         = 0x00000001,
@@ -530,6 +539,7 @@ public:
     quint32 dirtyAttributes;
     QString dirtyToString() const;
     void dirty(DirtyType);
+    void invalidatePointerBounds();
     void addToDirtyList();
     void removeFromDirtyList();
     QQuickItem *nextDirtyItem;
@@ -603,6 +613,7 @@ public:
 
     virtual qreal getImplicitWidth() const;
     virtual qreal getImplicitHeight() const;
+    virtual qreal getBaselineOffset() const;
     virtual void implicitWidthChanged();
     virtual void implicitHeightChanged();
 
@@ -99,6 +99,7 @@ public:
     virtual void itemImplicitWidthChanged(QQuickItem *) {}
     virtual void itemImplicitHeightChanged(QQuickItem *) {}
     virtual void itemFocusChanged(QQuickItem *, Qt::FocusReason /* reason */) {}
+    virtual void itemCulledChanged(QQuickItem *) {}
 
     virtual QQuickAnchorsPrivate *anchorPrivate() { return nullptr; }
 };
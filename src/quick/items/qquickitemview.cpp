@@ -5,17 +5,36 @@
 #include "qquickitemviewfxitem_p_p.h"
 #include <QtQuick/private/qquicktransition_p.h>
 #include <QtQml/QQmlInfo>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlincubator.h>
+#include <QtQuick/qquickwindow.h>
+#include <QtGui/qscreen.h>
 #include "qplatformdefs.h"
 
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcItemViewDelegateLifecycle, "qt.quick.itemview.lifecycle")
+Q_LOGGING_CATEGORY(lcItemViewFlick, "qt.quick.itemview.flick")
 
 // Default cacheBuffer for all views.
 #ifndef QML_VIEW_DEFAULTCACHEBUFFER
 #define QML_VIEW_DEFAULTCACHEBUFFER 320
 #endif
 
+// How far ahead of a flick, in milliseconds of travel at the current
+// velocity, delegates are incubated. 0 disables predictive incubation.
+int QQuickItemViewPrivate::incubationLookahead = qEnvironmentVariableIntValue("QML_VIEW_INCUBATION_LOOKAHEAD");
+
+// Time per frame spent incubating delegates while a view is flicking, on
+// top of what the window's incubation controller does.
+static int defaultIncubationBudget()
+{
+    bool ok = false;
+    const int budget = qEnvironmentVariableIntValue("QML_VIEW_INCUBATION_BUDGET", &ok);
+    return ok ? budget : 4;
+}
+int QQuickItemViewPrivate::incubationBudget = defaultIncubationBudget();
+
 FxViewItem::FxViewItem(QQuickItem *i, QQuickItemView *v, bool own, QQuickItemViewAttached *attached)
     : QQuickItemViewFxItem(i, own, QQuickItemViewPrivate::get(v))
     , view(v)
@@ -1230,9 +1249,25 @@ void QQuickItemView::modelUpdated(const QQmlChangeSet &changeSet, bool reset)
     }
 }
 
+void QQuickItemView::viewportMoved(Qt::Orientations orient)
+{
+    Q_D(QQuickItemView);
+    QQuickFlickable::viewportMoved(orient);
+    if (d->hData.flicking || d->vData.flicking) {
+        d->trackFlickFrame();
+        // Incubating here would create delegates, and refill, in the middle
+        // of moving the viewport. Do it once per frame when polishing instead.
+        if (QQuickItemViewPrivate::incubationLookahead > 0 && !d->incubateAheadPending) {
+            d->incubateAheadPending = true;
+            polish();
+        }
+    }
+}
+
 void QQuickItemView::animStopped()
 {
     Q_D(QQuickItemView);
+    d->reportFlickFrames();
     d->bufferMode = QQuickItemViewPrivate::BufferBefore | QQuickItemViewPrivate::BufferAfter;
     d->refillOrLayout();
     if (d->haveHighlightRange && d->highlightRange == QQuickItemView::StrictlyEnforceRange)
@@ -1433,6 +1468,12 @@ void QQuickItemView::updatePolish()
 {
     Q_D(QQuickItemView);
     QQuickFlickable::updatePolish();
+    if (d->incubateAheadPending) {
+        d->incubateAheadPending = false;
+        // Finish what was requested for the area ahead of the flick before
+        // the view lays out for the new position.
+        d->incubateAhead();
+    }
     d->layout();
 }
 
@@ -1755,6 +1796,10 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
         itemCount = model->count();
         qreal bufferFrom = from - buffer;
         qreal bufferTo = to + buffer;
+        if (bufferMode == BufferBefore)
+            bufferFrom -= lookaheadBuffer();
+        else if (bufferMode == BufferAfter)
+            bufferTo += lookaheadBuffer();
         qreal fillFrom = from;
         qreal fillTo = to;
 
@@ -1790,6 +1835,70 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
     storeFirstVisibleItemPosition();
 }
 
+/*!
+    \internal
+
+    Returns how much further than the cache buffer delegates are created in
+    the direction of a flick, so that they are incubated before the view
+    reaches them. The distance is what the view travels within the
+    lookahead time at the current velocity, but at most two view sizes.
+*/
+qreal QQuickItemViewPrivate::lookaheadBuffer() const
+{
+    const int lookahead = incubationLookahead;
+    if (lookahead <= 0 || !buffer || (!hData.flicking && !vData.flicking))
+        return 0;
+    const qreal velocity = layoutOrientation() == Qt::Vertical ? vData.smoothVelocity.value()
+                                                               : hData.smoothVelocity.value();
+    return qMin(qAbs(velocity) * lookahead / 1000, size() * 2);
+}
+
+void QQuickItemViewPrivate::incubateAhead()
+{
+    Q_Q(QQuickItemView);
+    if (incubationLookahead <= 0 || incubationBudget <= 0 || requestedIndex == -1
+            || (!hData.flicking && !vData.flicking)) {
+        return;
+    }
+    QQmlEngine *engine = qmlEngine(q);
+    QQmlIncubationController *controller = engine ? engine->incubationController() : nullptr;
+    if (controller && controller->incubatingObjectCount())
+        controller->incubateFor(incubationBudget);
+}
+
+void QQuickItemViewPrivate::trackFlickFrame()
+{
+    Q_Q(QQuickItemView);
+    if (!flickFrameTimer.isValid()) {
+        flickFrameTimer.start();
+        flickFrameCount = 0;
+        droppedFlickFrames = 0;
+        return;
+    }
+    const qreal refreshRate = q->window() && q->window()->screen()
+            ? q->window()->screen()->refreshRate() : 60;
+    const qreal frameInterval = 1000 / qMax(refreshRate, qreal(1));
+    const qint64 elapsed = flickFrameTimer.elapsed();
+    // Both axes may move within the same frame.
+    if (elapsed < frameInterval / 2)
+        return;
+    flickFrameTimer.restart();
+    ++flickFrameCount;
+    // Anything noticeably longer than a frame means frames were skipped.
+    if (elapsed > frameInterval * 1.5)
+        droppedFlickFrames += qRound(elapsed / frameInterval) - 1;
+}
+
+void QQuickItemViewPrivate::reportFlickFrames()
+{
+    Q_Q(QQuickItemView);
+    if (!flickFrameTimer.isValid())
+        return;
+    qCDebug(lcItemViewFlick) << q << "flick ended after" << flickFrameCount << "frames,"
+                             << droppedFlickFrames << "dropped";
+    flickFrameTimer.invalidate();
+}
+
 void QQuickItemViewPrivate::regenerate(bool orientationChanged)
 {
     Q_Q(QQuickItemView);
@@ -260,6 +260,7 @@ protected:
     qreal maxYExtent() const override;
     qreal minXExtent() const override;
     qreal maxXExtent() const override;
+    void viewportMoved(Qt::Orientations orient) override;
 
 protected Q_SLOTS:
     void destroyRemoved();
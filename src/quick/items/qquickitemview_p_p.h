@@ -26,6 +26,7 @@ QT_REQUIRE_CONFIG(quick_itemview);
 #include <QtQmlModels/private/qqmlobjectmodel_p.h>
 #include <QtQmlModels/private/qqmldelegatemodel_p.h>
 #include <QtQmlModels/private/qqmlchangeset_p.h>
+#include <QtCore/qelapsedtimer.h>
 
 
 QT_BEGIN_NAMESPACE
@@ -135,6 +136,10 @@ public:
     void animationFinished(QAbstractAnimationJob *) override;
     void refill();
     void refill(qreal from, qreal to);
+    qreal lookaheadBuffer() const;
+    void incubateAhead();
+    void trackFlickFrame();
+    void reportFlickFrames();
     void mirrorChange() override;
 
     FxViewItem *createItem(int modelIndex,QQmlIncubator::IncubationMode incubationMode = QQmlIncubator::AsynchronousIfNested);
@@ -243,6 +248,14 @@ public:
     QQuickItemViewChangeSet bufferedChanges;
     QPauseAnimationJob bufferPause;
 
+    QElapsedTimer flickFrameTimer;
+    int flickFrameCount = 0;
+    int droppedFlickFrames = 0;
+    bool incubateAheadPending = false;
+
+    static int incubationLookahead;
+    static int incubationBudget;
+
     QQmlComponent *highlightComponent;
     std::unique_ptr<FxViewItem> highlight;
     int highlightRange;     // enum value
@@ -1394,6 +1394,167 @@ bool QQuickTableViewPrivate::EdgeRange::containsIndex(Qt::Edge edge, int index)
     return index >= s && index <= e;
 }
 
+void QQuickTableViewSizeIndex::reset(int count)
+{
+    m_count = qMax(0, count);
+    m_measuredCount = 0;
+    m_measuredTotal = 0;
+    // The trees are allocated once the first size is known
+    m_sizeTree.clear();
+    m_measuredTree.clear();
+    m_sizes.clear();
+}
+
+void QQuickTableViewSizeIndex::add(int index, qreal size, int measured)
+{
+    for (int i = index + 1; i <= m_count; i += i & -i) {
+        m_sizeTree[i] += size;
+        m_measuredTree[i] += measured;
+    }
+}
+
+void QQuickTableViewSizeIndex::setSize(int index, qreal size)
+{
+    if (index < 0 || index >= m_count)
+        return;
+
+    if (m_sizes.isEmpty()) {
+        m_sizeTree.fill(0, m_count + 1);
+        m_measuredTree.fill(0, m_count + 1);
+        m_sizes.fill(qQNaN(), m_count);
+    }
+
+    qreal &current = m_sizes[index];
+    if (qIsNaN(current)) {
+        add(index, size, 1);
+        ++m_measuredCount;
+        m_measuredTotal += size;
+    } else if (current != size) {
+        add(index, size - current, 0);
+        m_measuredTotal += size - current;
+    }
+    current = size;
+}
+
+void QQuickTableViewSizeIndex::insert(int index, int count)
+{
+    if (count <= 0)
+        return;
+    index = qBound(0, index, m_count);
+    m_count += count;
+    if (m_sizes.isEmpty())
+        return;
+
+    // Shifting the indices of a Fenwick tree changes the ranges that all
+    // the nodes after index cover, so rebuild it from the plain sizes.
+    m_sizes.insert(index, count, qQNaN());
+    rebuild();
+}
+
+void QQuickTableViewSizeIndex::remove(int index, int count)
+{
+    if (index < 0 || index >= m_count || count <= 0)
+        return;
+    count = qMin(count, m_count - index);
+    m_count -= count;
+    if (m_sizes.isEmpty())
+        return;
+
+    m_sizes.remove(index, count);
+    rebuild();
+}
+
+void QQuickTableViewSizeIndex::move(int from, int to, int count)
+{
+    if (from < 0 || to < 0 || count <= 0 || from == to
+            || from + count > m_count || to + count > m_count || m_sizes.isEmpty()) {
+        return;
+    }
+
+    const auto begin = m_sizes.begin();
+    if (from < to)
+        std::rotate(begin + from, begin + from + count, begin + to + count);
+    else
+        std::rotate(begin + to, begin + from, begin + from + count);
+    rebuild();
+}
+
+void QQuickTableViewSizeIndex::rebuild()
+{
+    m_sizeTree.fill(0, m_count + 1);
+    m_measuredTree.fill(0, m_count + 1);
+    m_measuredCount = 0;
+    m_measuredTotal = 0;
+
+    for (int i = 0; i < m_count; ++i) {
+        const qreal size = m_sizes.at(i);
+        if (qIsNaN(size))
+            continue;
+        m_sizeTree[i + 1] = size;
+        m_measuredTree[i + 1] = 1;
+        ++m_measuredCount;
+        m_measuredTotal += size;
+    }
+
+    // Build the trees bottom-up in O(n) by pushing each
+    // node's sum to the parent range that contains it.
+    for (int i = 1; i <= m_count; ++i) {
+        const int parent = i + (i & -i);
+        if (parent <= m_count) {
+            m_sizeTree[parent] += m_sizeTree[i];
+            m_measuredTree[parent] += m_measuredTree[i];
+        }
+    }
+}
+
+qreal QQuickTableViewSizeIndex::estimatedSize(qreal fallbackSize) const
+{
+    return m_measuredCount > 0 ? m_measuredTotal / m_measuredCount : fallbackSize;
+}
+
+qreal QQuickTableViewSizeIndex::position(int index, qreal fallbackSize) const
+{
+    index = qBound(0, index, m_count);
+    qreal measuredSize = 0;
+    int measured = 0;
+    if (!m_sizes.isEmpty()) {
+        for (int i = index; i > 0; i -= i & -i) {
+            measuredSize += m_sizeTree[i];
+            measured += m_measuredTree[i];
+        }
+    }
+    return measuredSize + (index - measured) * estimatedSize(fallbackSize);
+}
+
+int QQuickTableViewSizeIndex::indexAt(qreal pos, qreal fallbackSize) const
+{
+    if (m_count == 0)
+        return 0;
+
+    const qreal estimate = estimatedSize(fallbackSize);
+    if (m_sizes.isEmpty())
+        return estimate > 0 ? qBound(0, int(pos / estimate), m_count - 1) : 0;
+
+    // Descend the tree, adding up the sizes of all the ranges that
+    // end before pos, to find the index that contains it.
+    int step = 1;
+    while (step <= m_count / 2)
+        step *= 2;
+    int index = 0;
+    qreal accumulated = 0;
+    for (; step > 0; step /= 2) {
+        const int next = index + step;
+        if (next > m_count)
+            continue;
+        const qreal rangeSize = m_sizeTree[next] + (step - m_measuredTree[next]) * estimate;
+        if (accumulated + rangeSize <= pos) {
+            index = next;
+            accumulated += rangeSize;
+        }
+    }
+    return qMin(index, m_count - 1);
+}
+
 QQuickTableViewPrivate::QQuickTableViewPrivate()
     : QQuickFlickablePrivate()
 {
@@ -2042,10 +2203,8 @@ void QQuickTableViewPrivate::updateContentHeight()
     }
 
     const int nextRow = nextVisibleEdgeIndexAroundLoadedTable(Qt::BottomEdge);
-    const int rowsRemaining = nextRow == kEdgeIndexAtEnd ? 0 : tableSize.height() - nextRow;
-    const qreal remainingRowHeights = rowsRemaining * averageEdgeSize.height();
-    const qreal remainingSpacing = rowsRemaining * cellSpacing.height();
-    const qreal estimatedRemainingHeight = remainingRowHeights + remainingSpacing;
+    const qreal estimatedRemainingHeight = nextRow == kEdgeIndexAtEnd
+            ? 0 : estimatedRowsHeight(nextRow, tableSize.height());
     const qreal estimatedHeight = loadedTableOuterRect.bottom() + estimatedRemainingHeight;
 
     QBoolBlocker fixupGuard(inUpdateContentSize, true);
@@ -2164,10 +2323,7 @@ void QQuickTableViewPrivate::updateExtents()
         // The table rect is at the origin, or outside, but we still have more
         // visible rows at the top. So we try to guesstimate how much space
         // the rest of the rows will occupy, and move the origin accordingly.
-        const int rowsRemaining = nextTopRow + 1;
-        const qreal remainingRowHeights = rowsRemaining * averageEdgeSize.height();
-        const qreal remainingSpacing = rowsRemaining * cellSpacing.height();
-        const qreal estimatedRemainingHeight = remainingRowHeights + remainingSpacing;
+        const qreal estimatedRemainingHeight = estimatedRowsHeight(0, nextTopRow + 1);
         origin.ry() = loadedTableOuterRect.top() - estimatedRemainingHeight;
         vData.markExtentsDirty();
     } else if (nextBottomRow == kEdgeIndexAtEnd) {
@@ -2192,10 +2348,7 @@ void QQuickTableViewPrivate::updateExtents()
         // The bottom-most row is outside the end of the content view, and we
         // still have more visible rows in the model. This can happen if the application
         // has set a fixed content height.
-        const int rowsRemaining = tableSize.height() - nextBottomRow;
-        const qreal remainingRowHeigts = rowsRemaining * averageEdgeSize.height();
-        const qreal remainingSpacing = rowsRemaining * cellSpacing.height();
-        const qreal estimatedRemainingHeight = remainingRowHeigts + remainingSpacing;
+        const qreal estimatedRemainingHeight = estimatedRowsHeight(nextBottomRow, tableSize.height());
         const qreal pixelsOutsideContentHeight = loadedTableOuterRect.bottom() - q->contentHeight();
         endExtent.rheight() = pixelsOutsideContentHeight + estimatedRemainingHeight;
         vData.markExtentsDirty();
@@ -2250,6 +2403,46 @@ void QQuickTableViewPrivate::updateAverageRowHeight()
     }
 }
 
+/*!
+    \internal
+
+    Returns the estimated y position of \a row in a table that starts at
+    zero. Rows that have been loaded contribute their actual height, the
+    others the average height of those.
+*/
+qreal QQuickTableViewPrivate::estimatedRowY(int row) const
+{
+    const qreal fallbackHeight = averageEdgeSize.height() + cellSpacing.height();
+    if (explicitContentHeight.isValid())
+        return row * fallbackHeight;
+    return rowSizes.position(row, fallbackHeight);
+}
+
+qreal QQuickTableViewPrivate::estimatedRowsHeight(int fromRow, int toRow) const
+{
+    return estimatedRowY(toRow) - estimatedRowY(fromRow);
+}
+
+int QQuickTableViewPrivate::estimatedRowAt(qreal y) const
+{
+    const qreal fallbackHeight = averageEdgeSize.height() + cellSpacing.height();
+    if (explicitContentHeight.isValid())
+        return int(y / fallbackHeight);
+    return rowSizes.indexAt(y, fallbackHeight);
+}
+
+void QQuickTableViewPrivate::updateRowSizes()
+{
+    // Inserted, removed and moved rows are shifted in the index when the
+    // model reports them, so the count only differs if we missed an update.
+    // Heights of rows outside the viewport that were measured before a
+    // relayout are kept as estimates until those rows are loaded again.
+    if (rowSizes.count() != tableSize.height())
+        rowSizes.reset(tableSize.height());
+    for (const int row : loadedRows)
+        rowSizes.setSize(row, getEffectiveRowHeight(row) + cellSpacing.height());
+}
+
 void QQuickTableViewPrivate::syncLoadedTableRectFromLoadedTable()
 {
     const QPoint topLeft = QPoint(leftColumn(), topRow());
@@ -3145,6 +3338,8 @@ void QQuickTableViewPrivate::processLoadRequest()
     syncLoadedTableFromLoadRequest();
     layoutTableEdgeFromLoadRequest();
     syncLoadedTableRectFromLoadedTable();
+    if (loadRequest.edge() == Qt::TopEdge || loadRequest.edge() == Qt::BottomEdge)
+        updateRowSizes();
 
     if (rebuildState == RebuildState::Done) {
         // Loading of this edge was not done as a part of a rebuild, but
@@ -3398,12 +3593,12 @@ void QQuickTableViewPrivate::calculateTopLeft(QPoint &topLeftCell, QPointF &topL
             }
         } else if (rebuildOptions & RebuildOption::CalculateNewTopLeftRow) {
             // Guesstimate new top left
-            const int newRow = int(viewportRect.y() / (averageEdgeSize.height() + cellSpacing.height()));
+            const int newRow = estimatedRowAt(viewportRect.y());
             topLeftCell.ry() = qBound(0, newRow, tableSize.height() - 1);
-            topLeftPos.ry() = topLeftCell.y() * (averageEdgeSize.height() + cellSpacing.height());
+            topLeftPos.ry() = estimatedRowY(topLeftCell.y());
         } else if (rebuildOptions & RebuildOption::PositionViewAtRow) {
             topLeftCell.ry() = qBound(0, positionViewAtRowAfterRebuild, tableSize.height() - 1);
-            topLeftPos.ry() = qFloor(topLeftCell.y()) * (averageEdgeSize.height() + cellSpacing.height());
+            topLeftPos.ry() = estimatedRowY(topLeftCell.y());
         } else {
             topLeftCell.ry() = qBound(0, topRow(), tableSize.height() - 1);
             topLeftPos.ry() = loadedTableOuterRect.y();
@@ -3443,6 +3638,7 @@ void QQuickTableViewPrivate::loadInitialTable()
     if (rebuildOptions & RebuildOption::All) {
         origin = QPointF(0, 0);
         endExtent = QSizeF(0, 0);
+        rowSizes.reset(0);
         hData.markExtentsDirty();
         vData.markExtentsDirty();
         updateBeginningEnd();
@@ -3505,6 +3701,7 @@ void QQuickTableViewPrivate::layoutAfterLoadingInitialTable()
     clearEdgeSizeCache();
     relayoutTableItems();
     syncLoadedTableRectFromLoadedTable();
+    updateRowSizes();
 
     const bool allColumnsLoaded = atTableEnd(Qt::LeftEdge) && atTableEnd(Qt::RightEdge);
     if (rebuildOptions.testFlag(RebuildOption::CalculateNewContentWidth) || allColumnsLoaded) {
@@ -4315,20 +4512,35 @@ void QQuickTableViewPrivate::disconnectFromModel()
 
 void QQuickTableViewPrivate::modelUpdated(const QQmlChangeSet &changeSet, bool reset)
 {
-    Q_UNUSED(changeSet);
-    Q_UNUSED(reset);
-
     Q_TABLEVIEW_ASSERT(!model->abstractItemModel(), "");
+
+    // Models that are not QAIMs have a single column, so
+    // the indices in the change set are row indices.
+    if (reset) {
+        rowSizes.reset(0);
+    } else {
+        for (const QQmlChangeSet::Change &remove : changeSet.removes())
+            rowSizes.remove(remove.index, remove.count);
+        for (const QQmlChangeSet::Change &insert : changeSet.inserts())
+            rowSizes.insert(insert.index, insert.count);
+    }
+
     scheduleRebuildTable(RebuildOption::ViewportOnly
                          | RebuildOption::CalculateNewContentWidth
                          | RebuildOption::CalculateNewContentHeight);
 }
 
-void QQuickTableViewPrivate::rowsMovedCallback(const QModelIndex &parent, int, int, const QModelIndex &, int )
+void QQuickTableViewPrivate::rowsMovedCallback(const QModelIndex &parent, int start, int end, const QModelIndex &destination, int row)
 {
     if (parent != QModelIndex())
         return;
 
+    if (destination == parent) {
+        // row is the destination before the moved rows are taken out
+        const int count = end - start + 1;
+        rowSizes.move(start, row > start ? row - count : row, count);
+    }
+
     scheduleRebuildTable(RebuildOption::ViewportOnly);
 }
 
@@ -4340,21 +4552,25 @@ void QQuickTableViewPrivate::columnsMovedCallback(const QModelIndex &parent, int
     scheduleRebuildTable(RebuildOption::ViewportOnly);
 }
 
-void QQuickTableViewPrivate::rowsInsertedCallback(const QModelIndex &parent, int, int)
+void QQuickTableViewPrivate::rowsInsertedCallback(const QModelIndex &parent, int begin, int end)
 {
     if (parent != QModelIndex())
         return;
 
+    rowSizes.insert(begin, end - begin + 1);
+
     scheduleRebuildTable(RebuildOption::ViewportOnly | RebuildOption::CalculateNewContentHeight);
 }
 
-void QQuickTableViewPrivate::rowsRemovedCallback(const QModelIndex &parent, int, int)
+void QQuickTableViewPrivate::rowsRemovedCallback(const QModelIndex &parent, int begin, int end)
 {
     Q_Q(QQuickTableView);
 
     if (parent != QModelIndex())
         return;
 
+    rowSizes.remove(begin, end - begin + 1);
+
     // If editIndex was a part of the removed rows, it will now be invalid.
     if (!editIndex.isValid() && editItem)
         q->closeEditor();
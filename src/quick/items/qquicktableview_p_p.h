@@ -44,6 +44,42 @@ static const int kEdgeIndexAtEnd = -3;
 class FxTableItem;
 class QQuickTableSectionSizeProviderPrivate;
 
+/*! \internal
+ *  QQuickTableViewSizeIndex keeps the sizes of the rows that have been
+ *  loaded at some point in a pair of Fenwick trees, so that the position
+ *  of any row, and the row at any position, can be looked up in O(log n)
+ *  also for models with millions of rows. Rows that have never been
+ *  loaded are assumed to have the average size of the ones that have.
+ */
+class Q_QUICK_PRIVATE_EXPORT QQuickTableViewSizeIndex
+{
+public:
+    void reset(int count);
+    int count() const { return m_count; }
+    int measuredCount() const { return m_measuredCount; }
+
+    void insert(int index, int count);
+    void remove(int index, int count);
+    void move(int from, int to, int count);
+
+    void setSize(int index, qreal size);
+    qreal estimatedSize(qreal fallbackSize) const;
+    qreal position(int index, qreal fallbackSize) const;
+    qreal totalSize(qreal fallbackSize) const { return position(m_count, fallbackSize); }
+    int indexAt(qreal pos, qreal fallbackSize) const;
+
+private:
+    void add(int index, qreal size, int measured);
+    void rebuild();
+
+    int m_count = 0;
+    int m_measuredCount = 0;
+    qreal m_measuredTotal = 0;
+    QList<qreal> m_sizeTree;
+    QList<int> m_measuredTree;
+    QList<qreal> m_sizes;
+};
+
 /*! \internal
  *  TableView uses QQuickTableViewHoverHandler to track where the pointer is
  *  on top of the table, and change the cursor at the places where a drag
@@ -333,6 +369,7 @@ public:
     QQmlNullableValue<qreal> explicitContentHeight;
 
     QSizeF averageEdgeSize;
+    QQuickTableViewSizeIndex rowSizes;
 
     QPointer<QQuickTableView> assignedSyncView;
     QPointer<QQuickTableView> syncView;
@@ -409,6 +446,10 @@ public:
     qreal getEffectiveColumnWidth(int column) const;
     qreal getAlignmentContentX(int column, Qt::Alignment alignment, const qreal offset, const QRectF &subRect);
     qreal getAlignmentContentY(int row, Qt::Alignment alignment, const qreal offset, const QRectF &subRect);
+    qreal estimatedRowY(int row) const;
+    int estimatedRowAt(qreal y) const;
+    qreal estimatedRowsHeight(int fromRow, int toRow) const;
+    void updateRowSizes();
 
     int topRow() const { return *loadedRows.cbegin(); }
     int bottomRow() const { return *loadedRows.crbegin(); }
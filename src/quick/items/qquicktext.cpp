@@ -46,6 +46,11 @@ const QChar QQuickTextPrivate::elideChar = QChar(0x2026);
 // if QString::size() > largeTextSizeThreshold, we render more often, but only visible lines
 const int QQuickTextPrivate::largeTextSizeThreshold = QQUICKTEXT_LARGETEXT_THRESHOLD;
 
+// When set, a relayout caused only by a geometry change is postponed to the
+// next polish, so that the width and height changes a view applies to its
+// delegates within one frame are laid out once.
+bool QQuickTextPrivate::deferGeometryLayout = qEnvironmentVariableIntValue("QML_TEXT_DEFERRED_LAYOUT") != 0;
+
 QQuickTextPrivate::QQuickTextPrivate()
     : fontInfo(font), elideLayout(nullptr), textLine(nullptr), lineWidth(0)
     , color(0xFF000000), linkColor(0xFF0000FF), styleColor(0xFF000000)
@@ -61,6 +66,7 @@ QQuickTextPrivate::QQuickTextPrivate()
     , truncated(false), hAlignImplicit(true), rightToLeftText(false)
     , layoutTextElided(false), textHasChanged(true), needToUpdateLayout(false), formatModifiesFontSize(false)
     , polishSize(false)
+    , layoutDeferred(false)
     , updateSizeRecursionGuard(false)
 {
     implicitAntialiasing = true;
@@ -130,6 +136,24 @@ qreal QQuickTextPrivate::getImplicitHeight() const
     return implicitHeight;
 }
 
+qreal QQuickTextPrivate::getBaselineOffset() const
+{
+    const_cast<QQuickTextPrivate *>(this)->updateDeferredSize();
+    return baselineOffset;
+}
+
+/*!
+    \internal
+
+    Runs a relayout that was postponed to the next polish right away, for
+    the accessors that report the result of the layout.
+*/
+void QQuickTextPrivate::updateDeferredSize()
+{
+    if (layoutDeferred)
+        updateSize();
+}
+
 qreal QQuickTextPrivate::availableWidth() const
 {
     Q_Q(const QQuickText);
@@ -336,6 +360,8 @@ void QQuickTextPrivate::updateSize()
 {
     Q_Q(QQuickText);
 
+    layoutDeferred = false;
+
     if (!q->isComponentComplete()) {
         updateOnComponentComplete = true;
         return;
@@ -2065,6 +2091,7 @@ void QQuickText::setWrapMode(WrapMode mode)
 int QQuickText::lineCount() const
 {
     Q_D(const QQuickText);
+    const_cast<QQuickTextPrivate *>(d)->updateDeferredSize();
     return d->lineCount;
 }
 
@@ -2081,6 +2108,7 @@ int QQuickText::lineCount() const
 bool QQuickText::truncated() const
 {
     Q_D(const QQuickText);
+    const_cast<QQuickTextPrivate *>(d)->updateDeferredSize();
     return d->truncated;
 }
 
@@ -2448,6 +2476,12 @@ void QQuickText::geometryChange(const QRectF &newGeometry, const QRectF &oldGeom
     if (d->updateOnComponentComplete || d->textHasChanged) {
         // We need to re-elide
         d->updateLayout();
+    } else if (QQuickTextPrivate::deferGeometryLayout && !d->requireImplicitSize
+               && !d->isLineLaidOutConnected() && window()) {
+        // Nothing has asked for the implicit size, so the new layout is only
+        // needed for rendering and can wait until the item is polished.
+        d->layoutDeferred = true;
+        polish();
     } else {
         // We just need to re-layout
         d->updateSize();
@@ -2545,7 +2579,7 @@ void QQuickText::updatePolish()
     if (!d->assignedFont.isEmpty() && QFontInfo(d->font).family() != d->assignedFont)
         d->polishSize = true;
 
-    if (d->polishSize) {
+    if (d->polishSize || d->layoutDeferred) {
         d->updateSize();
         d->polishSize = false;
     }
@@ -2561,6 +2595,7 @@ void QQuickText::updatePolish()
 qreal QQuickText::contentWidth() const
 {
     Q_D(const QQuickText);
+    const_cast<QQuickTextPrivate *>(d)->updateDeferredSize();
     return d->layedOutTextRect.width();
 }
 
@@ -2573,6 +2608,7 @@ qreal QQuickText::contentWidth() const
 qreal QQuickText::contentHeight() const
 {
     Q_D(const QQuickText);
+    const_cast<QQuickTextPrivate *>(d)->updateDeferredSize();
     return d->layedOutTextRect.height() + qMax(d->lineHeightOffset(), 0);
 }
 
@@ -3115,6 +3151,7 @@ void QQuickText::forceLayout()
 QString QQuickText::linkAt(qreal x, qreal y) const
 {
     Q_D(const QQuickText);
+    const_cast<QQuickTextPrivate *>(d)->updateDeferredSize();
     return d->anchorAt(QPointF(x, y));
 }
 
@@ -3352,6 +3389,7 @@ QJSValue QQuickText::fontInfo() const
 QSizeF QQuickText::advance() const
 {
     Q_D(const QQuickText);
+    const_cast<QQuickTextPrivate *>(d)->updateDeferredSize();
     return d->advance;
 }
 
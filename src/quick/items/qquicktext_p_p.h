@@ -39,6 +39,7 @@ public:
 
     void updateBaseline(qreal baseline, qreal dy);
     void updateSize();
+    void updateDeferredSize();
     void signalSizeChange(const QSizeF &previousSize);
     void updateLayout();
     bool determineHorizontalAlignment();
@@ -142,13 +143,16 @@ public:
     bool needToUpdateLayout:1;
     bool formatModifiesFontSize:1;
     bool polishSize:1; // Workaround for problem with polish called after updateSize (QTBUG-42636)
+    bool layoutDeferred:1; // geometry-driven relayout postponed to polish, see QML_TEXT_DEFERRED_LAYOUT
     bool updateSizeRecursionGuard:1;
 
     static const QChar elideChar;
     static const int largeTextSizeThreshold;
+    static bool deferGeometryLayout;
 
     qreal getImplicitWidth() const override;
     qreal getImplicitHeight() const override;
+    qreal getBaselineOffset() const override;
 
     qreal availableWidth() const;
     qreal availableHeight() const;
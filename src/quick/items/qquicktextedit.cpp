@@ -578,6 +578,7 @@ void QQuickTextEdit::setFont(const QFont &font)
 
     if (oldFont != d->font) {
         d->document->setDefaultFont(d->font);
+        d->naturalWidthValid = false;
         if (d->cursorItem) {
             d->cursorItem->setHeight(QFontMetrics(d->font).height());
             moveCursorDelegate();
@@ -970,6 +971,8 @@ void QQuickTextEdit::setWrapMode(WrapMode mode)
 int QQuickTextEdit::lineCount() const
 {
     Q_D(const QQuickTextEdit);
+    if (d->lineCountDirty)
+        const_cast<QQuickTextEdit *>(this)->updateTotalLines();
     return d->lineCount;
 }
 
@@ -1411,6 +1414,7 @@ void QQuickTextEdit::setTextMargin(qreal margin)
         return;
     d->textMargin = margin;
     d->document->setDocumentMargin(d->textMargin);
+    d->naturalWidthValid = false;
     emit textMarginChanged(d->textMargin);
 }
 
@@ -2474,7 +2478,11 @@ void QQuickTextEditPrivate::init()
 #endif
     qmlobject_connect(document, QQuickTextDocumentWithImageResources, SIGNAL(undoAvailable(bool)), q, QQuickTextEdit, SIGNAL(canUndoChanged()));
     qmlobject_connect(document, QQuickTextDocumentWithImageResources, SIGNAL(redoAvailable(bool)), q, QQuickTextEdit, SIGNAL(canRedoChanged()));
-    qmlobject_connect(document, QQuickTextDocumentWithImageResources, SIGNAL(imagesLoaded()), q, QQuickTextEdit, SLOT(updateSize()));
+    QObject::connect(document, &QQuickTextDocumentWithImageResources::imagesLoaded, q, [this]() {
+        Q_Q(QQuickTextEdit);
+        naturalWidthValid = false;
+        q->updateSize();
+    });
     QObject::connect(document, &QQuickTextDocumentWithImageResources::contentsChange, q, &QQuickTextEdit::q_contentsChange);
     QObject::connect(document->documentLayout(), &QAbstractTextDocumentLayout::updateBlock, q, &QQuickTextEdit::invalidateBlock);
     QObject::connect(control, &QQuickTextControl::linkHovered, q, &QQuickTextEdit::q_linkHovered);
@@ -2562,6 +2570,14 @@ void QQuickTextEdit::q_contentsChange(int pos, int charsRemoved, int charsAdded)
 
     markDirtyNodesForRange(pos, editRange, delta);
 
+    if (d->naturalWidthValid && (charsRemoved > 0 || !d->insertionKeepsNaturalWidth(pos, charsAdded)))
+        d->naturalWidthValid = false;
+
+    // A document that grows through append() or insert() gets the same
+    // viewport-limited rendering as one assigned through setText().
+    setFlag(QQuickItem::ItemObservesViewport,
+            d->document->characterCount() > QQuickTextEditPrivate::largeTextSizeThreshold);
+
     if (isComponentComplete()) {
         polish();
         d->updateType = QQuickTextEditPrivate::UpdatePaintNode;
@@ -2659,6 +2675,70 @@ qreal QQuickTextEditPrivate::getImplicitWidth() const
     return implicitWidth;
 }
 
+/*!
+    \internal
+    Returns the width of the document without any wrapping, given that it is
+    going to be laid out at \a textWidth.
+
+    Every change of the text width lays out the whole document again, so
+    the document is only laid out without a width limit if nothing else
+    tells the natural width: that is the case if the text doesn't wrap at
+    all, or if it fits into \a textWidth anyway. Otherwise the result is
+    kept until something changes that can affect it.
+*/
+qreal QQuickTextEditPrivate::naturalWidth(qreal textWidth)
+{
+    if (wrapMode == QQuickTextEdit::NoWrap) {
+        if (document->textWidth() != textWidth)
+            document->setTextWidth(textWidth);
+        cachedNaturalWidth = document->idealWidth();
+        naturalWidthValid = true;
+    } else if (document->textWidth() == textWidth && document->idealWidth() <= textWidth) {
+        cachedNaturalWidth = document->idealWidth();
+        naturalWidthValid = true;
+    }
+    if (!naturalWidthValid) {
+        document->setTextWidth(-1);
+        cachedNaturalWidth = document->idealWidth();
+        naturalWidthValid = true;
+    }
+    return cachedNaturalWidth;
+}
+
+/*!
+    \internal
+    Returns \c true if inserting \a charsAdded characters at \a pos can't
+    have changed the natural width.
+
+    That is the case if the document, as it is laid out, is too wide for its
+    text width, but none of the blocks that were touched is: the widest block
+    is then one that was not touched. An insertion only makes the blocks it
+    touched wider, unless it splits one, so the blocks are also checked to
+    not have any text after the insertion.
+*/
+bool QQuickTextEditPrivate::insertionKeepsNaturalWidth(int pos, int charsAdded) const
+{
+    const qreal textWidth = document->textWidth();
+    if (textWidth < 0 || document->idealWidth() <= textWidth)
+        return false;
+
+    const QTextBlock first = document->findBlock(pos);
+    const QTextBlock last = document->findBlock(pos + charsAdded);
+    if (first != last && last.position() + last.length() - 1 != pos + charsAdded)
+        return false;
+    for (QTextBlock block = first; block.isValid(); block = block.next()) {
+        const QTextLayout *layout = block.layout();
+        if (!layout || layout->lineCount() != 1)
+            return false;
+        const QTextLine line = layout->lineAt(0);
+        if (line.naturalTextWidth() > line.width())
+            return false;
+        if (block == last)
+            break;
+    }
+    return true;
+}
+
 //### we should perhaps be a bit smarter here -- depending on what has changed, we shouldn't
 //    need to do all the calculations each time
 void QQuickTextEdit::updateSize()
@@ -2681,27 +2761,24 @@ void QQuickTextEdit::updateSize()
             if (d->requireImplicitWidth)
                 return;
         }
-        if (d->requireImplicitWidth) {
-            d->document->setTextWidth(-1);
-            naturalWidth = d->document->idealWidth();
+        // Only go through the natural width if it is going to be used.
+        if (d->requireImplicitWidth && d->isImplicitResizeEnabled()) {
+            naturalWidth = d->naturalWidth(width() - leftPadding() - rightPadding());
 
             const bool wasInLayout = d->inLayout;
             d->inLayout = true;
-            if (d->isImplicitResizeEnabled())
-                setImplicitWidth(naturalWidth + leftPadding() + rightPadding());
+            setImplicitWidth(naturalWidth + leftPadding() + rightPadding());
             d->inLayout = wasInLayout;
             if (d->inLayout)    // probably the result of a binding loop, but by letting it
                 return;         // get this far we'll get a warning to that effect.
         }
         const qreal newTextWidth = width() - leftPadding() - rightPadding();
-        if (d->document->textWidth() != newTextWidth) {
+        if (d->document->textWidth() != newTextWidth)
             d->document->setTextWidth(newTextWidth);
-            newWidth = d->document->idealWidth();
-        }
-        //### need to confirm cost of always setting these
+        newWidth = d->document->idealWidth();
     } else if (d->wrapMode == NoWrap && d->document->textWidth() != newWidth) {
         d->document->setTextWidth(newWidth); // ### Text does not align if width is not set or the idealWidth exceeds the textWidth (QTextDoc bug)
-    } else {
+    } else if (d->document->textWidth() != -1) {
         d->document->setTextWidth(-1);
     }
 
@@ -2724,7 +2801,12 @@ void QQuickTextEdit::updateSize()
     if (d->contentSize != size) {
         d->contentSize = size;
         emit contentSizeChanged();
-        updateTotalLines();
+        // Counting the lines visits every block, so with nobody listening it
+        // waits until lineCount is read.
+        if (d->isLineCountChangedConnected())
+            updateTotalLines();
+        else
+            d->lineCountDirty = true;
     }
 }
 
@@ -2804,6 +2886,7 @@ void QQuickTextEdit::updateTotalLines()
 {
     Q_D(QQuickTextEdit);
 
+    d->lineCountDirty = false;
     int subLines = 0;
 
     for (QTextBlock it = d->document->begin(); it != d->document->end(); it = it.next()) {
@@ -2858,6 +2941,7 @@ void QQuickTextEditPrivate::updateDefaultTextOption()
         || oldTextDirection != opt.textDirection()
         || oldUseDesignMetrics != opt.useDesignMetrics()) {
         document->setDefaultTextOption(opt);
+        naturalWidthValid = false;
     }
 }
 
@@ -3067,6 +3151,12 @@ bool QQuickTextEditPrivate::isLinkHoveredConnected()
     IS_SIGNAL_CONNECTED(q, QQuickTextEdit, linkHovered, (const QString &));
 }
 
+bool QQuickTextEditPrivate::isLineCountChangedConnected()
+{
+    Q_Q(QQuickTextEdit);
+    IS_SIGNAL_CONNECTED(q, QQuickTextEdit, lineCountChanged, ());
+}
+
 #if QT_CONFIG(cursor)
 void QQuickTextEditPrivate::updateMouseCursorShape()
 {
@@ -3346,6 +3436,7 @@ void QQuickTextEdit::setTabStopDistance(qreal distance)
 
     textOptions.setTabStopDistance(distance);
     d->document->setDefaultTextOption(textOptions);
+    d->naturalWidthValid = false;
     emit tabStopDistanceChanged(distance);
 }
 
@@ -95,7 +95,8 @@ public:
         , focusOnPress(true), persistentSelection(false), requireImplicitWidth(false)
         , selectByMouse(true), canPaste(false), canPasteValid(false), hAlignImplicit(true)
         , textCached(true), inLayout(false), selectByKeyboard(false), selectByKeyboardSet(false)
-        , hadSelection(false), markdownText(false)
+        , hadSelection(false), markdownText(false), lineCountDirty(false)
+        , naturalWidthValid(false)
     {
     }
 
@@ -112,8 +113,11 @@ public:
     void mirrorChange() override;
     bool transformChanged(QQuickItem *transformedItem) override;
     qreal getImplicitWidth() const override;
+    qreal naturalWidth(qreal textWidth);
+    bool insertionKeepsNaturalWidth(int pos, int charsAdded) const;
     Qt::LayoutDirection textDirection(const QString &text) const;
     bool isLinkHoveredConnected();
+    bool isLineCountChangedConnected();
 
 #if QT_CONFIG(cursor)
     void updateMouseCursorShape();
@@ -144,6 +148,7 @@ public:
     QSizeF contentSize;
 
     qreal textMargin;
+    qreal cachedNaturalWidth = 0; // valid if naturalWidthValid
     qreal xoff;
     qreal yoff;
 
@@ -202,6 +207,8 @@ public:
     bool selectByKeyboardSet:1;
     bool hadSelection : 1;
     bool markdownText : 1;
+    bool lineCountDirty : 1;
+    bool naturalWidthValid : 1;
 
     static const int largeTextSizeThreshold;
 };
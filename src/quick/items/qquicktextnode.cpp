@@ -23,6 +23,8 @@
 
 #include <private/qtextdocumentlayout_p.h>
 #include <qhash.h>
+#include <qcache.h>
+#include <qglyphrun.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -37,6 +39,78 @@ namespace {
         }
     };
 
+    struct GlyphRunCacheKey
+    {
+        QString text;
+        QFont font;
+        int dpi;
+        int alignment;
+        int flags;
+        int textDirection;
+        bool useDesignMetrics;
+        qreal tabStopDistance;
+        QList<QTextOption::Tab> tabs;
+        QRectF line;
+    };
+
+    bool operator==(const GlyphRunCacheKey &a, const GlyphRunCacheKey &b)
+    {
+        return a.text == b.text && a.font == b.font && a.dpi == b.dpi
+                && a.alignment == b.alignment && a.flags == b.flags
+                && a.textDirection == b.textDirection
+                && a.useDesignMetrics == b.useDesignMetrics
+                && a.tabStopDistance == b.tabStopDistance && a.tabs == b.tabs
+                && a.line == b.line;
+    }
+
+    size_t qHash(const GlyphRunCacheKey &key, size_t seed = 0)
+    {
+        return qHashMulti(seed, key.text, key.font, key.dpi, key.alignment, key.flags,
+                          key.textDirection, key.useDesignMetrics,
+                          key.tabStopDistance, key.tabs.size(),
+                          key.line.x(), key.line.y(), key.line.width());
+    }
+
+}
+
+// Only short, single line text layouts are shared, which is what labels are
+// made of; anything longer is unlikely to be repeated verbatim.
+static const int glyphRunCacheMaxTextLength = 128;
+static const int glyphRunCacheSize = 2048;
+
+static QCache<GlyphRunCacheKey, QList<QGlyphRun>> &glyphRunCache()
+{
+    // Glyph runs hold QRawFont instances, which must be released on the thread
+    // that created them, so every render thread has its own cache.
+    static thread_local QCache<GlyphRunCacheKey, QList<QGlyphRun>> cache(glyphRunCacheSize);
+    return cache;
+}
+
+/*!
+    \internal
+
+    Returns the glyph runs of \a line in \a textLayout, shared with other
+    layouts of the same text, font and options that were laid out on the
+    calling thread.
+*/
+QList<QGlyphRun> QQuickTextNode::sharedGlyphRuns(const QTextLayout *textLayout, const QTextLine &line)
+{
+    const QTextOption option = textLayout->textOption();
+    const QFont font = textLayout->font();
+    const GlyphRunCacheKey key {
+        textLayout->text(), font, QFontPrivate::get(font)->dpi,
+        option.alignment().toInt(), option.flags().toInt(), int(option.textDirection()),
+        option.useDesignMetrics(), option.tabStopDistance(), option.tabs(),
+        QRectF(line.x(), line.y(), line.width(), line.height())
+    };
+
+    QCache<GlyphRunCacheKey, QList<QGlyphRun>> &cache = glyphRunCache();
+    if (const QList<QGlyphRun> *glyphRuns = cache.object(key))
+        return *glyphRuns;
+
+    const QList<QGlyphRun> glyphRuns = line.glyphRuns(line.textStart(), line.textLength());
+    cache.insert(key, new QList<QGlyphRun>(glyphRuns));
+    return glyphRuns;
 }
 
 Q_DECLARE_LOGGING_CATEGORY(lcVP)
@@ -240,6 +314,24 @@ void QQuickTextNode::addTextLayout(const QPointF &position, QTextLayout *textLay
             ? qMin(lineStart + lineCount, textLayout->lineCount())
             : textLayout->lineCount();
 
+    // Identical labels share the glyph runs, and through them the glyph
+    // indexes and positions held by their glyph nodes.
+    const bool hasSelection = selectionEnd >= 0 && selectionStart <= selectionEnd;
+    if (viewport.isNull() && lineStart == 0 && lineCount == 1 && !hasSelection
+            && colorChanges.isEmpty() && textLayout->formats().isEmpty()
+#if QT_CONFIG(im)
+            && preeditLength == 0
+#endif
+            && textLayout->text().size() <= glyphRunCacheMaxTextLength) {
+        const QTextLine line = textLayout->lineAt(0);
+        engine.setCurrentLine(line);
+        const QList<QGlyphRun> glyphRuns = sharedGlyphRuns(textLayout, line);
+        for (const QGlyphRun &glyphRun : glyphRuns)
+            engine.addUnselectedGlyphs(glyphRun);
+        engine.addToSceneGraph(this, style, styleColor);
+        return;
+    }
+
     bool inViewport = false;
     for (int i=lineStart; i<lineCount; ++i) {
         QTextLine line = textLayout->lineAt(i);
@@ -274,6 +366,18 @@ void QQuickTextNode::addTextLayout(const QPointF &position, QTextLayout *textLay
     engine.addToSceneGraph(this, style, styleColor);
 }
 
+/*!
+    \internal
+
+    Drops the glyph runs shared between text nodes created on the calling
+    thread, for instance because the fonts they refer to have changed, or
+    because the scene graph of a window is going away.
+*/
+void QQuickTextNode::clearGlyphRunCache()
+{
+    glyphRunCache().clear();
+}
+
 void QQuickTextNode::deleteContent()
 {
     while (firstChild() != nullptr)
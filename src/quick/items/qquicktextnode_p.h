@@ -45,6 +45,8 @@ public:
     ~QQuickTextNode();
 
     static bool isComplexRichText(QTextDocument *);
+    static QList<QGlyphRun> sharedGlyphRuns(const QTextLayout *textLayout, const QTextLine &line);
+    static void clearGlyphRunCache();
 
     void deleteContent();
     void addTextLayout(const QPointF &position, QTextLayout *textLayout, const QColor &color = QColor(),
@@ -18,6 +18,7 @@
 #include <private/qquickanimatorcontroller_p.h>
 #include <private/qquickprofiler_p.h>
 #include <private/qquicktextinterface_p.h>
+#include <private/qquicktextnode_p.h>
 
 #include <private/qguiapplication_p.h>
 
@@ -534,6 +535,7 @@ void QQuickWindowPrivate::syncSceneGraph()
 
     if (pendingFontUpdate) {
         QFont::cleanup();
+        QQuickTextNode::clearGlyphRunCache();
         invalidateFontData(contentItem);
     }
 
@@ -656,8 +658,20 @@ void QQuickWindowPrivate::renderSceneGraph()
     renderer->setViewportRect(QRect(QPoint(0, 0), pixelSize));
     renderer->setProjectionMatrixToRect(QRectF(QPointF(0, 0), pixelSize / devicePixelRatio), matrixFlags);
 
+    rendererFrameStatsMutex.lock();
+    const bool collectFrameStats = rendererFrameStatsEnabled;
+    rendererFrameStatsMutex.unlock();
+    renderer->setFrameStatsEnabled(collectFrameStats);
+
     context->renderNextFrame(renderer);
 
+    if (collectFrameStats) {
+        QMutexLocker locker(&rendererFrameStatsMutex);
+        // Collecting may have been disabled from another thread meanwhile.
+        if (rendererFrameStatsEnabled)
+            lastRendererFrameStats = renderer->frameStats();
+    }
+
     emit q->afterRendering();
     runAndClearJobs(&afterRenderingJobs);
 
@@ -671,6 +685,38 @@ void QQuickWindowPrivate::renderSceneGraph()
     }
 }
 
+/*!
+    \internal
+
+    Enables or disables collecting CPU timings and counters of the scene
+    graph renderer, such as the time spent building render lists, preparing
+    batches, creating pipelines and updating materials, and the number of
+    bytes uploaded and draw calls issued. This is meant for benchmarks and
+    regression tests; the numbers for the most recently rendered frame are
+    available from rendererFrameStats(). Only the default (batching)
+    renderer reports the detailed timings.
+*/
+void QQuickWindowPrivate::setRendererFrameStatsEnabled(bool enabled)
+{
+    QMutexLocker locker(&rendererFrameStatsMutex);
+    rendererFrameStatsEnabled = enabled;
+    if (!enabled)
+        lastRendererFrameStats = QSGRendererFrameStats();
+}
+
+/*!
+    \internal
+
+    Returns the renderer timings of the last frame rendered while collecting
+    was enabled with setRendererFrameStatsEnabled(). Safe to call from any
+    thread.
+*/
+QSGRendererFrameStats QQuickWindowPrivate::rendererFrameStats() const
+{
+    QMutexLocker locker(&rendererFrameStatsMutex);
+    return lastRendererFrameStats;
+}
+
 QQuickWindowPrivate::QQuickWindowPrivate()
     : contentItem(nullptr)
     , dirtyItemList(nullptr)
@@ -1861,6 +1907,9 @@ void QQuickWindowPrivate::cleanupNodesOnShutdown()
     for (QSet<QQuickItem *>::const_iterator it = parentlessItems.begin(), cend = parentlessItems.end(); it != cend; ++it)
         cleanupNodesOnShutdown(*it);
     animationController->windowNodesDestroyed();
+    // The shared glyph runs keep fonts alive, which must not outlive the
+    // render thread or the application.
+    QQuickTextNode::clearGlyphRunCache();
     q->cleanupSceneGraph();
 }
 
@@ -1874,13 +1923,94 @@ void QQuickWindowPrivate::updateDirtyNodes()
     dirtyItemList = nullptr;
     if (updateList) QQuickItemPrivate::get(updateList)->prevDirtyItem = &updateList;
 
+    updateDirtyNodeValues(updateList);
+
     while (updateList) {
         QQuickItem *item = updateList;
         QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
         itemPriv->removeFromDirtyList();
+        updateDirtyNode(item);
+    }
+}
+
+static inline bool qquickitem_matrix_dirty(QQuickItemPrivate *d, quint32 dirty)
+{
+    return (dirty & QQuickItemPrivate::TransformUpdateMask) ||
+           (dirty & QQuickItemPrivate::Size && d->origin() != QQuickItem::TopLeft &&
+            (d->scale() != 1. || d->rotation() != 0.));
+}
+
+static QMatrix4x4 qquickitem_node_matrix(QQuickItem *item)
+{
+    QQuickItemPrivate *d = QQuickItemPrivate::get(item);
+    QMatrix4x4 matrix;
+
+    if (d->x != 0. || d->y != 0.)
+        matrix.translate(d->x, d->y);
+
+    for (int ii = d->transforms.size() - 1; ii >= 0; --ii)
+        d->transforms.at(ii)->applyTo(&matrix);
+
+    if (d->scale() != 1. || d->rotation() != 0.) {
+        QPointF origin = item->transformOriginPoint();
+        matrix.translate(origin.x(), origin.y());
+        if (d->scale() != 1.)
+            matrix.scale(d->scale(), d->scale());
+        if (d->rotation() != 0.)
+            matrix.rotate(d->rotation(), 0, 0, 1);
+        matrix.translate(-origin.x(), -origin.y());
+    }
+
+    return matrix;
+}
 
+static inline qreal qquickitem_node_opacity(QQuickItemPrivate *d)
+{
+    return d->explicitVisible && (!d->extra.isAllocated() || d->extra->hideRefCount == 0)
+            ? d->opacity() : qreal(0);
+}
+
+/*!
+    \internal
+
+    Updates the item node matrices and the opacities of the dirty items in
+    \a updateList in one pass, before updateDirtyNode() goes through the
+    rest of the dirty state item by item. Animated positions, rotations and
+    opacities then only touch the transform and opacity data of the items,
+    rather than alternating with the paint node updates.
+
+    Only what doesn't change the structure of the node tree is done here,
+    and the corresponding dirty bits are cleared. The rest is left to
+    updateDirtyNode(): a matrix that depends on the new size or on the item
+    entering the window, and an opacity node that has to be created. If an
+    item is dirtied again before updateDirtyNode() gets to it, the bits are
+    set again and it is updated in the same frame.
+*/
+void QQuickWindowPrivate::updateDirtyNodeValues(QQuickItem *updateList)
+{
+    constexpr quint32 matrixOnlyMask = QQuickItemPrivate::TransformOrigin
+            | QQuickItemPrivate::Transform | QQuickItemPrivate::BasicTransform
+            | QQuickItemPrivate::Position;
+
+    for (QQuickItem *item = updateList; item; ) {
+        QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
         qCDebug(lcDirty) << "   QSGNode:" << item << qPrintable(itemPriv->dirtyToString());
-        updateDirtyNode(item);
+        const quint32 dirty = itemPriv->dirtyAttributes;
+
+        if ((dirty & matrixOnlyMask) && !(dirty & QQuickItemPrivate::Window)
+                && !qquickitem_matrix_dirty(itemPriv, dirty & ~matrixOnlyMask)) {
+            itemPriv->itemNode()->setMatrix(qquickitem_node_matrix(item));
+            itemPriv->dirtyAttributes &= ~matrixOnlyMask;
+        }
+
+        if ((dirty & QQuickItemPrivate::OpacityValue) && itemPriv->opacityNode()
+                && !(dirty & (QQuickItemPrivate::Visible | QQuickItemPrivate::HideReference
+                              | QQuickItemPrivate::Window))) {
+            itemPriv->opacityNode()->setOpacity(qquickitem_node_opacity(itemPriv));
+            itemPriv->dirtyAttributes &= ~quint32(QQuickItemPrivate::OpacityValue);
+        }
+
+        item = itemPriv->nextDirtyItem;
     }
 }
 
@@ -1937,30 +2067,8 @@ void QQuickWindowPrivate::updateDirtyNode(QQuickItem *item)
     quint32 dirty = itemPriv->dirtyAttributes;
     itemPriv->dirtyAttributes = 0;
 
-    if ((dirty & QQuickItemPrivate::TransformUpdateMask) ||
-        (dirty & QQuickItemPrivate::Size && itemPriv->origin() != QQuickItem::TopLeft &&
-         (itemPriv->scale() != 1. || itemPriv->rotation() != 0.))) {
-
-        QMatrix4x4 matrix;
-
-        if (itemPriv->x != 0. || itemPriv->y != 0.)
-            matrix.translate(itemPriv->x, itemPriv->y);
-
-        for (int ii = itemPriv->transforms.size() - 1; ii >= 0; --ii)
-            itemPriv->transforms.at(ii)->applyTo(&matrix);
-
-        if (itemPriv->scale() != 1. || itemPriv->rotation() != 0.) {
-            QPointF origin = item->transformOriginPoint();
-            matrix.translate(origin.x(), origin.y());
-            if (itemPriv->scale() != 1.)
-                matrix.scale(itemPriv->scale(), itemPriv->scale());
-            if (itemPriv->rotation() != 0.)
-                matrix.rotate(itemPriv->rotation(), 0, 0, 1);
-            matrix.translate(-origin.x(), -origin.y());
-        }
-
-        itemPriv->itemNode()->setMatrix(matrix);
-    }
+    if (qquickitem_matrix_dirty(itemPriv, dirty))
+        itemPriv->itemNode()->setMatrix(qquickitem_node_matrix(item));
 
     bool clipEffectivelyChanged = (dirty & (QQuickItemPrivate::Clip | QQuickItemPrivate::Window)) &&
                                   ((item->clip() == false) != (itemPriv->clipNode() == nullptr));
@@ -2105,8 +2213,7 @@ void QQuickWindowPrivate::updateDirtyNode(QQuickItem *item)
     if (dirty & (QQuickItemPrivate::OpacityValue | QQuickItemPrivate::Visible
                  | QQuickItemPrivate::HideReference | QQuickItemPrivate::Window))
     {
-        qreal opacity = itemPriv->explicitVisible && (!itemPriv->extra.isAllocated() || itemPriv->extra->hideRefCount == 0)
-                      ? itemPriv->opacity() : qreal(0);
+        qreal opacity = qquickitem_node_opacity(itemPriv);
 
         if (opacity != 1 && !itemPriv->opacityNode()) {
             QSGOpacityNode *node = new QSGOpacityNode;
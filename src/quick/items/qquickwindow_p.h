@@ -18,6 +18,7 @@
 #include <QtQuick/private/qquickdeliveryagent_p_p.h>
 #include <QtQuick/private/qquickevents_p_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/private/qsgrenderer_p.h>
 #include <QtQuick/private/qquickpaletteproviderprivatebase_p.h>
 #include <QtQuick/private/qquickrendertarget_p.h>
 #include <QtQuick/private/qquickgraphicsdevice_p.h>
@@ -175,6 +176,7 @@ public:
     bool updateEffectiveOpacity(QQuickItem *);
     void updateEffectiveOpacityRoot(QQuickItem *, qreal);
     void updateDirtyNode(QQuickItem *);
+    void updateDirtyNodeValues(QQuickItem *updateList);
 
     void fireFrameSwapped() { Q_EMIT q_func()->frameSwapped(); }
     void fireAboutToStop() { Q_EMIT q_func()->sceneGraphAboutToStop(); }
@@ -247,6 +249,14 @@ public:
     void runAndClearJobs(QList<QRunnable *> *jobs);
     QOpenGLContext *openglContext();
 
+    // CPU timings of the renderer for the last rendered frame. Written on the
+    // render thread, can be read from any thread.
+    void setRendererFrameStatsEnabled(bool enabled);
+    QSGRendererFrameStats rendererFrameStats() const;
+    mutable QMutex rendererFrameStatsMutex;
+    QSGRendererFrameStats lastRendererFrameStats;
+    bool rendererFrameStatsEnabled = false;
+
     QQuickWindow::GraphicsStateInfo rhiStateInfo;
     QRhi *rhi = nullptr;
     QRhiSwapChain *swapchain = nullptr;
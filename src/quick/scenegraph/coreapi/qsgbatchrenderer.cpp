@@ -66,6 +66,14 @@ static inline int size_of_type(int type)
     return sizes[type - QSGGeometry::ByteType];
 }
 
+// Returns the nanoseconds since the last lap and starts the next one.
+static inline qint64 qsg_lapNsecs(QElapsedTimer *timer)
+{
+    const qint64 elapsed = timer->nsecsElapsed();
+    timer->start();
+    return elapsed;
+}
+
 bool qsg_sort_element_increasing_order(Element *a, Element *b) { return a->order < b->order; }
 bool qsg_sort_element_decreasing_order(Element *a, Element *b) { return a->order > b->order; }
 bool qsg_sort_batch_is_valid(Batch *a, Batch *b) { return a->first && !b->first; }
@@ -1023,6 +1031,8 @@ void Renderer::unmap(Buffer *buffer, bool isIndexBuf)
         }
     }
     if (buffer->buf) {
+        if (Q_UNLIKELY(m_frameStatsEnabled))
+            m_frameStats.uploadedBytes += buffer->size;
         if (buffer->buf->type() != QRhiBuffer::Dynamic) {
             m_resourceUpdates->uploadStaticBuffer(buffer->buf,
                                                  0, buffer->size, buffer->data);
@@ -2533,6 +2543,8 @@ void Renderer::enqueueStencilDraw(const Batch *batch)
             cb->setVertexInput(0, 1, &vbufBinding);
             cb->draw(drawCall.vertexCount);
         }
+        if (Q_UNLIKELY(m_frameStatsEnabled))
+            ++m_frameStats.drawCallCount;
     }
 }
 
@@ -2606,6 +2618,9 @@ bool Renderer::ensurePipelineState(Element *e, const ShaderManager::Shader *sms,
     }
 
     // Build a new one. This is potentially expensive.
+    QElapsedTimer pipelineTimer;
+    if (Q_UNLIKELY(m_frameStatsEnabled))
+        pipelineTimer.start();
     QRhiGraphicsPipeline *ps = m_rhi->newGraphicsPipeline();
     ps->setShaderStages(sms->programRhi.shaderStages.cbegin(), sms->programRhi.shaderStages.cend());
     ps->setVertexInputLayout(sms->programRhi.inputLayout);
@@ -2667,6 +2682,11 @@ bool Renderer::ensurePipelineState(Element *e, const ShaderManager::Shader *sms,
         e->depthPostPassPs = ps;
     else
         e->ps = ps;
+
+    if (Q_UNLIKELY(m_frameStatsEnabled)) {
+        m_frameStats.pipelineCreationTime += pipelineTimer.nsecsElapsed();
+        ++m_frameStats.pipelineCreationCount;
+    }
     return true;
 }
 
@@ -2815,6 +2835,10 @@ void Renderer::updateMaterialDynamicData(ShaderManager::Shader *sms,
                                          int ubufOffset,
                                          int ubufRegionSize)
 {
+    QElapsedTimer materialTimer;
+    if (Q_UNLIKELY(m_frameStatsEnabled))
+        materialTimer.start();
+
     m_current_resource_update_batch = m_resourceUpdates;
 
     QSGMaterialShader *shader = sms->programRhi.program;
@@ -2826,8 +2850,11 @@ void Renderer::updateMaterialDynamicData(ShaderManager::Shader *sms,
         const bool changed = shader->updateUniformData(renderState, material, m_currentMaterial);
         m_current_uniform_data = nullptr;
 
-        if (changed || !batch->ubufDataValid)
+        if (changed || !batch->ubufDataValid) {
             m_resourceUpdates->updateDynamicBuffer(batch->ubuf, ubufOffset, ubufRegionSize, pd->masterUniformData.constData());
+            if (Q_UNLIKELY(m_frameStatsEnabled))
+                m_frameStats.uploadedBytes += ubufRegionSize;
+        }
 
         bindings.append(QRhiShaderResourceBinding::uniformBuffer(pd->ubufBinding,
                                                                  pd->ubufStages,
@@ -3002,6 +3029,9 @@ void Renderer::updateMaterialDynamicData(ShaderManager::Shader *sms,
     default:
         Q_ASSERT_X(false, "updateMaterialDynamicData", "No srb action set, this cannot happen");
     }
+
+    if (Q_UNLIKELY(m_frameStatsEnabled))
+        m_frameStats.materialUpdateTime += materialTimer.nsecsElapsed();
 }
 
 void Renderer::updateMaterialStaticData(ShaderManager::Shader *sms,
@@ -3218,6 +3248,8 @@ void Renderer::renderMergedBatch(PreparedRenderBatch *renderBatch, bool depthPos
                            m_uint32IndexForRhi ? QRhiCommandBuffer::IndexUInt32 : QRhiCommandBuffer::IndexUInt16);
         cb->drawIndexed(draw.indexCount);
     }
+    if (Q_UNLIKELY(m_frameStatsEnabled))
+        m_frameStats.drawCallCount += batch->drawSets.size();
 }
 
 bool Renderer::prepareRenderUnmergedBatch(Batch *batch, PreparedRenderBatch *renderBatch)
@@ -3418,10 +3450,14 @@ void Renderer::renderUnmergedBatch(PreparedRenderBatch *renderBatch, bool depthP
                                    effectiveIndexSize == sizeof(quint32) ? QRhiCommandBuffer::IndexUInt32
                                                                          : QRhiCommandBuffer::IndexUInt16);
                 cb->drawIndexed(g->indexCount());
+                if (Q_UNLIKELY(m_frameStatsEnabled))
+                    ++m_frameStats.drawCallCount;
             }
         } else {
             cb->setVertexInput(VERTEX_BUFFER_BINDING, 1, &vbufBinding);
             cb->draw(g->vertexCount());
+            if (Q_UNLIKELY(m_frameStatsEnabled))
+                ++m_frameStats.drawCallCount;
         }
 
         vOffset += g->sizeOfVertex() * g->vertexCount();
@@ -3573,6 +3609,10 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
         ctx->timer.start();
     }
 
+    QElapsedTimer statsTimer;
+    if (Q_UNLIKELY(m_frameStatsEnabled))
+        statsTimer.start();
+
     m_resourceUpdates = m_rhi->nextResourceUpdateBatch();
 
     if (m_rebuild & (BuildRenderLists | BuildRenderListsForTaggedRoots)) {
@@ -3597,6 +3637,7 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
         }
     }
     if (Q_UNLIKELY(debug_render())) ctx->timeRenderLists = ctx->timer.restart();
+    if (Q_UNLIKELY(m_frameStatsEnabled)) m_frameStats.buildRenderListsTime = qsg_lapNsecs(&statsTimer);
 
     for (int i=0; i<m_opaqueBatches.size(); ++i)
         m_opaqueBatches.at(i)->cleanupRemovedElements();
@@ -3610,8 +3651,10 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     if (m_rebuild & BuildBatches) {
         prepareOpaqueBatches();
         if (Q_UNLIKELY(debug_render())) ctx->timePrepareOpaque = ctx->timer.restart();
+        if (Q_UNLIKELY(m_frameStatsEnabled)) m_frameStats.prepareOpaqueBatchesTime = qsg_lapNsecs(&statsTimer);
         prepareAlphaBatches();
         if (Q_UNLIKELY(debug_render())) ctx->timePrepareAlpha = ctx->timer.restart();
+        if (Q_UNLIKELY(m_frameStatsEnabled)) m_frameStats.prepareAlphaBatchesTime = qsg_lapNsecs(&statsTimer);
 
         if (Q_UNLIKELY(debug_build())) {
             qDebug("Opaque Batches:");
@@ -3654,6 +3697,7 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     }
 
     if (Q_UNLIKELY(debug_render())) ctx->timeSorting = ctx->timer.restart();
+    if (Q_UNLIKELY(m_frameStatsEnabled)) m_frameStats.sortTime = qsg_lapNsecs(&statsTimer);
 
     quint32 largestVBO = 0;
     quint32 largestIBO = 0;
@@ -3675,6 +3719,11 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
         largestIBO = qMax(b->ibo.size, largestIBO);
     }
     if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
+    if (Q_UNLIKELY(m_frameStatsEnabled)) {
+        m_frameStats.uploadTime = qsg_lapNsecs(&statsTimer);
+        m_frameStats.opaqueBatchCount = m_opaqueBatches.size();
+        m_frameStats.alphaBatchCount = m_alphaBatches.size();
+    }
 
     m_vertexUploadPool.resize(largestVBO);
     m_indexUploadPool.resize(largestIBO);
@@ -3772,6 +3821,9 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     m_renderOrderRebuildUpper = -1;
 #endif
 
+    if (Q_UNLIKELY(m_frameStatsEnabled))
+        m_frameStats.prepareRenderBatchesTime = qsg_lapNsecs(&statsTimer);
+
     if (m_visualizer->mode() != Visualizer::VisualizeNothing)
         m_visualizer->prepareVisualize();
 
@@ -3810,6 +3862,10 @@ void Renderer::recordRenderPass(RenderPassContext *ctx)
 
     ctx->valid = false;
 
+    QElapsedTimer statsTimer;
+    if (Q_UNLIKELY(m_frameStatsEnabled))
+        statsTimer.start();
+
     QRhiCommandBuffer *cb = renderTarget().cb;
     cb->debugMarkBegin(QByteArrayLiteral("Qt Quick scene render"));
 
@@ -3847,6 +3903,9 @@ void Renderer::recordRenderPass(RenderPassContext *ctx)
 
     cb->debugMarkEnd();
 
+    if (Q_UNLIKELY(m_frameStatsEnabled))
+        m_frameStats.recordTime = statsTimer.nsecsElapsed();
+
     if (Q_UNLIKELY(debug_render())) {
         qDebug(" -> times: build: %d, prepare(opaque/alpha): %d/%d, sorting: %d, upload(opaque/alpha): %d/%d, record rendering: %d",
                (int) ctx->timeRenderLists,
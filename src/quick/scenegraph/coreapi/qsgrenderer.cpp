@@ -208,6 +208,14 @@ void QSGRenderer::preprocess()
 
     m_is_preprocessing = true;
 
+    // preprocess() starts every frame, both for renderScene() and the inline
+    // variant, so this is where the previous frame's stats get reset.
+    QElapsedTimer statsTimer;
+    if (m_frameStatsEnabled) {
+        m_frameStats = QSGRendererFrameStats();
+        statsTimer.start();
+    }
+
     QSGRootNode *root = rootNode();
     Q_ASSERT(root);
 
@@ -231,6 +239,8 @@ void QSGRenderer::preprocess()
         }
     }
 
+    if (m_frameStatsEnabled)
+        m_frameStats.preprocessTime = statsTimer.nsecsElapsed();
     bool profileFrames = QSG_LOG_TIME_RENDERER().isDebugEnabled();
     if (profileFrames)
         preprocessTime = frameTimer.nsecsElapsed();
@@ -241,6 +251,9 @@ void QSGRenderer::preprocess()
 
     nodeUpdater()->updateStates(root);
 
+    if (m_frameStatsEnabled)
+        m_frameStats.updatePassTime = statsTimer.nsecsElapsed() - m_frameStats.preprocessTime;
+
     if (profileFrames)
         updatePassTime = frameTimer.nsecsElapsed();
     Q_TRACE(QSG_update_exit);
@@ -55,6 +55,31 @@ public:
     QPaintDevice *paintDevice = nullptr;
 };
 
+// CPU time spent by the renderer in the various stages of the last frame.
+// Times are in nanoseconds. Only collected while enabled via
+// QSGRenderer::setFrameStatsEnabled().
+struct QSGRendererFrameStats
+{
+    qint64 preprocessTime = 0;
+    qint64 updatePassTime = 0;
+    qint64 buildRenderListsTime = 0;
+    qint64 prepareOpaqueBatchesTime = 0;
+    qint64 prepareAlphaBatchesTime = 0;
+    qint64 sortTime = 0;
+    qint64 uploadTime = 0;
+    // preparing draw calls; includes the material and pipeline times below
+    qint64 prepareRenderBatchesTime = 0;
+    qint64 materialUpdateTime = 0;
+    qint64 pipelineCreationTime = 0;
+    qint64 recordTime = 0;
+
+    qint64 uploadedBytes = 0;
+    int opaqueBatchCount = 0;
+    int alphaBatchCount = 0;
+    int pipelineCreationCount = 0;
+    int drawCallCount = 0;
+};
+
 class Q_QUICK_PRIVATE_EXPORT QSGRenderer : public QSGAbstractRenderer
 {
 public:
@@ -87,6 +112,10 @@ public:
 
     void clearChangedFlag() { m_changed_emitted = false; }
 
+    void setFrameStatsEnabled(bool enabled) { m_frameStatsEnabled = enabled; }
+    bool frameStatsEnabled() const { return m_frameStatsEnabled; }
+    const QSGRendererFrameStats &frameStats() const { return m_frameStats; }
+
     // Accessed by QSGMaterialShader::RenderState.
     QByteArray *currentUniformData() const { return m_current_uniform_data; }
     QRhiResourceUpdateBatch *currentResourceUpdateBatch() const { return m_current_resource_update_batch; }
@@ -128,6 +157,8 @@ protected:
     QRhiResourceUpdateBatch *m_current_resource_update_batch;
     QRhi *m_rhi;
     QSGRenderTarget m_rt;
+    QSGRendererFrameStats m_frameStats;
+    bool m_frameStatsEnabled = false;
     struct {
         QSGRenderContext::RenderPassCallback start = nullptr;
         QSGRenderContext::RenderPassCallback end = nullptr;
@@ -13,6 +13,10 @@
 
 #include <private/qquickprofiler_p.h>
 #include <QElapsedTimer>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvarlengtharray.h>
 
 #include <qtquick_tracepoints_p.h>
 
@@ -20,6 +24,33 @@ QT_BEGIN_NAMESPACE
 
 static QElapsedTimer qsg_render_timer;
 
+// Below this many glyphs per thread it is not worth handing work to the pool.
+#define QSG_DISTANCEFIELD_MIN_GLYPHS_PER_THREAD 8
+
+static int qsg_distanceFieldThreadCount()
+{
+    static const int count = [] {
+        bool ok = false;
+        const int n = qEnvironmentVariableIntValue("QSG_DISTANCEFIELD_THREADS", &ok);
+        return ok ? qMax(1, n) : QThread::idealThreadCount();
+    }();
+    return count;
+}
+
+namespace {
+class QSGDistanceFieldThreadPool : public QThreadPool
+{
+public:
+    QSGDistanceFieldThreadPool()
+    {
+        setObjectName(QLatin1String("QSGDistanceFieldThreadPool"));
+        setMaxThreadCount(qMax(1, qsg_distanceFieldThreadCount() - 1));
+    }
+};
+}
+
+Q_GLOBAL_STATIC(QSGDistanceFieldThreadPool, qsg_distanceFieldThreadPool)
+
 QSGDistanceFieldGlyphCache::Texture QSGDistanceFieldGlyphCache::s_emptyTexture;
 
 QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font, int renderTypeQuality)
@@ -154,17 +185,51 @@ void QSGDistanceFieldGlyphCache::update()
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphAdaptationLayerFrame);
     Q_TRACE(QSGDistanceFieldGlyphCache_glyphRender_entry);
 
-    QList<QDistanceField> distanceFields;
     const int pendingGlyphsSize = m_pendingGlyphs.size();
-    distanceFields.reserve(pendingGlyphsSize);
+    QVarLengthArray<QPainterPath, 64> paths(pendingGlyphsSize);
     for (int i = 0; i < pendingGlyphsSize; ++i) {
         GlyphData &gd = glyphData(m_pendingGlyphs.at(i));
-        distanceFields.append(QDistanceField(gd.path,
-                                             m_pendingGlyphs.at(i),
-                                             m_doubleGlyphResolution));
+        paths[i] = gd.path;
         gd.path = QPainterPath(); // no longer needed, so release memory used by the painter path
     }
 
+    QList<QDistanceField> distanceFields(pendingGlyphsSize);
+    {
+        // Rendering a distance field is pure computation on the glyph's path,
+        // so large batches (e.g. a screen of previously unseen CJK text) are
+        // split up and rendered in parallel. The render thread takes the first
+        // chunk itself and then waits for the rest.
+        QDistanceField *fields = distanceFields.data();
+        const QPainterPath *glyphPaths = paths.constData();
+        const glyph_t *glyphs = m_pendingGlyphs.data();
+        const bool doubleResolution = m_doubleGlyphResolution;
+        auto renderRange = [=](int from, int to) {
+            for (int i = from; i < to; ++i)
+                fields[i] = QDistanceField(glyphPaths[i], glyphs[i], doubleResolution);
+        };
+
+        const int threadCount = qBound(1,
+                                       pendingGlyphsSize / QSG_DISTANCEFIELD_MIN_GLYPHS_PER_THREAD,
+                                       qsg_distanceFieldThreadCount());
+        if (threadCount > 1) {
+            const int chunkSize = (pendingGlyphsSize + threadCount - 1) / threadCount;
+            QSemaphore done;
+            int pooledChunks = 0;
+            for (int from = chunkSize; from < pendingGlyphsSize; from += chunkSize) {
+                const int to = qMin(from + chunkSize, pendingGlyphsSize);
+                qsg_distanceFieldThreadPool()->start([&done, renderRange, from, to] {
+                    renderRange(from, to);
+                    done.release();
+                });
+                ++pooledChunks;
+            }
+            renderRange(0, qMin(chunkSize, pendingGlyphsSize));
+            done.acquire(pooledChunks);
+        } else {
+            renderRange(0, pendingGlyphsSize);
+        }
+    }
+
     qint64 renderTime = 0;
     int count = m_pendingGlyphs.size();
     if (profileFrames)
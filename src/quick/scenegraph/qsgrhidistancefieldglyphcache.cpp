@@ -5,7 +5,11 @@
 #include "qsgcontext_p.h"
 #include "qsgdefaultrendercontext_p.h"
 #include <QtGui/private/qdistancefield_p.h>
+#include <QtGui/private/qfontengine_p.h>
+#include <QtGui/private/qrawfont_p.h>
 #include <QtCore/qelapsedtimer.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
 #include <QtQml/private/qqmlglobal_p.h>
 #include <qmath.h>
 #include <qendian.h>
@@ -276,6 +280,7 @@ namespace {
         // file format
         enum TableSize {
             HeaderSize = 14,
+            IdentitySize = 20,
             GlyphRecordSize = 46,
             TextureRecordSize = 17
         };
@@ -321,6 +326,113 @@ namespace {
     };
 }
 
+/*
+    Prebuilt distance field tables can also be shipped next to the
+    application instead of being embedded into the font file. The file name
+    is derived from the family and style name of the font, for example
+    "noto_sans_cjk_sc_regular.qtdf", and is looked up in the directories
+    listed in QSG_DISTANCEFIELD_ATLAS_PATH followed by the resource directory
+    :/qt-project.org/distancefields. The qmldistancefieldgen tool generates
+    such files.
+
+    Unlike a table embedded in the font, a standalone file can end up next to
+    a different version of the font. The file therefore starts with an
+    identity block (see pregeneratedCacheIdentity()) that is compared with
+    the font before the qtdf table that follows it is used.
+ */
+QString QSGRhiDistanceFieldGlyphCache::pregeneratedCacheFileName(const QRawFont &font)
+{
+    QString fileName = font.familyName();
+    if (!font.styleName().isEmpty())
+        fileName += QLatin1Char('_') + font.styleName();
+    fileName = fileName.toLower();
+    for (QChar &c : fileName) {
+        if (!c.isLetterOrNumber())
+            c = QLatin1Char('_');
+    }
+    return fileName + QLatin1String(".qtdf");
+}
+
+/*
+    The identity block of a standalone qtdf file, all values big endian:
+
+    magic "QTDF" (4 bytes), identity version (quint16), units per em (quint16),
+    glyph count (quint32), font revision and checkSumAdjustment from the
+    font's head table (quint32 each). checkSumAdjustment covers the whole
+    font file, so any other build of the font is rejected.
+ */
+QByteArray QSGRhiDistanceFieldGlyphCache::pregeneratedCacheIdentity(const QRawFont &font)
+{
+    const QByteArray head = font.fontTable("head");
+    const quint32 fontRevision = head.size() >= 8 ? qFromBigEndian<quint32>(head.constData() + 4) : 0;
+    const quint32 checkSumAdjustment = head.size() >= 12 ? qFromBigEndian<quint32>(head.constData() + 8) : 0;
+    const QFontEngine *fontEngine = QRawFontPrivate::get(font)->fontEngine;
+
+    QByteArray identity("QTDF", 4);
+    identity.resize(Qtdf::IdentitySize);
+    char *data = identity.data();
+    qToBigEndian<quint16>(1, data + 4);
+    qToBigEndian<quint16>(quint16(font.unitsPerEm()), data + 6);
+    qToBigEndian<quint32>(fontEngine ? quint32(fontEngine->glyphCount()) : 0, data + 8);
+    qToBigEndian<quint32>(fontRevision, data + 12);
+    qToBigEndian<quint32>(checkSumAdjustment, data + 16);
+    return identity;
+}
+
+QByteArray QSGRhiDistanceFieldGlyphCache::readPregeneratedCacheFile(const QString &fileName, const QRawFont &font)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning("Failed to open distance field atlas '%s'", qPrintable(fileName));
+        return QByteArray();
+    }
+
+    const QByteArray identity = file.read(Qtdf::IdentitySize);
+    if (identity != pregeneratedCacheIdentity(font)) {
+        qWarning("Distance field atlas '%s' was not generated for this version of font '%s', ignoring it",
+                 qPrintable(fileName), qPrintable(font.familyName()));
+        return QByteArray();
+    }
+
+    return file.readAll();
+}
+
+static QByteArray qsg_loadPregeneratedCacheFile(const QRawFont &font)
+{
+    // File name -> path of the first match in the search paths, listed once
+    // instead of probing every directory for every font.
+    static const QHash<QString, QString> atlasFiles = [] {
+        QStringList searchPaths = qEnvironmentVariable("QSG_DISTANCEFIELD_ATLAS_PATH")
+                                    .split(QDir::listSeparator(), Qt::SkipEmptyParts);
+        searchPaths.append(QStringLiteral(":/qt-project.org/distancefields"));
+
+        QHash<QString, QString> files;
+        for (const QString &path : std::as_const(searchPaths)) {
+            const QDir dir(path);
+            const QStringList entries = dir.entryList({ QStringLiteral("*.qtdf") }, QDir::Files);
+            for (const QString &entry : entries) {
+                if (!files.contains(entry))
+                    files.insert(entry, dir.filePath(entry));
+            }
+        }
+        return files;
+    }();
+
+    if (atlasFiles.isEmpty())
+        return QByteArray();
+
+    const QString filePath = atlasFiles.value(QSGRhiDistanceFieldGlyphCache::pregeneratedCacheFileName(font));
+    if (filePath.isEmpty())
+        return QByteArray();
+
+    const QByteArray table = QSGRhiDistanceFieldGlyphCache::readPregeneratedCacheFile(filePath, font);
+    if (!table.isEmpty()) {
+        qCDebug(QSG_LOG_INFO, "Using distance field atlas %s for font '%s'",
+                qPrintable(filePath), qPrintable(font.familyName()));
+    }
+    return table;
+}
+
 bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
 {
     // The pregenerated data must be loaded first, otherwise the area allocator
@@ -337,6 +449,8 @@ bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
         timer.start();
 
     QByteArray qtdfTable = font.fontTable("qtdf");
+    if (qtdfTable.isEmpty())
+        qtdfTable = qsg_loadPregeneratedCacheFile(font);
     if (qtdfTable.isEmpty())
         return false;
 
@@ -47,6 +47,10 @@ public:
     bool eightBitFormatIsAlphaSwizzled() const override;
     bool screenSpaceDerivativesSupported() const override;
 
+    static QString pregeneratedCacheFileName(const QRawFont &font);
+    static QByteArray pregeneratedCacheIdentity(const QRawFont &font);
+    static QByteArray readPregeneratedCacheFile(const QString &fileName, const QRawFont &font);
+
 #if defined(QSG_DISTANCEFIELD_CACHE_DEBUG)
     void saveTexture(QRhiTexture *texture, const QString &nameBase) const override;
 #endif
@@ -155,11 +155,14 @@ public:
         , dpr(float(c->effectiveDevicePixelRatio()))
         , syncInExpose(inExpose)
         , forceRenderPass(force)
-    {}
+    {
+        postedTimer.start();
+    }
     QSize size;
     float dpr;
     bool syncInExpose;
     bool forceRenderPass;
+    QElapsedTimer postedTimer;
 };
 
 
@@ -312,6 +315,16 @@ public:
 
     QElapsedTimer m_threadTimeBetweenRenders;
 
+    // Started when the GUI thread posted the last WM_RequestSync, and when
+    // the render thread finished its last frame. If that frame ended after the
+    // request was posted, the difference is how long the GUI thread waited for
+    // the render thread to become idle. Time the request spent in the event
+    // queue afterwards is not counted. Only valid while the GUI thread is
+    // locked for sync.
+    QElapsedTimer syncRequestTimer;
+    QElapsedTimer frameEndTimer;
+    qint64 syncStallTime = 0;
+
     QQuickWindow *window; // Will be 0 when window is not exposed
     QSize windowSize;
     float dpr = 1;
@@ -353,6 +366,7 @@ bool QSGRenderThread::event(QEvent *e)
         window = se->window;
         windowSize = se->size;
         dpr = se->dpr;
+        syncRequestTimer = se->postedTimer;
 
         pendingUpdate |= SyncRequest;
         if (se->syncInExpose) {
@@ -526,6 +540,10 @@ void QSGRenderThread::sync(bool inExpose)
 
     Q_ASSERT_X(wm->m_lockedForSync, "QSGRenderThread::sync()", "sync triggered on bad terms as gui is not already locked...");
 
+    syncStallTime = 0;
+    if (syncRequestTimer.isValid() && frameEndTimer.isValid())
+        syncStallTime = qMax<qint64>(0, syncRequestTimer.nsecsElapsed() - frameEndTimer.nsecsElapsed());
+
     bool canSync = true;
     if (rhi) {
         if (windowSize.width() > 0 && windowSize.height() > 0) {
@@ -802,6 +820,8 @@ void QSGRenderThread::syncAndRender()
                 int((threadTimer.nsecsElapsed() - renderTime) / 1000000));
     }
 
+    frameEndTimer.start();
+
     Q_TRACE(QSG_swap_exit);
     Q_QUICK_SG_PROFILE_END(QQuickProfiler::SceneGraphRenderLoopFrame,
                            QQuickProfiler::SceneGraphRenderLoopSwap);
@@ -1588,6 +1608,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
 
     w->thread->waitCondition.wait(&w->thread->mutex);
     m_lockedForSync = false;
+    const qint64 stallTime = w->thread->syncStallTime;
     w->thread->mutex.unlock();
     qCDebug(QSG_LOG_RENDERLOOP, "- unlock after sync");
 
@@ -1627,11 +1648,15 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     }
 
     if (profileFrames) {
-        qCDebug(QSG_LOG_TIME_RENDERLOOP, "[window %p][gui thread] Frame prepared, polish=%d ms, lock=%d ms, blockedForSync=%d ms, animations=%d ms",
+        // renderThreadStall is the part of blockedForSync during which the
+        // render thread was still busy with the previous frame. A consistently
+        // high stall means the render thread is the bottleneck.
+        qCDebug(QSG_LOG_TIME_RENDERLOOP, "[window %p][gui thread] Frame prepared, polish=%d ms, lock=%d ms, blockedForSync=%d ms (renderThreadStall=%d ms), animations=%d ms",
                 window,
                 int(polishTime / 1000000),
                 int((waitTime - polishTime) / 1000000),
                 int((syncTime - waitTime) / 1000000),
+                int(stallTime / 1000000),
                 int((timer.nsecsElapsed() - syncTime) / 1000000));
     }
 
@@ -50,6 +50,7 @@ Manager::Manager(QSGDefaultRenderContext *rc, const QSize &surfacePixelSize, QSu
 
     m_atlas_size_limit = qt_sg_envInt("QSG_ATLAS_SIZE_LIMIT", qMax(w, h) / 2);
     m_atlas_size = QSize(w, h);
+    m_max_retired_atlases = qMax(0, qt_sg_envInt("QSG_ATLAS_MAX_RETIRED", 1));
 
     qCDebug(QSG_LOG_INFO, "rhi texture atlas dimensions: %dx%d", w, h);
 }
@@ -57,6 +58,7 @@ Manager::Manager(QSGDefaultRenderContext *rc, const QSize &surfacePixelSize, QSu
 Manager::~Manager()
 {
     Q_ASSERT(m_atlas == nullptr);
+    Q_ASSERT(m_retired_atlases.isEmpty());
     Q_ASSERT(m_atlases.isEmpty());
 }
 
@@ -68,6 +70,12 @@ void Manager::invalidate()
         m_atlas = nullptr;
     }
 
+    for (Atlas *atlas : std::as_const(m_retired_atlases)) {
+        atlas->invalidate();
+        atlas->deleteLater();
+    }
+    m_retired_atlases.clear();
+
     QHash<unsigned int, QSGCompressedAtlasTexture::Atlas*>::iterator i = m_atlases.begin();
     while (i != m_atlases.end()) {
         i.value()->invalidate();
@@ -81,15 +89,47 @@ QSGTexture *Manager::create(const QImage &image, bool hasAlphaChannel)
 {
     Texture *t = nullptr;
     if (image.width() < m_atlas_size_limit && image.height() < m_atlas_size_limit) {
+        releaseDrainedAtlases();
         if (!m_atlas)
             m_atlas = new Atlas(m_rc, m_atlas_size);
         t = m_atlas->create(image);
+        // The allocator never compacts, so an atlas in which textures keep
+        // coming and going ends up too fragmented to take new ones. Live
+        // textures cannot be moved since nodes have already baked their
+        // texture coordinates into the geometry, so instead stop using the
+        // atlas and let it drain, while new textures go into a fresh one.
+        if (!t && m_atlas->textureCount() > 0 && m_retired_atlases.size() < m_max_retired_atlases) {
+            qCDebug(QSG_LOG_INFO, "rhi texture atlas %p full at %d%% occupancy with %d textures, starting a new one",
+                    m_atlas, qRound(m_atlas->occupancy() * 100), m_atlas->textureCount());
+            m_retired_atlases.append(m_atlas);
+            // Textures are typically destroyed while the scene graph is being
+            // synchronized, so defer the release instead of doing it from
+            // within the texture's destructor.
+            connect(m_atlas, &AtlasBase::drained, this, &Manager::releaseDrainedAtlases, Qt::QueuedConnection);
+            m_atlas = new Atlas(m_rc, m_atlas_size);
+            t = m_atlas->create(image);
+        }
         if (t && !hasAlphaChannel && t->hasAlphaChannel())
             t->setHasAlphaChannel(false);
     }
     return t;
 }
 
+void Manager::releaseDrainedAtlases()
+{
+    for (auto it = m_retired_atlases.begin(); it != m_retired_atlases.end(); ) {
+        Atlas *atlas = *it;
+        if (atlas->textureCount() == 0) {
+            qCDebug(QSG_LOG_INFO, "rhi texture atlas %p drained, releasing", atlas);
+            atlas->invalidate();
+            atlas->deleteLater();
+            it = m_retired_atlases.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 QSGTexture *Manager::create(const QSGCompressedTextureFactory *factory)
 {
     QSGTexture *t = nullptr;
@@ -155,6 +195,10 @@ void AtlasBase::remove(TextureBase *t)
     QRect atlasRect = t->atlasSubRect();
     m_allocator.deallocate(atlasRect);
     m_pending_uploads.removeOne(t);
+    --m_texture_count;
+    m_used_area -= qint64(atlasRect.width()) * atlasRect.height();
+    if (m_texture_count == 0)
+        emit drained();
 }
 
 Atlas::Atlas(QSGDefaultRenderContext *rc, const QSize &size)
@@ -311,6 +355,8 @@ TextureBase::TextureBase(AtlasBase *atlas, const QRect &textureRect)
     , m_allocated_rect(textureRect)
     , m_atlas(atlas)
 {
+    ++atlas->m_texture_count;
+    atlas->m_used_area += qint64(textureRect.width()) * textureRect.height();
 }
 
 TextureBase::~TextureBase()
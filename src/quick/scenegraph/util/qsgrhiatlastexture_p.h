@@ -50,9 +50,14 @@ public:
     void invalidate();
 
 private:
+    void releaseDrainedAtlases();
+
     QSGDefaultRenderContext *m_rc;
     QRhi *m_rhi;
     Atlas *m_atlas = nullptr;
+    // full atlases no longer allocated from, released once empty
+    QVector<Atlas *> m_retired_atlases;
+    int m_max_retired_atlases;
     // set of atlases for different compressed formats
     QHash<unsigned int, QSGCompressedAtlasTexture::Atlas*> m_atlases;
 
@@ -76,6 +81,12 @@ public:
     QRhiTexture *texture() const { return m_texture; }
     QSize size() const { return m_size; }
 
+    int textureCount() const { return m_texture_count; }
+    qreal occupancy() const { return m_used_area / qreal(qint64(m_size.width()) * m_size.height()); }
+
+Q_SIGNALS:
+    void drained();
+
 protected:
     virtual bool generateTexture() = 0;
     virtual void enqueueTextureUpload(TextureBase *t, QRhiResourceUpdateBatch *resourceUpdates) = 0;
@@ -92,6 +103,8 @@ protected:
 
 private:
     bool m_allocated = false;
+    int m_texture_count = 0;
+    qint64 m_used_area = 0;
 };
 
 class Atlas : public AtlasBase
@@ -40,6 +40,8 @@ extern Q_GUI_EXPORT bool qt_sendShortcutOverrideEvent(QObject *o, ulong timestam
 
 bool QQuickDeliveryAgentPrivate::subsceneAgentsExist(false);
 QQuickDeliveryAgent *QQuickDeliveryAgentPrivate::currentEventDeliveryAgent(nullptr);
+bool QQuickDeliveryAgentPrivate::pointerBoundsIndexEnabled =
+        qEnvironmentVariableIntValue("QT_QUICK_POINTER_BOUNDS_INDEX") != 0;
 
 static bool allowSyntheticRightClick()
 {
@@ -53,6 +55,7 @@ static bool allowSyntheticRightClick()
     return allowRightClick != 0;
 }
 
+
 void QQuickDeliveryAgentPrivate::touchToMouseEvent(QEvent::Type type, const QEventPoint &p, const QTouchEvent *touchEvent, QMutableSinglePointEvent *mouseEvent)
 {
     Q_ASSERT(QCoreApplication::testAttribute(Qt::AA_SynthesizeMouseForUnhandledTouchEvents));
@@ -1012,6 +1015,18 @@ bool QQuickDeliveryAgentPrivate::deliverHoverEvent(
     currentHoverId++;
 
     if (subtreeHoverEnabled) {
+        // Subtrees that still contain a hovered item must be visited even if
+        // the pointer left their bounds, so that the leave is sent in order.
+        hoveredAncestors.clear();
+        if (usePointerBoundsIndex()) {
+            for (auto it = hoverItems.cbegin(); it != hoverItems.cend(); ++it) {
+                for (QQuickItem *item = it.key().data(); item && it.value() != 0; item = item->parentItem()) {
+                    if (hoveredAncestors.contains(item))
+                        break;
+                    hoveredAncestors.insert(item);
+                }
+            }
+        }
         hoveredLeafItemFound = false;
         deliverHoverEventRecursive(rootItem, scenePos, lastScenePos, modifiers, timestamp);
     }
@@ -1083,6 +1098,11 @@ bool QQuickDeliveryAgentPrivate::deliverHoverEventRecursive(
     const QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
     const QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
 
+    const bool useBoundsIndex = usePointerBoundsIndex();
+    QPointF itemPos;
+    if (useBoundsIndex && !children.isEmpty())
+        itemPos = item->mapFromScene(scenePos);
+
     for (int ii = children.size() - 1; ii >= 0; --ii) {
         QQuickItem *child = children.at(ii);
         const QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
@@ -1091,6 +1111,9 @@ bool QQuickDeliveryAgentPrivate::deliverHoverEventRecursive(
             continue;
         if (!childPrivate->subtreeHoverEnabled)
             continue;
+        if (useBoundsIndex && !hoveredAncestors.contains(child)
+                && !pointerBoundsContain(child, itemPos))
+            continue;
         if (childPrivate->flags & QQuickItem::ItemClipsChildrenToShape) {
             const QPointF localPos = child->mapFromScene(scenePos);
             if (!child->contains(localPos))
@@ -1911,12 +1934,15 @@ QVector<QQuickItem *> QQuickDeliveryAgentPrivate::pointerTargets(QQuickItem *ite
         children.insert(it, item);
     }
 
+    const bool useBoundsIndex = usePointerBoundsIndex();
     for (int ii = children.size() - 1; ii >= 0; --ii) {
         QQuickItem *child = children.at(ii);
         auto childPrivate = QQuickItemPrivate::get(child);
         if (!child->isVisible() || !child->isEnabled() || childPrivate->culled ||
                 (child != item && childPrivate->extra.isAllocated() && childPrivate->extra->subsceneDeliveryAgent))
             continue;
+        if (child != item && useBoundsIndex && !pointerBoundsContain(child, itemPos))
+            continue;
 
         if (child != item)
             targets << pointerTargets(child, event, point, checkMouseButtons, checkAcceptsTouch);
@@ -1927,6 +1953,102 @@ QVector<QQuickItem *> QQuickDeliveryAgentPrivate::pointerTargets(QQuickItem *ite
     return targets;
 }
 
+bool QQuickDeliveryAgentPrivate::usePointerBoundsIndex() const
+{
+    // A subscene's scene positions are not in its window's coordinates
+    return pointerBoundsIndexEnabled && !isSubsceneAgent && !sceneTransform
+            && rootItem && rootItem->window();
+}
+
+/*! \internal
+    Returns \c false if neither \a child nor any of its descendants can be hit
+    at \a parentPos, given in the coordinates of the child's parent item,
+    neither by QQuickItem::contains() nor by one of their pointer handlers.
+    A \c true result only means that they might be.
+
+    Each item caches the bounds of its subtree in its own coordinate system,
+    see QQuickItemPrivate::invalidatePointerBounds(). Moving an item therefore
+    only invalidates the item and its ancestors, and only those are measured
+    again, the next time the bounds are needed. Since the callers already
+    know the position in the parent's coordinates, only the child's own
+    transform is applied here rather than mapping from the scene again.
+*/
+bool QQuickDeliveryAgentPrivate::pointerBoundsContain(const QQuickItem *child, const QPointF &parentPos) const
+{
+    if (QQuickItemPrivate::get(rootItem)->pointerBoundsDirty)
+        updatePointerBounds(rootItem);
+
+    const QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
+    if (childPrivate->pointerBoundsDirty || childPrivate->extra->pointerBoundsUnbounded)
+        return true;
+
+    QTransform childToParent;
+    childPrivate->itemToParentTransform(childToParent);
+    bool invertible = false;
+    const QPointF childPos = childToParent.inverted(&invertible).map(parentPos);
+    // Pad by a pixel so that rounding never excludes a point on the edge.
+    return !invertible || childPrivate->extra->pointerBounds.adjusted(-1, -1, 1, 1).contains(childPos);
+}
+
+/*! \internal
+    Measures the bounds of \a item and of its visible descendants whose
+    bounds are out of date.
+
+    The bounds are conservative: items with a containment mask or with
+    pointer handlers other than HoverHandlers (which may want points far
+    outside, e.g. while grabbing) are treated as unbounded, and items that
+    clip their children limit their whole subtree to their own bounds, as
+    pointerTargets() and deliverHoverEventRecursive() do.
+*/
+void QQuickDeliveryAgentPrivate::updatePointerBounds(QQuickItem *item)
+{
+    QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
+    const bool masked = itemPrivate->extra.isAllocated() && itemPrivate->extra->mask;
+    bool unbounded = masked;
+    qreal margin = 0;
+    if (!unbounded && itemPrivate->hasPointerHandlers()) {
+        for (QQuickPointerHandler *handler : itemPrivate->extra->pointerHandlers) {
+            if (!qmlobject_cast<QQuickHoverHandler *>(handler)) {
+                unbounded = true;
+                break;
+            }
+            margin = qMax(margin, handler->margin());
+        }
+    }
+
+    const QRectF localRect(0, 0, item->width(), item->height());
+    QRectF bounds = localRect.adjusted(-margin, -margin, margin, margin);
+    const bool clips = itemPrivate->flags & QQuickItem::ItemClipsChildrenToShape;
+    for (QQuickItem *child : std::as_const(itemPrivate->childItems)) {
+        if (!child->isVisible())
+            continue;
+        QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
+        // Children of a clipping item are still visited by the delivery,
+        // so they need their own bounds even if they don't add to ours.
+        if (childPrivate->pointerBoundsDirty)
+            updatePointerBounds(child);
+        if (clips || unbounded)
+            continue;
+        if (childPrivate->extra->pointerBoundsUnbounded) {
+            unbounded = true;
+            continue;
+        }
+        QTransform childToItem;
+        childPrivate->itemToParentTransform(childToItem);
+        bounds = bounds.united(childToItem.mapRect(childPrivate->extra->pointerBounds));
+    }
+
+    if (clips) {
+        // Nothing inside can be hit outside of what contains() accepts.
+        unbounded = masked;
+        bounds = localRect;
+    }
+
+    itemPrivate->extra.value().pointerBounds = bounds;
+    itemPrivate->extra->pointerBoundsUnbounded = unbounded;
+    itemPrivate->pointerBoundsDirty = false;
+}
+
 // return the joined lists
 // list1 has priority, common items come last
 QVector<QQuickItem *> QQuickDeliveryAgentPrivate::mergePointerTargets(const QVector<QQuickItem *> &list1, const QVector<QQuickItem *> &list2) const
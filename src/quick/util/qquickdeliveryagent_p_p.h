@@ -17,6 +17,7 @@
 
 #include <QtQuick/private/qquickdeliveryagent_p.h>
 #include <QtGui/qevent.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 
 #include <private/qevent_p.h>
@@ -160,6 +161,15 @@ public:
                                          bool checkMouseButtons, bool checkAcceptsTouch) const;
     QVector<QQuickItem *> mergePointerTargets(const QVector<QQuickItem *> &list1, const QVector<QQuickItem *> &list2) const;
 
+    // Skip whole subtrees that a pointer cannot hit in pointerTargets()
+    // and hover delivery. Opt-in with QT_QUICK_POINTER_BOUNDS_INDEX.
+    static bool pointerBoundsIndexEnabled;
+    QSet<const QQuickItem *> hoveredAncestors;
+
+    bool usePointerBoundsIndex() const;
+    bool pointerBoundsContain(const QQuickItem *child, const QPointF &parentPos) const;
+    static void updatePointerBounds(QQuickItem *item);
+
     // hover delivery
     bool deliverHoverEvent(const QPointF &scenePos, const QPointF &lastScenePos, Qt::KeyboardModifiers modifiers, ulong timestamp);
     bool deliverHoverEventRecursive(QQuickItem *, const QPointF &scenePos, const QPointF &lastScenePos, Qt::KeyboardModifiers modifiers, ulong timestamp);
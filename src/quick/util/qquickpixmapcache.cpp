@@ -20,8 +20,12 @@
 
 #include <QtCore/private/qobject_p.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
 #include <QtCore/qthread.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qbuffer.h>
@@ -38,6 +42,8 @@
 #define IMAGEREQUEST_MAX_REDIRECT_RECURSION 16
 #define CACHE_EXPIRE_TIME 30
 #define CACHE_REMOVAL_FRACTION 4
+#define DISK_CACHE_MIN_IMAGE_BYTES (64 * 1024)
+#define DISK_CACHE_DEFAULT_SIZE_MB 256
 
 #define PIXMAP_PROFILE(Code) Q_QUICK_PROFILE(QQuickProfiler::ProfilePixmapCache, Code)
 
@@ -47,6 +53,14 @@
 #  define USE_THREADED_DOWNLOAD 0
 #endif
 
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#endif
+
+#if defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 const QLatin1String QQuickPixmap::itemGrabberScheme = QLatin1String("itemgrabber");
@@ -58,7 +72,7 @@ static const bool qsg_leak_check = !qEnvironmentVariableIsEmpty("QML_LEAK_CHECK"
 #endif
 
 // The cache limit describes the maximum "junk" in the cache.
-static int cache_limit = 2048 * 1024; // 2048 KB cache limit for embedded in qpixmapcache.cpp
+static const qint64 defaultCacheLimit = 2048 * 1024; // 2048 KB cache limit for embedded in qpixmapcache.cpp
 
 static inline QString imageProviderId(const QUrl &url)
 {
@@ -111,6 +125,7 @@ public:
     bool loading;
     QQuickImageProviderOptions providerOptions;
     int redirectCount;
+    QQuickPixmap::LoadPriority priority; // always access inside the reader's mutex
 
     class Event : public QEvent {
     public:
@@ -165,6 +180,7 @@ public:
 
     QQuickPixmapReply *getImage(QQuickPixmapData *);
     void cancel(QQuickPixmapReply *rep);
+    void setPriority(QQuickPixmapReply *rep, QQuickPixmap::LoadPriority priority);
 
     static QQuickPixmapReader *instance(QQmlEngine *engine);
     static QQuickPixmapReader *existingInstance(QQmlEngine *engine);
@@ -176,6 +192,9 @@ private:
     friend class QQuickPixmapReaderThreadObject;
     void processJobs();
     void processJob(QQuickPixmapReply *, const QUrl &, const QString &, QQuickImageProvider::ImageType, const QSharedPointer<QQuickImageProvider> &);
+#if USE_THREADED_DOWNLOAD
+    void startDecoding(QQuickPixmapReply *, const QUrl &, const QString &);
+#endif
 #if QT_CONFIG(qml_network)
     void networkRequestDone(QNetworkReply *);
 #endif
@@ -196,6 +215,14 @@ private:
 #endif
     QHash<QQuickImageResponse*,QQuickPixmapReply*> asyncResponses;
 
+#if USE_THREADED_DOWNLOAD
+    // Local files are decoded in parallel on decodePool. The value is true
+    // when the job was cancelled while decoding, in which case the decoding
+    // thread rather than processJobs() deletes it.
+    QThreadPool decodePool;
+    QHash<QQuickPixmapReply*,bool> decodingJobs;
+#endif
+
     static int replyDownloadProgress;
     static int replyFinished;
     static int downloadProgress;
@@ -301,6 +328,11 @@ public:
     QIODevice *specialDevice = nullptr;
     QQuickTextureFactory *textureFactory;
 
+    // Number of times this was found in the cache, decays when it survives eviction
+    int cacheHits = 0;
+    // What this contributes to QQuickPixmapStore::m_cachedCost
+    int cachedCost = 0;
+
     QIntrusiveList<QQuickPixmap, &QQuickPixmap::dataListNode> declarativePixmaps;
     QQuickPixmapReply *reply;
 
@@ -481,6 +513,350 @@ static QString existingImageFileForPath(const QString &localFile)
     return localFile;
 }
 
+// The optional disk cache keeps decoded images as raw pixel data, keyed by everything
+// that affects decoding, so that they can be memory mapped on later runs.
+static const char diskCacheMagic[4] = { 'Q', 'P', 'X', 'C' };
+static const quint32 diskCacheVersion = 1;
+
+struct QQuickPixmapDiskCacheHeader
+{
+    char magic[4];
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+    qint32 implicitWidth;
+    qint32 implicitHeight;
+    qint32 frameCount;
+    qint32 appliedTransform;
+    quint32 iccProfileSize;
+    quint32 dataOffset;
+};
+
+static QString diskCacheDirectory()
+{
+    static const QString directory = []() {
+        const QString path = qEnvironmentVariable("QML_PIXMAP_DISK_CACHE_PATH");
+        if (!path.isEmpty() && !QDir().mkpath(path)) {
+            qCWarning(lcImg) << "Cannot create the image disk cache directory" << path;
+            return QString();
+        }
+        return path;
+    }();
+    return directory;
+}
+
+static QString diskCacheFileName(const QString &fileName, const QRect &requestRegion, const QSize &requestSize,
+                                 const QQuickImageProviderOptions &providerOptions, int frame,
+                                 qreal devicePixelRatio)
+{
+    const QString directory = diskCacheDirectory();
+    if (directory.isEmpty())
+        return QString();
+
+    const QFileInfo info(fileName);
+    const QDateTime lastModified = info.lastModified();
+    if (!lastModified.isValid())
+        return QString();
+
+    QByteArray key;
+    QDataStream stream(&key, QIODevice::WriteOnly);
+    stream << info.absoluteFilePath() << lastModified.toMSecsSinceEpoch() << info.size()
+           << requestRegion << requestSize << frame << devicePixelRatio
+           << int(providerOptions.autoTransform())
+           << providerOptions.preserveAspectRatioCrop() << providerOptions.preserveAspectRatioFit()
+           << providerOptions.targetColorSpace().iccProfile();
+
+    const QByteArray hash = QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+    return directory + QLatin1Char('/') + QLatin1String(hash) + QLatin1String(".qpc");
+}
+
+struct QQuickPixmapDiskCacheMapping
+{
+    void *data;
+    size_t size;
+};
+
+static void unmapDiskCacheFile(void *mapping)
+{
+    auto *m = static_cast<QQuickPixmapDiskCacheMapping *>(mapping);
+#if defined(Q_OS_UNIX)
+    munmap(m->data, m->size);
+#else
+    ::free(m->data);
+#endif
+    delete m;
+}
+
+// Maps the whole file, or reads it into memory where mmap is not available. The file is
+// closed before returning: cached images are long-lived, and must not hold on to a file
+// descriptor each.
+static QQuickPixmapDiskCacheMapping *mapDiskCacheFile(const QString &cacheFileName)
+{
+    QFile file(cacheFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    const qint64 size = file.size();
+    if (size < qint64(sizeof(QQuickPixmapDiskCacheHeader)))
+        return nullptr;
+#if defined(Q_OS_UNIX)
+    void *data = mmap(nullptr, size_t(size), PROT_READ, MAP_PRIVATE, file.handle(), 0);
+    if (data == MAP_FAILED)
+        return nullptr;
+#else
+    void *data = ::malloc(size_t(size));
+    if (!data)
+        return nullptr;
+    if (file.read(static_cast<char *>(data), size) != size) {
+        ::free(data);
+        return nullptr;
+    }
+#endif
+
+    // Entries are evicted least recently used first, see trimDiskCache().
+    file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    return new QQuickPixmapDiskCacheMapping{ data, size_t(size) };
+}
+
+static bool readFromDiskCache(const QString &cacheFileName, QImage *image, QSize *implicitSize, int *frameCount,
+                              QQuickImageProviderOptions::AutoTransform *appliedTransform)
+{
+    QQuickPixmapDiskCacheMapping *mapping = mapDiskCacheFile(cacheFileName);
+    if (!mapping)
+        return false;
+
+    const uchar *data = static_cast<const uchar *>(mapping->data);
+    const qint64 size = qint64(mapping->size);
+    QQuickPixmapDiskCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, diskCacheMagic, sizeof(diskCacheMagic)) != 0
+            || header.version != diskCacheVersion
+            || header.format <= QImage::Format_Invalid || header.format >= QImage::NImageFormats
+            || header.width <= 0 || header.height <= 0
+            || header.bytesPerLine < (qint64(header.width) * QImage::toPixelFormat(QImage::Format(header.format)).bitsPerPixel() + 7) / 8
+            || header.dataOffset < sizeof(header) + header.iccProfileSize
+            || header.dataOffset + qint64(header.bytesPerLine) * header.height > size) {
+        qCDebug(lcImg) << "Removing invalid image disk cache file" << cacheFileName;
+        unmapDiskCacheFile(mapping);
+        QFile::remove(cacheFileName);
+        return false;
+    }
+
+    const QByteArray iccProfile(reinterpret_cast<const char *>(data + sizeof(header)), header.iccProfileSize);
+
+    // The image uses the mapped file directly, and unmaps it when it gets destroyed.
+    // Being read-only, it gets copied rather than written to should anyone modify it.
+    *image = QImage(data + header.dataOffset, header.width, header.height, header.bytesPerLine,
+                    QImage::Format(header.format), unmapDiskCacheFile, mapping);
+    if (!iccProfile.isEmpty())
+        image->setColorSpace(QColorSpace::fromIccProfile(iccProfile));
+    if (implicitSize)
+        *implicitSize = QSize(header.implicitWidth, header.implicitHeight);
+    if (frameCount)
+        *frameCount = header.frameCount;
+    if (appliedTransform)
+        *appliedTransform = QQuickImageProviderOptions::AutoTransform(header.appliedTransform);
+    return true;
+}
+
+static qint64 diskCacheSizeLimit()
+{
+    static const qint64 limit = []() {
+        bool ok = false;
+        const int megabytes = qEnvironmentVariableIntValue("QML_PIXMAP_DISK_CACHE_SIZE", &ok);
+        return qint64(ok && megabytes > 0 ? megabytes : DISK_CACHE_DEFAULT_SIZE_MB) * 1024 * 1024;
+    }();
+    return limit;
+}
+
+// Removes the least recently used entries once the cache has grown over its limit.
+// Only called when writing, which happens on a single thread.
+static void trimDiskCache(qint64 addedBytes)
+{
+    // The directory is only listed on the first write and when over the limit.
+    static qint64 usage = -1;
+    const qint64 limit = diskCacheSizeLimit();
+    if (usage >= 0) {
+        usage += addedBytes;
+        if (usage <= limit)
+            return;
+    }
+
+    const QDir directory(diskCacheDirectory());
+    const QFileInfoList entries = directory.entryInfoList({ QStringLiteral("*.qpc") }, QDir::Files,
+                                                          QDir::Time | QDir::Reversed);
+    usage = 0;
+    for (const QFileInfo &entry : entries)
+        usage += entry.size();
+    if (usage <= limit)
+        return;
+
+    // Make some room, so that the next writes do not trim again right away.
+    const qint64 target = limit - limit / CACHE_REMOVAL_FRACTION;
+    for (const QFileInfo &entry : entries) {
+        if (usage <= target)
+            break;
+        if (QFile::remove(entry.filePath()))
+            usage -= entry.size();
+    }
+    qCDebug(lcImg) << "Trimmed the image disk cache to" << usage << "bytes";
+}
+
+static void writeDiskCacheFile(const QString &cacheFileName, const QImage &decodedImage, const QSize &implicitSize,
+                               int frameCount, QQuickImageProviderOptions::AutoTransform appliedTransform)
+{
+    // Another load of the same image may have been written in the meantime.
+    if (QFile::exists(cacheFileName))
+        return;
+
+    // Store the format QQuickDefaultTextureFactory wants, so that the mapped
+    // image can be uploaded without another conversion.
+    QImage image = decodedImage;
+    if (image.format() != QImage::Format_ARGB32_Premultiplied && image.format() != QImage::Format_RGB32) {
+        image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                              : QImage::Format_RGB32);
+    }
+
+    const QByteArray iccProfile = image.colorSpace().isValid() ? image.colorSpace().iccProfile() : QByteArray();
+
+    QQuickPixmapDiskCacheHeader header;
+    memcpy(header.magic, diskCacheMagic, sizeof(diskCacheMagic));
+    header.version = diskCacheVersion;
+    header.width = image.width();
+    header.height = image.height();
+    header.bytesPerLine = image.bytesPerLine();
+    header.format = image.format();
+    header.implicitWidth = implicitSize.width();
+    header.implicitHeight = implicitSize.height();
+    header.frameCount = frameCount;
+    header.appliedTransform = appliedTransform;
+    header.iccProfileSize = iccProfile.size();
+    const qsizetype headerSize = sizeof(header) + iccProfile.size();
+    header.dataOffset = quint32((headerSize + 15) & ~15);
+
+    QSaveFile file(cacheFileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(iccProfile);
+    file.write(QByteArray(header.dataOffset - headerSize, 0));
+    file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+    if (!file.commit()) {
+        qCDebug(lcImg) << "Cannot write image disk cache file" << cacheFileName << file.errorString();
+        return;
+    }
+
+    trimDiskCache(header.dataOffset + image.sizeInBytes());
+}
+
+#if QT_CONFIG(thread)
+class QQuickPixmapDiskCacheWriter : public QThreadPool
+{
+public:
+    QQuickPixmapDiskCacheWriter()
+    {
+        // One thread, so that writes and trims do not race with each other.
+        setObjectName(QStringLiteral("QQuickPixmap disk cache writer"));
+        setMaxThreadCount(1);
+        setThreadPriority(QThread::LowestPriority);
+    }
+};
+Q_GLOBAL_STATIC(QQuickPixmapDiskCacheWriter, diskCacheWriter)
+#endif
+
+static void writeToDiskCache(const QString &cacheFileName, const QImage &decodedImage, const QSize &implicitSize,
+                             int frameCount, QQuickImageProviderOptions::AutoTransform appliedTransform)
+{
+    // Small images decode faster than they are looked up.
+    if (decodedImage.sizeInBytes() < DISK_CACHE_MIN_IMAGE_BYTES)
+        return;
+
+    // Converting and writing out the image is left to a background thread, so that
+    // synchronous loads on the GUI thread do not wait for it.
+#if QT_CONFIG(thread)
+    diskCacheWriter()->start([=] {
+        writeDiskCacheFile(cacheFileName, decodedImage, implicitSize, frameCount, appliedTransform);
+    });
+#else
+    writeDiskCacheFile(cacheFileName, decodedImage, implicitSize, frameCount, appliedTransform);
+#endif
+}
+
+struct QQuickPixmapReadResult
+{
+    QQuickPixmapReply::ReadError error = QQuickPixmapReply::NoError;
+    QString errorString;
+    QSize readSize;
+    int frameCount = -1;
+    QQuickTextureFactory *textureFactory = nullptr;
+};
+
+// Reads and decodes a local file. Does not touch the reply, so that it is safe
+// to call from any thread.
+static QQuickPixmapReadResult readLocalFile(const QUrl &url, const QString &localFile,
+                                            const QRect &requestRegion, const QSize &requestSize,
+                                            const QQuickImageProviderOptions &providerOptions,
+                                            int frame)
+{
+    QQuickPixmapReadResult result;
+    QImage image;
+
+    QFile f(existingImageFileForPath(localFile));
+    if (f.open(QIODevice::ReadOnly)) {
+        QSGTextureReader texReader(&f, localFile);
+        if (backendSupport()->hasOpenGL && texReader.isTexture()) {
+            result.textureFactory = texReader.read();
+            if (result.textureFactory) {
+                result.readSize = result.textureFactory->textureSize();
+            } else {
+                result.errorString = QQuickPixmap::tr("Error decoding: %1").arg(url.toString());
+                if (f.fileName() != localFile)
+                    result.errorString += QString::fromLatin1(" (%1)").arg(f.fileName());
+                result.error = QQuickPixmapReply::Decoding;
+            }
+            return result;
+        }
+
+        const QString cacheFileName = diskCacheFileName(f.fileName(), requestRegion, requestSize,
+                                                        providerOptions, frame, 1.0);
+        int frameCount;
+        if (!cacheFileName.isEmpty()
+                && readFromDiskCache(cacheFileName, &image, &result.readSize, &frameCount, nullptr)) {
+            result.frameCount = frameCount;
+        } else if (!readImage(url, &f, &image, &result.errorString, &result.readSize, &frameCount,
+                              requestRegion, requestSize, providerOptions, nullptr, frame)) {
+            result.error = QQuickPixmapReply::Loading;
+            if (f.fileName() != localFile)
+                result.errorString += QString::fromLatin1(" (%1)").arg(f.fileName());
+        } else {
+            result.frameCount = frameCount;
+            if (!cacheFileName.isEmpty()) {
+                writeToDiskCache(cacheFileName, image, result.readSize, frameCount,
+                                 QQuickImageProviderOptions::UsePluginDefaultTransform);
+            }
+        }
+    } else {
+        result.errorString = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
+        result.error = QQuickPixmapReply::Loading;
+    }
+
+    result.textureFactory = QQuickTextureFactory::textureFactoryForImage(image);
+    return result;
+}
+
+#if USE_THREADED_DOWNLOAD
+static int imageDecodingThreadCount()
+{
+    bool ok = false;
+    const int count = qEnvironmentVariableIntValue("QML_IMAGE_DECODING_THREADS", &ok);
+    if (ok && count > 0)
+        return count;
+    return qMax(1, QThread::idealThreadCount());
+}
+#endif
+
 QQuickPixmapReader::QQuickPixmapReader(QQmlEngine *eng)
 : QThread(eng), engine(eng)
 #if QT_CONFIG(qml_network)
@@ -491,6 +867,9 @@ QQuickPixmapReader::QQuickPixmapReader(QQmlEngine *eng)
     eventLoopQuitHack->moveToThread(this);
     connect(eventLoopQuitHack, SIGNAL(destroyed(QObject *)), SLOT(quit()), Qt::DirectConnection);
 #if USE_THREADED_DOWNLOAD
+    decodePool.setObjectName(QStringLiteral("QQuickPixmapReader decoder"));
+    decodePool.setMaxThreadCount(imageDecodingThreadCount());
+    decodePool.setThreadPriority(QThread::LowestPriority);
     start(QThread::LowestPriority);
 #else
     run(); // Call nonblocking run for ourselves.
@@ -503,8 +882,21 @@ QQuickPixmapReader::~QQuickPixmapReader()
     readers.remove(engine);
     readerMutex.unlock();
 
+#if USE_THREADED_DOWNLOAD
+    // Decodes that have not started yet are dropped with the outstanding jobs below.
+    decodePool.clear();
+    decodePool.waitForDone();
+#endif
+
     mutex.lock();
     // manually cancel all outstanding jobs.
+#if USE_THREADED_DOWNLOAD
+    for (auto it = decodingJobs.cbegin(), end = decodingJobs.cend(); it != end; ++it) {
+        cancelled.removeOne(it.key());
+        jobs.append(it.key());
+    }
+    decodingJobs.clear();
+#endif
     for (QQuickPixmapReply *reply : std::as_const(jobs)) {
         if (reply->data && reply->data->reply == reply)
             reply->data->reply = nullptr;
@@ -698,6 +1090,14 @@ void QQuickPixmapReader::processJobs()
                     }
                 }
                 PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingError>(job->url));
+#endif
+#if USE_THREADED_DOWNLOAD
+                // The decoding thread still uses it, and deletes it when done.
+                const auto decoding = decodingJobs.find(job);
+                if (decoding != decodingJobs.end()) {
+                    decoding.value() = true;
+                    continue;
+                }
 #endif
                 // deleteLater, since not owned by this thread
                 job->deleteLater();
@@ -706,43 +1106,56 @@ void QQuickPixmapReader::processJobs()
         }
 
         if (!jobs.isEmpty()) {
-            // Find a job we can use
+            // Find a job we can use. Jobs for visible images go first, and the
+            // most recent request first among jobs of the same priority.
             bool usableJob = false;
-            for (int i = jobs.size() - 1; !usableJob && i >= 0; i--) {
-                QQuickPixmapReply *job = jobs.at(i);
-                const QUrl url = job->url;
-                QString localFile;
-                QQuickImageProvider::ImageType imageType = QQuickImageProvider::Invalid;
-                QSharedPointer<QQuickImageProvider> provider;
-
-                if (url.scheme() == QLatin1String("image")) {
-                    QQmlEnginePrivate *enginePrivate = QQmlEnginePrivate::get(engine);
-                    provider = enginePrivate->imageProvider(imageProviderId(url)).staticCast<QQuickImageProvider>();
-                    if (provider)
-                        imageType = provider->imageType();
-
-                    usableJob = true;
-                } else {
-                    localFile = QQmlFile::urlToLocalFileOrQrc(url);
-                    usableJob = !localFile.isEmpty()
+            for (const auto priority : { QQuickPixmap::NormalPriority, QQuickPixmap::LowPriority }) {
+                for (int i = jobs.size() - 1; !usableJob && i >= 0; i--) {
+                    QQuickPixmapReply *job = jobs.at(i);
+                    if (job->priority != priority)
+                        continue;
+                    const QUrl url = job->url;
+                    QString localFile;
+                    QQuickImageProvider::ImageType imageType = QQuickImageProvider::Invalid;
+                    QSharedPointer<QQuickImageProvider> provider;
+
+                    if (url.scheme() == QLatin1String("image")) {
+                        QQmlEnginePrivate *enginePrivate = QQmlEnginePrivate::get(engine);
+                        provider = enginePrivate->imageProvider(imageProviderId(url)).staticCast<QQuickImageProvider>();
+                        if (provider)
+                            imageType = provider->imageType();
+
+                        usableJob = true;
+                    } else {
+                        localFile = QQmlFile::urlToLocalFileOrQrc(url);
+                        usableJob = !localFile.isEmpty()
 #if QT_CONFIG(qml_network)
-                            || networkJobs.size() < IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT
+                                || networkJobs.size() < IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT
 #endif
-                            ;
-                }
+                                ;
+#if USE_THREADED_DOWNLOAD
+                        // Only hand out as many files as there are decoding threads, so
+                        // that the rest can still be reprioritized.
+                        if (!localFile.isEmpty() && !(job->data && job->data->specialDevice))
+                            usableJob = decodingJobs.size() < decodePool.maxThreadCount();
+#endif
+                    }
 
 
-                if (usableJob) {
-                    jobs.removeAt(i);
+                    if (usableJob) {
+                        jobs.removeAt(i);
 
-                    job->loading = true;
+                        job->loading = true;
 
-                    PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingStarted>(url));
+                        PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingStarted>(url));
 
-                    locker.unlock();
-                    processJob(job, url, localFile, imageType, provider);
-                    locker.relock();
+                        locker.unlock();
+                        processJob(job, url, localFile, imageType, provider);
+                        locker.relock();
+                    }
                 }
+                if (usableJob)
+                    break;
             }
 
             if (!usableJob)
@@ -879,12 +1292,11 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     } else {
         if (!localFile.isEmpty()) {
             // Image is local - load/decode immediately
-            QImage image;
-            QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
-            QString errorStr;
-            QSize readSize;
-
             if (runningJob->data && runningJob->data->specialDevice) {
+                QImage image;
+                QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
+                QString errorStr;
+                QSize readSize;
                 int frameCount;
                 if (!readImage(url, runningJob->data->specialDevice, &image, &errorStr, &readSize, &frameCount,
                                runningJob->requestRegion, runningJob->requestSize,
@@ -893,47 +1305,29 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
                 } else if (runningJob->data) {
                     runningJob->data->frameCount = frameCount;
                 }
-            } else {
-                QFile f(existingImageFileForPath(localFile));
-                if (f.open(QIODevice::ReadOnly)) {
-                    QSGTextureReader texReader(&f, localFile);
-                    if (backendSupport()->hasOpenGL && texReader.isTexture()) {
-                        QQuickTextureFactory *factory = texReader.read();
-                        if (factory) {
-                            readSize = factory->textureSize();
-                        } else {
-                            errorStr = QQuickPixmap::tr("Error decoding: %1").arg(url.toString());
-                            if (f.fileName() != localFile)
-                                errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
-                            errorCode = QQuickPixmapReply::Decoding;
-                        }
-                        mutex.lock();
-                        if (!cancelled.contains(runningJob))
-                            runningJob->postReply(errorCode, errorStr, readSize, factory);
-                        mutex.unlock();
-                        return;
-                    } else {
-                        int frameCount;
-                        int const frame = runningJob->data ? runningJob->data->frame : 0;
-                        if (!readImage(url, &f, &image, &errorStr, &readSize, &frameCount,
-                                       runningJob->requestRegion, runningJob->requestSize,
-                                       runningJob->providerOptions, nullptr, frame)) {
-                            errorCode = QQuickPixmapReply::Loading;
-                            if (f.fileName() != localFile)
-                                errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
-                        } else if (runningJob->data) {
-                            runningJob->data->frameCount = frameCount;
-                        }
-                    }
-                } else {
-                    errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
-                    errorCode = QQuickPixmapReply::Loading;
-                }
+                mutex.lock();
+                if (!cancelled.contains(runningJob))
+                    runningJob->postReply(errorCode, errorStr, readSize, QQuickTextureFactory::textureFactoryForImage(image));
+                mutex.unlock();
+                return;
             }
+
+#if USE_THREADED_DOWNLOAD
+            startDecoding(runningJob, url, localFile);
+#else
+            int const frame = runningJob->data ? runningJob->data->frame : 0;
+            QQuickPixmapReadResult result = readLocalFile(url, localFile, runningJob->requestRegion,
+                                                          runningJob->requestSize,
+                                                          runningJob->providerOptions, frame);
+            if (result.frameCount >= 0 && runningJob->data)
+                runningJob->data->frameCount = result.frameCount;
             mutex.lock();
             if (!cancelled.contains(runningJob))
-                runningJob->postReply(errorCode, errorStr, readSize, QQuickTextureFactory::textureFactoryForImage(image));
+                runningJob->postReply(result.error, result.errorString, result.readSize, result.textureFactory);
+            else
+                delete result.textureFactory;
             mutex.unlock();
+#endif
         } else {
 #if QT_CONFIG(qml_network)
             // Network resource
@@ -952,6 +1346,45 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     }
 }
 
+#if USE_THREADED_DOWNLOAD
+void QQuickPixmapReader::startDecoding(QQuickPixmapReply *job, const QUrl &url, const QString &localFile)
+{
+    const int frame = job->data ? job->data->frame : 0;
+    const QRect requestRegion = job->requestRegion;
+    const QSize requestSize = job->requestSize;
+    const QQuickImageProviderOptions providerOptions = job->providerOptions;
+
+    mutex.lock();
+    decodingJobs.insert(job, false);
+    mutex.unlock();
+
+    decodePool.start([this, job, url, localFile, requestRegion, requestSize, providerOptions, frame] {
+        QMutexLocker locker(&mutex);
+        // Don't bother decoding images that were released while waiting for a thread.
+        const bool skip = decodingJobs.value(job) || cancelled.contains(job);
+        locker.unlock();
+
+        QQuickPixmapReadResult result;
+        if (!skip)
+            result = readLocalFile(url, localFile, requestRegion, requestSize, providerOptions, frame);
+
+        locker.relock();
+        if (decodingJobs.take(job)) {
+            delete result.textureFactory;
+            job->deleteLater();
+        } else if (cancelled.contains(job)) {
+            delete result.textureFactory;
+        } else {
+            if (result.frameCount >= 0 && job->data)
+                job->data->frameCount = result.frameCount;
+            job->postReply(result.error, result.errorString, result.readSize, result.textureFactory);
+        }
+        // a decoding thread is free again
+        threadObject->processJobs();
+    });
+}
+#endif
+
 QQuickPixmapReader *QQuickPixmapReader::instance(QQmlEngine *engine)
 {
     // XXX NOTE: must be called within readerMutex locking.
@@ -1001,6 +1434,12 @@ void QQuickPixmapReader::cancel(QQuickPixmapReply *reply)
     mutex.unlock();
 }
 
+void QQuickPixmapReader::setPriority(QQuickPixmapReply *reply, QQuickPixmap::LoadPriority priority)
+{
+    QMutexLocker locker(&mutex);
+    reply->priority = priority;
+}
+
 void QQuickPixmapReader::run()
 {
     if (replyDownloadProgress == -1) {
@@ -1057,7 +1496,12 @@ public:
     void unreferencePixmap(QQuickPixmapData *);
     void referencePixmap(QQuickPixmapData *);
 
+    void addCachedCost(QQuickPixmapData *);
+    void removeCachedCost(QQuickPixmapData *);
+
     void purgeCache();
+    void setLimits(qint64 unreferencedLimit, qint64 totalLimit);
+    qint64 unreferencedCost() const { return m_unreferencedCost; }
 
 protected:
     void timerEvent(QTimerEvent *) override;
@@ -1065,21 +1509,40 @@ protected:
 public:
     QHash<QQuickPixmapKey, QQuickPixmapData *> m_cache;
 
+    qint64 m_unreferencedLimit;
+    qint64 m_totalLimit; // -1 for no limit
+    qint64 m_cachedCost;
+    quint64 m_hits;
+    quint64 m_misses;
+    quint64 m_evictions;
+
 private:
-    void shrinkCache(int remove);
+    void shrinkCache(qint64 remove);
+    bool isOverBudget() const;
+    void linkUnreferenced(QQuickPixmapData *);
+    void unlinkUnreferenced(QQuickPixmapData *);
 
     QQuickPixmapData *m_unreferencedPixmaps;
     QQuickPixmapData *m_lastUnreferencedPixmap;
 
-    int m_unreferencedCost;
+    qint64 m_unreferencedCost;
     int m_timerId;
     bool m_destroying;
 };
 Q_GLOBAL_STATIC(QQuickPixmapStore, pixmapStore);
 
+static qint64 cacheLimitFromEnvironment(const char *name, qint64 defaultValue)
+{
+    bool ok = false;
+    const int kilobytes = qEnvironmentVariableIntValue(name, &ok);
+    return ok && kilobytes >= 0 ? qint64(kilobytes) * 1024 : defaultValue;
+}
 
 QQuickPixmapStore::QQuickPixmapStore()
-    : m_unreferencedPixmaps(nullptr), m_lastUnreferencedPixmap(nullptr), m_unreferencedCost(0), m_timerId(-1), m_destroying(false)
+    : m_unreferencedLimit(cacheLimitFromEnvironment("QML_PIXMAP_CACHE_LIMIT", defaultCacheLimit)),
+      m_totalLimit(cacheLimitFromEnvironment("QML_PIXMAP_CACHE_TOTAL_LIMIT", -1)),
+      m_cachedCost(0), m_hits(0), m_misses(0), m_evictions(0),
+      m_unreferencedPixmaps(nullptr), m_lastUnreferencedPixmap(nullptr), m_unreferencedCost(0), m_timerId(-1), m_destroying(false)
 {
 }
 
@@ -1121,7 +1584,7 @@ QQuickPixmapStore::~QQuickPixmapStore()
 #endif
 }
 
-void QQuickPixmapStore::unreferencePixmap(QQuickPixmapData *data)
+void QQuickPixmapStore::linkUnreferenced(QQuickPixmapData *data)
 {
     Q_ASSERT(data->prevUnreferenced == nullptr);
     Q_ASSERT(data->prevUnreferencedPtr == nullptr);
@@ -1140,16 +1603,9 @@ void QQuickPixmapStore::unreferencePixmap(QQuickPixmapData *data)
 
     if (!m_lastUnreferencedPixmap)
         m_lastUnreferencedPixmap = data;
-
-    shrinkCache(-1); // Shrink the cache in case it has become larger than cache_limit
-
-    if (m_timerId == -1 && m_unreferencedPixmaps
-            && !m_destroying && !QCoreApplication::closingDown()) {
-        m_timerId = startTimer(CACHE_EXPIRE_TIME * 1000);
-    }
 }
 
-void QQuickPixmapStore::referencePixmap(QQuickPixmapData *data)
+void QQuickPixmapStore::unlinkUnreferenced(QQuickPixmapData *data)
 {
     Q_ASSERT(data->prevUnreferencedPtr);
 
@@ -1165,32 +1621,84 @@ void QQuickPixmapStore::referencePixmap(QQuickPixmapData *data)
     data->prevUnreferencedPtr = nullptr;
     data->prevUnreferenced = nullptr;
 
-    m_unreferencedCost -= data->cost();
+    if (!m_destroying)
+        m_unreferencedCost -= data->cost();
 }
 
-void QQuickPixmapStore::shrinkCache(int remove)
+void QQuickPixmapStore::unreferencePixmap(QQuickPixmapData *data)
 {
-    while ((remove > 0 || m_unreferencedCost > cache_limit) && m_lastUnreferencedPixmap) {
+    linkUnreferenced(data);
+
+    shrinkCache(-1); // Shrink the cache in case it has become larger than the limits
+
+    if (m_timerId == -1 && m_unreferencedPixmaps
+            && !m_destroying && !QCoreApplication::closingDown()) {
+        m_timerId = startTimer(CACHE_EXPIRE_TIME * 1000);
+    }
+}
+
+void QQuickPixmapStore::referencePixmap(QQuickPixmapData *data)
+{
+    unlinkUnreferenced(data);
+}
+
+void QQuickPixmapStore::addCachedCost(QQuickPixmapData *data)
+{
+    const int cost = data->cost();
+    m_cachedCost += cost - data->cachedCost;
+    data->cachedCost = cost;
+    if (m_totalLimit >= 0 && m_cachedCost > m_totalLimit)
+        shrinkCache(-1);
+}
+
+void QQuickPixmapStore::removeCachedCost(QQuickPixmapData *data)
+{
+    m_cachedCost -= data->cachedCost;
+    data->cachedCost = 0;
+}
+
+bool QQuickPixmapStore::isOverBudget() const
+{
+    return m_unreferencedCost > m_unreferencedLimit
+            || (m_totalLimit >= 0 && m_cachedCost > m_totalLimit);
+}
+
+void QQuickPixmapStore::shrinkCache(qint64 remove)
+{
+    while ((remove > 0 || isOverBudget()) && m_lastUnreferencedPixmap) {
         QQuickPixmapData *data = m_lastUnreferencedPixmap;
         Q_ASSERT(data->nextUnreferenced == nullptr);
 
-        *data->prevUnreferencedPtr = nullptr;
-        m_lastUnreferencedPixmap = data->prevUnreferenced;
-        data->prevUnreferencedPtr = nullptr;
-        data->prevUnreferenced = nullptr;
+        // Least recently used goes first, unless it was reused from the cache before,
+        // in which case it gets another round with its hit count halved. Pixmaps
+        // that keep getting reused thus stay while one-off ones are evicted.
+        if (data->cacheHits > 0 && !m_destroying) {
+            data->cacheHits /= 2;
+            unlinkUnreferenced(data);
+            linkUnreferenced(data);
+            continue;
+        }
 
+        unlinkUnreferenced(data);
         if (!m_destroying) {
             remove -= data->cost();
-            m_unreferencedCost -= data->cost();
+            ++m_evictions;
         }
         data->removeFromCache(this);
         delete data;
     }
 }
 
+void QQuickPixmapStore::setLimits(qint64 unreferencedLimit, qint64 totalLimit)
+{
+    m_unreferencedLimit = unreferencedLimit;
+    m_totalLimit = totalLimit;
+    shrinkCache(-1);
+}
+
 void QQuickPixmapStore::timerEvent(QTimerEvent *)
 {
-    int removalCost = m_unreferencedCost / CACHE_REMOVAL_FRACTION;
+    qint64 removalCost = m_unreferencedCost / CACHE_REMOVAL_FRACTION;
 
     shrinkCache(removalCost);
 
@@ -1210,9 +1718,67 @@ void QQuickPixmap::purgeCache()
     pixmapStore()->purgeCache();
 }
 
+/*! \internal
+    Sets the maximum number of bytes that pixmaps, which are no longer
+    referenced, can keep occupied in the cache to \a bytes. The default is
+    2 MB and can be changed with the \c QML_PIXMAP_CACHE_LIMIT environment
+    variable, in kilobytes.
+*/
+void QQuickPixmap::setUnreferencedCacheLimit(qint64 bytes)
+{
+    QQuickPixmapStore *store = pixmapStore();
+    store->setLimits(qMax<qint64>(0, bytes), store->m_totalLimit);
+}
+
+qint64 QQuickPixmap::unreferencedCacheLimit()
+{
+    return pixmapStore()->m_unreferencedLimit;
+}
+
+/*! \internal
+    Sets the maximum number of bytes all cached pixmaps together should
+    occupy to \a bytes, or removes the limit when \a bytes is negative,
+    which is the default. Pixmaps that are still referenced are never
+    evicted, so the limit only causes unreferenced pixmaps to be evicted
+    earlier. The \c QML_PIXMAP_CACHE_TOTAL_LIMIT environment variable sets
+    the initial limit, in kilobytes.
+*/
+void QQuickPixmap::setTotalCacheLimit(qint64 bytes)
+{
+    QQuickPixmapStore *store = pixmapStore();
+    store->setLimits(store->m_unreferencedLimit, bytes < 0 ? -1 : bytes);
+}
+
+qint64 QQuickPixmap::totalCacheLimit()
+{
+    return pixmapStore()->m_totalLimit;
+}
+
+QQuickPixmap::CacheStatistics QQuickPixmap::cacheStatistics()
+{
+    QQuickPixmapStore *store = pixmapStore();
+    CacheStatistics statistics;
+    statistics.hits = store->m_hits;
+    statistics.misses = store->m_misses;
+    statistics.evictions = store->m_evictions;
+    statistics.count = store->m_cache.size();
+    statistics.bytes = store->m_cachedCost;
+    statistics.unreferencedBytes = store->unreferencedCost();
+    return statistics;
+}
+
+void QQuickPixmap::resetCacheStatistics()
+{
+    QQuickPixmapStore *store = pixmapStore();
+    store->m_hits = 0;
+    store->m_misses = 0;
+    store->m_evictions = 0;
+}
+
 QQuickPixmapReply::QQuickPixmapReply(QQuickPixmapData *d)
   : data(d), engineForReader(nullptr), requestRegion(d->requestRegion), requestSize(d->requestSize),
-    url(d->url), loading(false), providerOptions(d->providerOptions), redirectCount(0)
+    url(d->url), loading(false), providerOptions(d->providerOptions), redirectCount(0),
+    priority(QQuickPixmap::NormalPriority)
 {
     if (finishedIndex == -1) {
         finishedIndex = QMetaMethod::fromSignal(&QQuickPixmapReply::finished).methodIndex();
@@ -1237,6 +1803,8 @@ bool QQuickPixmapReply::event(QEvent *event)
                 data->textureFactory = de->textureFactory;
                 de->textureFactory = nullptr;
                 data->implicitSize = de->implicitSize;
+                if (data->inCache)
+                    pixmapStore()->addCachedCost(data);
                 PIXMAP_PROFILE(pixmapLoadingFinished(data->url,
                         data->textureFactory != nullptr && data->textureFactory->textureSize().isValid() ?
                         data->textureFactory->textureSize() :
@@ -1315,6 +1883,7 @@ void QQuickPixmapData::addToCache()
         QQuickPixmapKey key = { &url, &requestRegion, &requestSize, frame, providerOptions };
         pixmapStore()->m_cache.insert(key, this);
         inCache = true;
+        pixmapStore()->addCachedCost(this);
         PIXMAP_PROFILE(pixmapCountChanged<QQuickProfiler::PixmapCacheCountChanged>(
                 url, pixmapStore()->m_cache.size()));
     }
@@ -1329,6 +1898,7 @@ void QQuickPixmapData::removeFromCache(QQuickPixmapStore *store)
         QQuickPixmapKey key = { &url, &requestRegion, &requestSize, frame, providerOptions };
         store->m_cache.remove(key);
         inCache = false;
+        store->removeCachedCost(this);
         PIXMAP_PROFILE(pixmapCountChanged<QQuickProfiler::PixmapCacheCountChanged>(
                 url, store->m_cache.size()));
     }
@@ -1427,8 +1997,18 @@ static QQuickPixmapData* createPixmapDataSync(QQuickPixmap *declarativePixmap, Q
             QImage image;
             QQuickImageProviderOptions::AutoTransform appliedTransform = providerOptions.autoTransform();
             int frameCount;
+            const QString cacheFileName = diskCacheFileName(f.fileName(), requestRegion, requestSize,
+                                                            providerOptions, frame, devicePixelRatio);
+            if (!cacheFileName.isEmpty()
+                    && readFromDiskCache(cacheFileName, &image, &readSize, &frameCount, &appliedTransform)) {
+                *ok = true;
+                return new QQuickPixmapData(declarativePixmap, url, QQuickTextureFactory::textureFactoryForImage(image), readSize, requestRegion, requestSize,
+                                            providerOptions, appliedTransform, frame, frameCount);
+            }
             if (readImage(url, &f, &image, &errorString, &readSize, &frameCount, requestRegion, requestSize,
                           providerOptions, &appliedTransform, frame, devicePixelRatio)) {
+                if (!cacheFileName.isEmpty())
+                    writeToDiskCache(cacheFileName, image, readSize, frameCount, appliedTransform);
                 *ok = true;
                 return new QQuickPixmapData(declarativePixmap, url, QQuickTextureFactory::textureFactoryForImage(image), readSize, requestRegion, requestSize,
                                             providerOptions, appliedTransform, frame, frameCount);
@@ -1676,8 +2256,11 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QRect &reques
             qWarning() << "Ignoring sourceSize request for image url that came from grabToImage. Use the targetSize parameter of the grabToImage() function instead.";
         const QQuickPixmapKey grabberKey = { &url, &dummyRegion, &dummySize, 0, QQuickImageProviderOptions() };
         iter = store->m_cache.find(grabberKey);
-    } else if (options & QQuickPixmap::Cache)
+    } else if (options & QQuickPixmap::Cache) {
         iter = store->m_cache.find(key);
+        if (iter == store->m_cache.end())
+            ++store->m_misses;
+    }
 
     if (iter == store->m_cache.end()) {
         if (url.scheme() == QLatin1String("image")) {
@@ -1729,6 +2312,10 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QRect &reques
         QQuickPixmapReader::readerMutex.unlock();
     } else {
         d = *iter;
+        if (url.scheme() != itemGrabberScheme) {
+            ++store->m_hits;
+            ++d->cacheHits;
+        }
         d->addref();
         d->declarativePixmaps.insert(this);
     }
@@ -1751,6 +2338,7 @@ void QQuickPixmap::loadImageFromDevice(QQmlEngine *engine, QIODevice *device, co
     QHash<QQuickPixmapKey, QQuickPixmapData *>::Iterator iter = store->m_cache.end();
     iter = store->m_cache.find(key);
     if (iter == store->m_cache.end()) {
+        ++store->m_misses;
         if (!engine)
             return;
 
@@ -1769,11 +2357,31 @@ void QQuickPixmap::loadImageFromDevice(QQmlEngine *engine, QIODevice *device, co
         QQuickPixmapReader::readerMutex.unlock();
     } else {
         d = *iter;
+        ++store->m_hits;
+        ++d->cacheHits;
         d->addref();
         d->declarativePixmaps.insert(this);
     }
 }
 
+/*! \internal
+    Sets the \a priority with which the pending asynchronous load of this
+    pixmap is scheduled relative to other pending loads. Images that are not
+    on screen, such as the ones in the cacheBuffer of a view, use
+    LowPriority so that the visible ones get decoded first.
+*/
+void QQuickPixmap::setLoadPriority(LoadPriority priority)
+{
+    if (!d || !d->reply)
+        return;
+
+    QQuickPixmapReader::readerMutex.lock();
+    QQuickPixmapReader *reader = QQuickPixmapReader::existingInstance(d->reply->engineForReader);
+    if (reader)
+        reader->setPriority(d->reply, priority);
+    QQuickPixmapReader::readerMutex.unlock();
+}
+
 void QQuickPixmap::clear()
 {
     if (d) {
@@ -106,6 +106,11 @@ public:
     };
     Q_DECLARE_FLAGS(Options, Option)
 
+    enum LoadPriority {
+        LowPriority,
+        NormalPriority
+    };
+
     bool isNull() const;
     bool isReady() const;
     bool isError() const;
@@ -142,6 +147,8 @@ public:
                              const QRect &requestRegion, const QSize &requestSize,
                              const QQuickImageProviderOptions &providerOptions, int frame = 0, int frameCount = 1);
 
+    void setLoadPriority(LoadPriority priority);
+
     void clear();
     void clear(QObject *);
 
@@ -151,6 +158,21 @@ public:
     bool connectDownloadProgress(QObject *, int);
 
     static void purgeCache();
+
+    struct CacheStatistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+        int count = 0;
+        qint64 bytes = 0;
+        qint64 unreferencedBytes = 0;
+    };
+    static void setUnreferencedCacheLimit(qint64 bytes);
+    static qint64 unreferencedCacheLimit();
+    static void setTotalCacheLimit(qint64 bytes);
+    static qint64 totalCacheLimit();
+    static CacheStatistics cacheStatistics();
+    static void resetCacheStatistics();
     static bool isCached(const QUrl &url, const QRect &requestRegion, const QSize &requestSize,
                          const int frame, const QQuickImageProviderOptions &options);
 
@@ -0,0 +1,22 @@
+import QtQml
+import QtQml.Models
+
+DelegateModel {
+    function setName(index, name) { fruits.setProperty(index, "name", name) }
+    function insertFruit(index, name) { fruits.insert(index, { name: name }) }
+    function removeFruits(index, count) { fruits.remove(index, count) }
+    function moveFruits(from, to, count) { fruits.move(from, to, count) }
+
+    property ListModel otherModel: ListModel {
+        ListElement { name: "Lemon" }
+    }
+
+    model: ListModel {
+        id: fruits
+        ListElement { name: "Apple" }
+        ListElement { name: "Banana" }
+        ListElement { name: "Cherry" }
+        ListElement { name: "Date" }
+    }
+    delegate: QtObject { property string text: model.name }
+}
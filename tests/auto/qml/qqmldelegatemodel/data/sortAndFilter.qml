@@ -0,0 +1,48 @@
+import QtQml
+import QtQml.Models
+
+DelegateModel {
+    id: root
+
+    property QtObject cheapGroup: cheap
+
+    function setRole(name, role, value) {
+        for (let i = 0; i < fruits.count; ++i) {
+            if (fruits.get(i).name === name)
+                fruits.setProperty(i, role, value)
+        }
+    }
+
+    function insertFruit(index, name, cost) {
+        fruits.insert(index, { name: name, cost: cost })
+    }
+
+    function moveCheap(from, to) {
+        cheap.move(from, to)
+    }
+
+    function removeCheap(index, count) {
+        cheap.remove(index, count)
+    }
+
+    model: ListModel {
+        id: fruits
+        ListElement { name: "Orange"; cost: 4 }
+        ListElement { name: "Apple"; cost: 12 }
+        ListElement { name: "Kiwi"; cost: 3 }
+        ListElement { name: "Banana"; cost: 20 }
+        ListElement { name: "Lime"; cost: 1 }
+    }
+
+    groups: DelegateModelGroup {
+        id: cheap
+        name: "cheap"
+        includeByDefault: true
+        filterRole: "cost"
+        filter: function(cost) { return cost < 10 }
+        sortRole: "name"
+    }
+    filterOnGroup: "cheap"
+
+    delegate: QtObject {}
+}
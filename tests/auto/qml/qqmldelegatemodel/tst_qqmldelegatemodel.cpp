@@ -3,6 +3,8 @@
 
 #include <QtTest/qtest.h>
 #include <QtCore/QConcatenateTablesProxyModel>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QScopeGuard>
 #include <QtGui/QStandardItemModel>
 #include <QtQml/qqmlcomponent.h>
 #include <QtQmlModels/private/qqmldelegatemodel_p.h>
@@ -26,6 +28,9 @@ private slots:
     void contextAccessedByHandler();
     void redrawUponColumnChange();
     void nestedDelegates();
+    void sortAndFilter();
+    void multiData();
+    void coalescedChanges();
 };
 
 class AbstractItemModel : public QAbstractItemModel
@@ -79,6 +84,51 @@ private:
     QVector<QString> mValues;
 };
 
+class MultiDataModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : 100;
+    }
+
+    QHash<int, QByteArray> roleNames() const override
+    {
+        return { { Qt::UserRole, "a" }, { Qt::UserRole + 1, "b" }, { Qt::UserRole + 2, "c" } };
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        ++dataCalls;
+        return value(index, role);
+    }
+
+    void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const override
+    {
+        ++multiDataCalls;
+        for (QModelRoleData &roleData : roleDataSpan)
+            roleData.setData(value(index, roleData.role()));
+    }
+
+    void setOffset(int newOffset)
+    {
+        offset = newOffset;
+        emit dataChanged(index(0), index(rowCount() - 1));
+    }
+
+    mutable int dataCalls = 0;
+    mutable int multiDataCalls = 0;
+
+private:
+    int value(const QModelIndex &index, int role) const
+    {
+        return offset + index.row() * 10 + role - Qt::UserRole;
+    }
+
+    int offset = 0;
+};
+
 tst_QQmlDelegateModel::tst_QQmlDelegateModel()
     : QQmlDataTest(QT_QMLTEST_DATADIR)
 {
@@ -207,6 +257,194 @@ void tst_QQmlDelegateModel::nestedDelegates()
     QFAIL("Loader not found");
 }
 
+static QStringList names(QQmlDelegateModel *model)
+{
+    QStringList names;
+    for (int i = 0; i < model->count(); ++i)
+        names.append(model->variantValue(i, QStringLiteral("name")).toString());
+    return names;
+}
+
+void tst_QQmlDelegateModel::sortAndFilter()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("sortAndFilter.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+    auto *model = qobject_cast<QQmlDelegateModel *>(root.data());
+    QVERIFY(model);
+    auto *cheap = qobject_cast<QQmlDelegateModelGroup *>(
+            root->property("cheapGroup").value<QObject *>());
+    QVERIFY(cheap);
+    // Sorting keeps its order in the group and leaves the items group alone, so the only
+    // removes and inserts the items group reports are those of the model itself.
+    QSignalSpy itemsChangedSpy(model->items(), &QQmlDelegateModelGroup::changed);
+    auto itemsStructureChanges = [&]() {
+        QList<QPair<int, int>> lengths;
+        for (const QList<QVariant> &arguments : std::as_const(itemsChangedSpy)) {
+            const int removed = arguments.at(0).value<QJSValue>().property("length").toInt();
+            const int inserted = arguments.at(1).value<QJSValue>().property("length").toInt();
+            if (removed || inserted)
+                lengths.append({ removed, inserted });
+        }
+        return lengths;
+    };
+
+    QCOMPARE(names(model), QStringList({ "Kiwi", "Lime", "Orange" }));
+
+    QMetaObject::invokeMethod(root.data(), "insertFruit",
+                              Q_ARG(QVariant, 0), Q_ARG(QVariant, "Fig"), Q_ARG(QVariant, 2));
+    QCOMPARE(names(model), QStringList({ "Fig", "Kiwi", "Lime", "Orange" }));
+
+    QMetaObject::invokeMethod(root.data(), "insertFruit",
+                              Q_ARG(QVariant, 2), Q_ARG(QVariant, "Cherry"), Q_ARG(QVariant, 30));
+    QCOMPARE(names(model), QStringList({ "Fig", "Kiwi", "Lime", "Orange" }));
+
+    // Changing the filter role moves items in and out of the group.
+    QMetaObject::invokeMethod(root.data(), "setRole", Q_ARG(QVariant, "Apple"),
+                              Q_ARG(QVariant, "cost"), Q_ARG(QVariant, 5));
+    QCOMPARE(names(model), QStringList({ "Apple", "Fig", "Kiwi", "Lime", "Orange" }));
+    QMetaObject::invokeMethod(root.data(), "setRole", Q_ARG(QVariant, "Kiwi"),
+                              Q_ARG(QVariant, "cost"), Q_ARG(QVariant, 50));
+    QCOMPARE(names(model), QStringList({ "Apple", "Fig", "Lime", "Orange" }));
+
+    // Changing the sort role moves the item into place.
+    QSignalSpy cheapChangedSpy(cheap, &QQmlDelegateModelGroup::changed);
+    QMetaObject::invokeMethod(root.data(), "setRole", Q_ARG(QVariant, "Lime"),
+                              Q_ARG(QVariant, "name"), Q_ARG(QVariant, "Zucchini"));
+    QCOMPARE(names(model), QStringList({ "Apple", "Fig", "Orange", "Zucchini" }));
+    QCOMPARE(cheapChangedSpy.size(), 1);
+    QCOMPARE(cheapChangedSpy.first().at(0).value<QJSValue>().property("length").toInt(), 1);
+    QCOMPARE(cheapChangedSpy.first().at(1).value<QJSValue>().property("length").toInt(), 1);
+    QMetaObject::invokeMethod(root.data(), "setRole", Q_ARG(QVariant, "Zucchini"),
+                              Q_ARG(QVariant, "name"), Q_ARG(QVariant, "Banana"));
+    QCOMPARE(names(model), QStringList({ "Apple", "Banana", "Fig", "Orange" }));
+
+    cheap->setSortOrder(Qt::DescendingOrder);
+    QCOMPARE(names(model), QStringList({ "Orange", "Fig", "Banana", "Apple" }));
+
+    cheap->setSortRole(QStringLiteral("cost"));
+    QCOMPARE(names(model), QStringList({ "Apple", "Orange", "Fig", "Banana" }));
+    QCOMPARE(cheap->get(0).property("model").property("name").toString(), QStringLiteral("Apple"));
+
+    model->setFilterGroup(QStringLiteral("items"));
+    QCOMPARE(names(model), QStringList({ "Fig", "Orange", "Cherry", "Apple", "Kiwi", "Banana",
+                                         "Banana" }));
+    model->setFilterGroup(QStringLiteral("cheap"));
+    QCOMPARE(names(model), QStringList({ "Apple", "Orange", "Fig", "Banana" }));
+
+    QTest::ignoreMessage(QtWarningMsg,
+                         QRegularExpression(".*move: a sorted group cannot be reordered"));
+    QMetaObject::invokeMethod(root.data(), "moveCheap", Q_ARG(QVariant, 0), Q_ARG(QVariant, 3));
+    QCOMPARE(names(model), QStringList({ "Apple", "Orange", "Fig", "Banana" }));
+
+    // Indexes passed to the group are sorted positions.
+    QMetaObject::invokeMethod(root.data(), "removeCheap", Q_ARG(QVariant, 2), Q_ARG(QVariant, 2));
+    QCOMPARE(names(model), QStringList({ "Apple", "Orange" }));
+    QCOMPARE(itemsStructureChanges(), (QList<QPair<int, int>>({ { 0, 1 }, { 0, 1 } })));
+
+    // Clearing the sort role returns the items to the order of the model.
+    cheap->setSortRole(QString());
+    QCOMPARE(names(model), QStringList({ "Orange", "Apple" }));
+}
+
+void tst_QQmlDelegateModel::multiData()
+{
+    MultiDataModel listModel;
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData("import QtQml\n"
+                      "import QtQml.Models\n"
+                      "DelegateModel { delegate: QtObject { property int sum: model.a + model.b + model.c } }",
+                      QUrl());
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+    auto *model = qobject_cast<QQmlDelegateModel *>(root.data());
+    QVERIFY(model);
+    model->setModel(QVariant::fromValue<QObject *>(&listModel));
+
+    QList<QObject *> delegates;
+    for (int i = 0; i < 10; ++i) {
+        delegates.append(model->object(i, QQmlIncubator::Synchronous));
+        QVERIFY(delegates.last());
+    }
+    QCOMPARE(delegates.at(3)->property("sum").toInt(), 30 + 31 + 32);
+
+    // The roles are fetched together, once per delegate after the first has read them all.
+    QCOMPARE(listModel.dataCalls, 0);
+    QVERIFY(listModel.multiDataCalls <= 10 + 2);
+
+    // Changed data is fetched again.
+    listModel.setOffset(100);
+    QCOMPARE(delegates.at(3)->property("sum").toInt(), 130 + 131 + 132);
+
+    for (QObject *delegate : std::as_const(delegates))
+        model->release(delegate);
+}
+
+static QStringList texts(QQmlDelegateModel *model)
+{
+    QStringList texts;
+    for (int i = 0; i < model->count(); ++i) {
+        QObject *delegate = model->object(i, QQmlIncubator::Synchronous);
+        texts.append(delegate->property("text").toString());
+        model->release(delegate);
+    }
+    return texts;
+}
+
+void tst_QQmlDelegateModel::coalescedChanges()
+{
+    // The flag is read when the model is created.
+    qputenv("QT_QML_COALESCE_MODEL_CHANGES", "1");
+    auto unsetEnv = qScopeGuard([] { qunsetenv("QT_QML_COALESCE_MODEL_CHANGES"); });
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("coalescedChanges.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+    auto *model = qobject_cast<QQmlDelegateModel *>(root.data());
+    QVERIFY(model);
+
+    QList<QObject *> delegates;
+    for (int i = 0; i < 4; ++i) {
+        delegates.append(model->object(i, QQmlIncubator::Synchronous));
+        QVERIFY(delegates.last());
+    }
+
+    // Changes are applied on the next pass of the event loop, following the rows that are
+    // inserted, removed and moved in the meantime.
+    QMetaObject::invokeMethod(root.data(), "setName", Q_ARG(QVariant, 3), Q_ARG(QVariant, "Durian"));
+    QMetaObject::invokeMethod(root.data(), "insertFruit", Q_ARG(QVariant, 1), Q_ARG(QVariant, "Fig"));
+    QObject *fig = model->object(1, QQmlIncubator::Synchronous);
+    QVERIFY(fig);
+    QCOMPARE(fig->property("text").toString(), QStringLiteral("Fig"));
+    QMetaObject::invokeMethod(root.data(), "setName", Q_ARG(QVariant, 1), Q_ARG(QVariant, "Grape"));
+    QMetaObject::invokeMethod(root.data(), "setName", Q_ARG(QVariant, 0), Q_ARG(QVariant, "Apricot"));
+    QMetaObject::invokeMethod(root.data(), "moveFruits",
+                              Q_ARG(QVariant, 0), Q_ARG(QVariant, 3), Q_ARG(QVariant, 2));
+    QMetaObject::invokeMethod(root.data(), "removeFruits", Q_ARG(QVariant, 0), Q_ARG(QVariant, 1));
+    QCOMPARE(fig->property("text").toString(), QStringLiteral("Fig"));
+    QCOMPARE(delegates.at(0)->property("text").toString(), QStringLiteral("Apple"));
+    QCOMPARE(delegates.at(3)->property("text").toString(), QStringLiteral("Date"));
+
+    QTRY_COMPARE(fig->property("text").toString(), QStringLiteral("Grape"));
+    QCOMPARE(delegates.at(0)->property("text").toString(), QStringLiteral("Apricot"));
+    QCOMPARE(delegates.at(3)->property("text").toString(), QStringLiteral("Durian"));
+    QCOMPARE(texts(model), QStringList({ "Cherry", "Durian", "Apricot", "Grape" }));
+    model->release(fig);
+    for (QObject *delegate : std::as_const(delegates))
+        model->release(delegate);
+
+    // Queued changes refer to the rows of the previous model and are dropped along with it.
+    QMetaObject::invokeMethod(root.data(), "setName", Q_ARG(QVariant, 0), Q_ARG(QVariant, "Kiwi"));
+    model->setModel(root->property("otherModel"));
+    QSignalSpy itemsChangedSpy(model->items(), &QQmlDelegateModelGroup::changed);
+    QCoreApplication::processEvents();
+    QCOMPARE(itemsChangedSpy.size(), 0);
+    QCOMPARE(texts(model), QStringList({ "Lemon" }));
+}
+
 QTEST_MAIN(tst_QQmlDelegateModel)
 
 #include "tst_qqmldelegatemodel.moc"
@@ -118,6 +118,7 @@ private slots:
     void destroyComponentObject();
     void objectOwnershipFlip();
     void enumsInListElement();
+    void columns();
 };
 
 bool tst_qqmllistmodel::compareVariantList(const QVariantList &testList, QVariant object)
@@ -1909,6 +1910,77 @@ void tst_qqmllistmodel::enumsInListElement()
     }
 }
 
+void tst_qqmllistmodel::columns()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    QSignalSpy insertedSpy(&model, &QQmlListModel::rowsInserted);
+
+    QQmlExpression append(engine.rootContext(), &model,
+                          "appendColumns({ name: ['a', 'b', 'c'],"
+                          "  cost: new Float64Array([1.5, 2, 3]),"
+                          "  ok: [true, null, false] })");
+    append.evaluate();
+    QVERIFY2(!append.hasError(), qPrintable(append.error().toString()));
+    QCOMPARE(insertedSpy.size(), 1);
+    QCOMPARE(model.count(), 3);
+
+    const int nameRole = roleFromName(&model, "name");
+    const int costRole = roleFromName(&model, "cost");
+    const int okRole = roleFromName(&model, "ok");
+    QCOMPARE(model.data(0, nameRole), QVariant("a"_L1));
+    QCOMPARE(model.data(2, nameRole), QVariant("c"_L1));
+    QCOMPARE(model.data(0, costRole), QVariant(1.5));
+    QCOMPARE(model.data(1, costRole), QVariant(2.0));
+    QCOMPARE(model.data(0, okRole), QVariant(true));
+    QCOMPARE(model.data(2, okRole), QVariant(false));
+
+    QQmlExpression insert(engine.rootContext(), &model,
+                          "insertColumns(1, { name: ['x', 'y'], cost: [7, 8] })");
+    insert.evaluate();
+    QVERIFY2(!insert.hasError(), qPrintable(insert.error().toString()));
+    QCOMPARE(insertedSpy.size(), 2);
+    QCOMPARE(insertedSpy.last().at(1).toInt(), 1);
+    QCOMPARE(insertedSpy.last().at(2).toInt(), 2);
+    QCOMPARE(model.count(), 5);
+    QCOMPARE(model.data(1, nameRole), QVariant("x"_L1));
+    QCOMPARE(model.data(2, costRole), QVariant(8.0));
+    QCOMPARE(model.data(3, nameRole), QVariant("b"_L1));
+
+    // The model is left untouched when the columns do not line up
+    QTest::ignoreMessage(QtWarningMsg,
+                         QRegularExpression(".*appendColumns: all roles must have the same number of values"));
+    QQmlExpression mismatch(engine.rootContext(), &model,
+                            "appendColumns({ name: ['z'], cost: [] })");
+    mismatch.evaluate();
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(".*appendColumns: role name is not an array"));
+    QQmlExpression notArray(engine.rootContext(), &model, "appendColumns({ name: 'z' })");
+    notArray.evaluate();
+    QCOMPARE(insertedSpy.size(), 2);
+    QCOMPARE(model.count(), 5);
+
+    // Values that do not fit the type of an existing role are skipped with a warning
+    QTest::ignoreMessage(QtWarningMsg,
+                         "<Unknown File>: Can't assign to existing role 'name' of different type [Number -> String]");
+    QTest::ignoreMessage(QtWarningMsg,
+                         "<Unknown File>: Can't assign to existing role 'name' of different type [Bool -> String]");
+    QTest::ignoreMessage(QtWarningMsg,
+                         "<Unknown File>: Can't assign to existing role 'ok' of different type [Number -> Bool]");
+    QQmlExpression wrongType(engine.rootContext(), &model,
+                             "appendColumns({ name: ['d', 4, true],"
+                             "  cost: [10, 11, 12],"
+                             "  ok: new Int8Array([1, 0, 1]) })");
+    wrongType.evaluate();
+    QVERIFY2(!wrongType.hasError(), qPrintable(wrongType.error().toString()));
+    QCOMPARE(insertedSpy.size(), 3);
+    QCOMPARE(model.count(), 8);
+    QCOMPARE(model.data(5, nameRole), QVariant("d"_L1));
+    QCOMPARE(model.data(6, nameRole), QVariant(QString()));
+    QCOMPARE(model.data(7, costRole), QVariant(12.0));
+    QCOMPARE(model.data(7, okRole), QVariant(false));
+}
+
 QTEST_MAIN(tst_qqmllistmodel)
 
 #include "tst_qqmllistmodel.moc"
@@ -0,0 +1,189 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#include <qtest.h>
+#include <QtCore/qrandom.h>
+#include <private/qqmlsortedorder_p.h>
+
+#include <numeric>
+
+typedef QQmlSortedOrder O;
+
+static bool lessThan(const QVariant &left, const QVariant &right)
+{
+    return left.toInt() < right.toInt();
+}
+
+class tst_qqmlsortedorder : public QObject
+{
+    Q_OBJECT
+
+private:
+    void verify(const O &order, const QVector<int> &groupOrder, const QVector<int> &sortedOrder);
+
+private slots:
+    void insertRemove();
+    void upperBound();
+    void reset();
+    void sort();
+    void randomEdits_data();
+    void randomEdits();
+};
+
+// Compares order with the items listed in group order and in sorted order.
+void tst_qqmlsortedorder::verify(
+        const O &order, const QVector<int> &groupOrder, const QVector<int> &sortedOrder)
+{
+    QCOMPARE(order.count(O::GroupOrder), groupOrder.size());
+    QCOMPARE(order.count(O::SortedOrder), sortedOrder.size());
+    for (int i = 0; i < groupOrder.size(); ++i) {
+        QCOMPARE(order.at(O::GroupOrder, i), groupOrder.at(i));
+        QCOMPARE(order.indexOf(O::GroupOrder, groupOrder.at(i)), i);
+    }
+    for (int i = 0; i < sortedOrder.size(); ++i) {
+        QCOMPARE(order.at(O::SortedOrder, i), sortedOrder.at(i));
+        QCOMPARE(order.indexOf(O::SortedOrder, sortedOrder.at(i)), i);
+    }
+    if (groupOrder.size() != sortedOrder.size())
+        return;
+
+    QVector<int> sortedGroupIndexes;
+    for (int item : sortedOrder)
+        sortedGroupIndexes.append(groupOrder.indexOf(item));
+    QCOMPARE(order.sortedGroupIndexes(), sortedGroupIndexes);
+    for (int i = 0; i < sortedOrder.size(); ++i) {
+        QCOMPARE(order.toGroupIndex(i), sortedGroupIndexes.at(i));
+        QCOMPARE(order.toSortedPosition(sortedGroupIndexes.at(i)), i);
+    }
+}
+
+void tst_qqmlsortedorder::insertRemove()
+{
+    O order;
+    const int a = order.create(3);
+    const int b = order.create(1);
+    const int c = order.create(2);
+
+    order.insert(O::GroupOrder, 0, a);
+    order.insert(O::GroupOrder, 1, b);
+    order.insert(O::GroupOrder, 1, c);
+    order.insert(O::SortedOrder, 0, b);
+    order.insert(O::SortedOrder, 1, c);
+    order.insert(O::SortedOrder, 2, a);
+    verify(order, { a, c, b }, { b, c, a });
+    QCOMPARE(order.key(c), QVariant(2));
+
+    QCOMPARE(order.remove(O::GroupOrder, c), 1);
+    verify(order, { a, b }, { b, c, a });
+    QCOMPARE(order.remove(O::SortedOrder, c), 1);
+    verify(order, { a, b }, { b, a });
+
+    // Destroyed items are reused.
+    order.destroy(c);
+    const int d = order.create(0);
+    QCOMPARE(d, c);
+    QCOMPARE(order.key(d), QVariant(0));
+
+    order.clear();
+    QCOMPARE(order.count(O::GroupOrder), 0);
+    QCOMPARE(order.count(), 0);
+}
+
+void tst_qqmlsortedorder::upperBound()
+{
+    O order;
+    QVector<int> keys = { 1, 3, 3, 5 };
+    for (int i = 0; i < keys.size(); ++i) {
+        const int item = order.create(keys.at(i));
+        order.insert(O::GroupOrder, i, item);
+        order.insert(O::SortedOrder, i, item);
+    }
+
+    QCOMPARE(order.upperBound(0, lessThan), 0);
+    QCOMPARE(order.upperBound(1, lessThan), 1);
+    QCOMPARE(order.upperBound(2, lessThan), 1);
+    QCOMPARE(order.upperBound(3, lessThan), 3);
+    QCOMPARE(order.upperBound(6, lessThan), 4);
+}
+
+void tst_qqmlsortedorder::reset()
+{
+    O order;
+    order.create(7);
+    order.reset({ 4, 2, 8, 2 }, { 1, 3, 0, 2 });
+
+    // Items are numbered by group index after a reset.
+    verify(order, { 0, 1, 2, 3 }, { 1, 3, 0, 2 });
+    QCOMPARE(order.key(2), QVariant(8));
+}
+
+void tst_qqmlsortedorder::sort()
+{
+    O order;
+    order.reset({ 4, 2, 8, 2 }, { 0, 1, 2, 3 });
+    order.sort(lessThan);
+
+    // Equal keys keep their group order.
+    verify(order, { 0, 1, 2, 3 }, { 1, 3, 0, 2 });
+}
+
+void tst_qqmlsortedorder::randomEdits_data()
+{
+    QTest::addColumn<quint32>("seed");
+
+    QTest::newRow("1") << 1u;
+    QTest::newRow("2") << 2u;
+    QTest::newRow("3") << 3u;
+}
+
+void tst_qqmlsortedorder::randomEdits()
+{
+    QFETCH(quint32, seed);
+
+    QRandomGenerator random(seed);
+    O order;
+    QVector<int> groupOrder;
+    QVector<int> sortedOrder;
+
+    const auto place = [&](int item) {
+        const int position = order.upperBound(order.key(item), lessThan);
+        order.insert(O::SortedOrder, position, item);
+        sortedOrder.insert(position, item);
+    };
+
+    for (int step = 0; step < 2000; ++step) {
+        const int operation = groupOrder.isEmpty() ? 0 : random.bounded(3);
+        if (operation == 0) {
+            const int item = order.create(int(random.bounded(50)));
+            const int index = random.bounded(groupOrder.size() + 1);
+            order.insert(O::GroupOrder, index, item);
+            groupOrder.insert(index, item);
+            place(item);
+        } else if (operation == 1) {
+            const int index = random.bounded(groupOrder.size());
+            const int item = groupOrder.takeAt(index);
+            QCOMPARE(order.remove(O::GroupOrder, item), index);
+            QCOMPARE(order.remove(O::SortedOrder, item), sortedOrder.indexOf(item));
+            sortedOrder.removeOne(item);
+            order.destroy(item);
+        } else {
+            const int item = groupOrder.at(random.bounded(groupOrder.size()));
+            order.setKey(item, int(random.bounded(50)));
+            QCOMPARE(order.remove(O::SortedOrder, item), sortedOrder.indexOf(item));
+            sortedOrder.removeOne(item);
+            place(item);
+        }
+
+        if (step % 100 == 0) {
+            verify(order, groupOrder, sortedOrder);
+            if (QTest::currentTestFailed())
+                return;
+        }
+    }
+    verify(order, groupOrder, sortedOrder);
+    for (int i = 1; i < sortedOrder.size(); ++i)
+        QVERIFY(!lessThan(order.key(sortedOrder.at(i)), order.key(sortedOrder.at(i - 1))));
+}
+
+QTEST_MAIN(tst_qqmlsortedorder)
+
+#include "tst_qqmlsortedorder.moc"
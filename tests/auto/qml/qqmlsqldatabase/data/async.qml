@@ -0,0 +1,36 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+import QtQml
+import QtQuick.LocalStorage
+
+QtObject {
+    property string result
+
+    Component.onCompleted: {
+        const db = LocalStorage.openDatabaseSync("QmlTestDB-async", "", "Test database from Qt autotests", 1000000)
+        db.transactionAsync([
+            "CREATE TABLE IF NOT EXISTS Greeting(salutation TEXT, salutee TEXT, count INTEGER)",
+            { sql: "INSERT INTO Greeting VALUES(?, ?, ?)",
+              batch: [ [ "Hello", "world", 1 ], [ "Goodbye", "cruel world", 2 ] ] },
+            { sql: "SELECT * FROM Greeting WHERE count > ?", values: [ 1 ] }
+        ]).then(function(results) {
+            if (results.length !== 3 || results[1].rowsAffected !== 2)
+                throw "unexpected results"
+            const rows = results[2].rows
+            if (rows.length !== 1 || rows[0].salutee !== "cruel world" || rows[0].count !== 2)
+                throw "unexpected rows"
+            return db.readTransactionAsync([ "DELETE FROM Greeting" ])
+        }).then(function() {
+            throw "read-only transaction succeeded"
+        }, function(error) {
+            if (error.code !== SQLException.SYNTAX_ERR)
+                throw error
+            return db.executeSqlAsync("SELECT COUNT(*) AS greetings FROM Greeting")
+        }).then(function(rs) {
+            result = rs.rows[0].greetings === 2 ? "passed" : "wrong count " + rs.rows[0].greetings
+        }).catch(function(error) {
+            result = "failed: " + error
+        })
+    }
+}
@@ -40,6 +40,7 @@ private slots:
     void testQml_cleanopen();
     void totalDatabases();
     void upgradeDatabase();
+    void asyncTransactions();
 
     void cleanupTestCase();
 
@@ -193,6 +194,21 @@ void tst_qqmlsqldatabase::upgradeDatabase()
     QCOMPARE(object->property("version").toString(), QLatin1String("22"));
 }
 
+void tst_qqmlsqldatabase::asyncTransactions()
+{
+    if (engine->offlineStoragePath().isEmpty())
+        QSKIP("offlineStoragePath is empty, skip this test.");
+
+    engine->setOfflineStoragePath(dbDir());
+    QQmlComponent component(engine, testFileUrl("async.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(object, qPrintable(component.errorString()));
+
+    // The transactions run on the connection thread and settle their promises later.
+    QVERIFY(object->property("result").toString().isEmpty());
+    QTRY_COMPARE(object->property("result").toString(), QLatin1String("passed"));
+}
+
 QTEST_MAIN(tst_qqmlsqldatabase)
 
 #include "tst_qqmlsqldatabase.moc"
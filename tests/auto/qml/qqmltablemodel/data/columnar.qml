@@ -0,0 +1,30 @@
+import QtQml
+import Qt.labs.qmlmodels
+
+QtObject {
+    id: root
+
+    property TableModel testModel: TableModel {
+        storage: TableModel.ColumnarStorage
+
+        TableModelColumn { display: "name" }
+        TableModelColumn { display: "age" }
+        TableModelColumn { display: "member" }
+
+        rows: [
+            { name: "John", age: 22, member: true, note: "unused" },
+            { name: "Oliver", age: 33, member: false, note: "unused" }
+        ]
+    }
+
+    function appendRow(personName, personAge, isMember) {
+        testModel.appendRow({ name: personName, age: personAge, member: isMember })
+    }
+
+    function setRows(count) {
+        let rows = []
+        for (let i = 0; i < count; ++i)
+            rows.push({ name: "Person " + i, age: i, member: i % 2 === 0 })
+        testModel.rows = rows
+    }
+}
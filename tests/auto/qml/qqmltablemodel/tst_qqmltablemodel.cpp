@@ -3,6 +3,8 @@
 
 #include <QtTest/qtest.h>
 #include <QtTest/qsignalspy.h>
+#include <QtCore/qcborarray.h>
+#include <QtCore/qcbormap.h>
 #include <QtCore/qregularexpression.h>
 #include <QtCore/qabstractitemmodel.h>
 #include <QtQml/private/qqmlengine_p.h>
@@ -36,6 +38,7 @@ private slots:
     void omitTableModelColumnIndex();
     void complexRow();
     void appendRowWithDouble();
+    void columnarStorage();
 };
 
 void tst_QQmlTableModel::appendRemoveRow()
@@ -997,6 +1000,90 @@ void tst_QQmlTableModel::appendRowWithDouble()
     QCOMPARE(tableView->columns(), 2);
 }
 
+void tst_QQmlTableModel::columnarStorage()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("columnar.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+
+    auto *model = root->property("testModel").value<QAbstractTableModel*>();
+    QVERIFY(model);
+    QCOMPARE(model->property("storage").toInt(), 1);
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->columnCount(), 3);
+
+    const int roleKey = model->roleNames().key("display");
+    QCOMPARE(model->data(model->index(0, 0), roleKey), QVariant(QLatin1String("John")));
+    QCOMPARE(model->data(model->index(1, 1), roleKey), QVariant(33));
+    QCOMPARE(model->data(model->index(1, 2), roleKey), QVariant(false));
+
+    // Only the properties that a column refers to are stored.
+    QVariant returnValue;
+    QVERIFY(QMetaObject::invokeMethod(model, "getRow", Q_RETURN_ARG(QVariant, returnValue), Q_ARG(int, 0)));
+    const QVariantMap expectedRow = {
+        { QLatin1String("name"), QLatin1String("John") },
+        { QLatin1String("age"), 22 },
+        { QLatin1String("member"), true }
+    };
+    QCOMPARE(returnValue.toMap(), expectedRow);
+
+    // A double in an integer column is kept as it is.
+    QVERIFY(QMetaObject::invokeMethod(root.data(), "appendRow", Q_ARG(QVariant, QLatin1String("Ann")),
+                                      Q_ARG(QVariant, 41.5), Q_ARG(QVariant, true)));
+    QCOMPARE(model->rowCount(), 3);
+    QCOMPARE(model->data(model->index(2, 0), roleKey), QVariant(QLatin1String("Ann")));
+    QCOMPARE(model->data(model->index(2, 1), roleKey), QVariant(41.5));
+
+    QVERIFY(QMetaObject::invokeMethod(model, "moveRow", Q_ARG(int, 2), Q_ARG(int, 0), Q_ARG(int, 1)));
+    QCOMPARE(model->data(model->index(0, 0), roleKey), QVariant(QLatin1String("Ann")));
+    QCOMPARE(model->data(model->index(1, 0), roleKey), QVariant(QLatin1String("John")));
+    QCOMPARE(model->data(model->index(2, 0), roleKey), QVariant(QLatin1String("Oliver")));
+
+    QVERIFY(QMetaObject::invokeMethod(model, "removeRow", Q_ARG(int, 1), Q_ARG(int, 1)));
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->data(model->index(1, 0), roleKey), QVariant(QLatin1String("Oliver")));
+
+    // Values set through setData() are converted to the type of the column.
+    QVERIFY(model->setData(model->index(1, 1), QLatin1String("44"), roleKey));
+    QCOMPARE(model->data(model->index(1, 1), roleKey), QVariant(44));
+
+    QSignalSpy rowCountSpy(model, SIGNAL(rowCountChanged()));
+    QVERIFY(QMetaObject::invokeMethod(root.data(), "setRows", Q_ARG(QVariant, 1000)));
+    QCOMPARE(model->rowCount(), 1000);
+    QCOMPARE(rowCountSpy.size(), 1);
+    QCOMPARE(model->data(model->index(999, 0), roleKey), QVariant(QLatin1String("Person 999")));
+    QCOMPARE(model->data(model->index(999, 1), roleKey), QVariant(999));
+    QCOMPARE(model->data(model->index(998, 2), roleKey), QVariant(true));
+
+    QCborArray cborRows;
+    for (int i = 0; i < 10; ++i) {
+        cborRows.append(QCborMap {
+            { QLatin1String("name"), QString::fromLatin1("Cbor %1").arg(i) },
+            { QLatin1String("age"), i * 10 },
+            { QLatin1String("member"), false }
+        });
+    }
+    QVERIFY(QMetaObject::invokeMethod(model, "setRowsFromCbor",
+                                      Q_ARG(QByteArray, QCborValue(cborRows).toCbor())));
+    QCOMPARE(model->rowCount(), 10);
+    QCOMPARE(model->data(model->index(9, 0), roleKey), QVariant(QLatin1String("Cbor 9")));
+    QCOMPARE(model->data(model->index(9, 1), roleKey), QVariant(90));
+    QCOMPARE(model->data(model->index(9, 2), roleKey), QVariant(false));
+
+    // Rows that don't fit the columns are rejected as a whole.
+    cborRows.append(QCborMap {
+        { QLatin1String("name"), QLatin1String("Invalid") },
+        { QLatin1String("age"), QLatin1String("Invalid") },
+        { QLatin1String("member"), false }
+    });
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(
+        ".*setRowsFromCbor\\(\\): expected the property named \"age\" in row at index 10 to be of type \"int\", but got \"QString\" instead"));
+    QVERIFY(QMetaObject::invokeMethod(model, "setRowsFromCbor",
+                                      Q_ARG(QByteArray, QCborValue(cborRows).toCbor())));
+    QCOMPARE(model->rowCount(), 10);
+}
+
 QTEST_MAIN(tst_QQmlTableModel)
 
 #include "tst_qqmltablemodel.moc"
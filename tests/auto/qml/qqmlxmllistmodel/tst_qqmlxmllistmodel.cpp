@@ -47,6 +47,7 @@ private slots:
     void source_data();
     void data();
     void reload();
+    void chunks();
     void threading();
     void threading_data();
     void propertyChanges();
@@ -455,6 +456,42 @@ void tst_QQmlXmlListModel::reload()
     QCOMPARE(spyRemove[0][2].toInt(), 8);
 }
 
+void tst_QQmlXmlListModel::chunks()
+{
+    QQmlComponent component(&engine, testFileUrl("chunks.qml"));
+    QScopedPointer<QAbstractItemModel> model(
+            qobject_cast<QAbstractItemModel *>(component.create()));
+    QVERIFY(model != nullptr);
+    QCOMPARE(model->property("chunkSize").toInt(), 4);
+
+    QSignalSpy spyInsert(model.get(), SIGNAL(rowsInserted(QModelIndex, int, int)));
+    QSignalSpy spyRemove(model.get(), SIGNAL(rowsRemoved(QModelIndex, int, int)));
+    QTRY_COMPARE(model->property("status").toInt(), 1); // Ready
+    QCOMPARE(model->rowCount(), 9);
+
+    // Two full chunks while parsing, and the rest when the query is finished
+    QCOMPARE(spyInsert.size(), 3);
+    QCOMPARE(spyInsert[0][1].toInt(), 0);
+    QCOMPARE(spyInsert[0][2].toInt(), 3);
+    QCOMPARE(spyInsert[1][1].toInt(), 4);
+    QCOMPARE(spyInsert[1][2].toInt(), 7);
+    QCOMPARE(spyInsert[2][1].toInt(), 8);
+    QCOMPARE(spyInsert[2][2].toInt(), 8);
+    QCOMPARE(spyRemove.size(), 0);
+
+    QModelIndex index = model->index(3, 0);
+    QCOMPARE(model->data(index, Qt::UserRole).toString(), QLatin1String("Spot"));
+    QCOMPARE(model->data(index, Qt::UserRole + 2).toInt(), 9);
+
+    // The first chunk of a reload replaces the previous items
+    spyInsert.clear();
+    QMetaObject::invokeMethod(model.get(), "reload");
+    QTRY_COMPARE(model->property("status").toInt(), 1);
+    QCOMPARE(model->rowCount(), 9);
+    QCOMPARE(spyRemove.size(), 1);
+    QCOMPARE(spyInsert.size(), 3);
+}
+
 void tst_QQmlXmlListModel::threading()
 {
     QFETCH(int, xmlDataCount);
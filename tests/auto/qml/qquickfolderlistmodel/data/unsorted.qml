@@ -0,0 +1,6 @@
+import Qt.labs.folderlistmodel 1.0
+
+FolderListModel {
+    showDirs: false
+    sortField: FolderListModel.Unsorted
+}
@@ -51,6 +51,9 @@ private slots:
     void sortCaseSensitive();
     void updateProperties();
     void importBothVersions();
+    void incrementalUpdates();
+    void pagedPopulation();
+    void setFolderTwice();
 private:
     QQmlEngine engine;
 
@@ -186,12 +189,15 @@ void tst_qquickfolderlistmodel::nameFilters()
     QTRY_COMPARE(flm->property("count").toInt(),3); // all files visible
 
     int count = flm->rowCount();
+    QSignalSpy removedSpy(flm, SIGNAL(rowsRemoved(QModelIndex,int,int)));
     flm->setProperty("nameFilters", QStringList() << "*.txt");
-    // _q_directoryUpdated triggered with range 0:1
+    // _q_directoryUpdated only removes the rows that no longer match
     QTRY_COMPARE(flm->property("count").toInt(),1);
     QCOMPARE(flm->data(flm->index(0),FileNameRole), QVariant("test.txt"));
-    QCOMPARE(removeStart, 0);
-    QCOMPARE(removeEnd, count-1);
+    int removedRows = 0;
+    for (const QList<QVariant> &args : std::as_const(removedSpy))
+        removedRows += args.at(2).toInt() - args.at(1).toInt() + 1;
+    QCOMPARE(removedRows, count-1);
 
     flm->setProperty("nameFilters", QStringList() << "*.html");
     QTRY_COMPARE(flm->property("count").toInt(),2);
@@ -450,6 +456,122 @@ void tst_qquickfolderlistmodel::importBothVersions()
     }
 }
 
+void tst_qquickfolderlistmodel::incrementalUpdates()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    auto touch = [&dir](const QString &name, const QByteArray &contents = QByteArray()) {
+        QFile file(dir.filePath(name));
+        return file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size();
+    };
+    QVERIFY(touch("a.txt"));
+    QVERIFY(touch("c.txt"));
+    QVERIFY(touch("e.txt"));
+
+    QQmlComponent component(&engine, testFileUrl("resetFiltering.qml"));
+    QTRY_VERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QAbstractListModel> flm(qobject_cast<QAbstractListModel*>(component.create()));
+    QVERIFY(flm);
+
+    flm->setProperty("folder", QUrl::fromLocalFile(dir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), 3);
+    QTRY_COMPARE(flm->property("status").toInt(), int(Ready));
+
+    QSignalSpy resetSpy(flm.data(), SIGNAL(modelReset()));
+    QSignalSpy insertedSpy(flm.data(), SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy removedSpy(flm.data(), SIGNAL(rowsRemoved(QModelIndex,int,int)));
+
+    // A new file is inserted at its sorted position; the other rows stay.
+    QVERIFY(touch("b.txt"));
+    QTRY_COMPARE(flm->property("count").toInt(), 4);
+    QCOMPARE(insertedSpy.size(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 1);
+    QCOMPARE(insertedSpy.at(0).at(2).toInt(), 1);
+    QCOMPARE(flm->data(flm->index(1), FileNameRole), QVariant("b.txt"));
+    QCOMPARE(removedSpy.size(), 0);
+
+    // Removing a file removes just its row.
+    QVERIFY(QFile::remove(dir.filePath("c.txt")));
+    QTRY_COMPARE(flm->property("count").toInt(), 3);
+    QCOMPARE(removedSpy.size(), 1);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 2);
+    QCOMPARE(removedSpy.at(0).at(2).toInt(), 2);
+    QCOMPARE(flm->data(flm->index(0), FileNameRole), QVariant("a.txt"));
+    QCOMPARE(flm->data(flm->index(1), FileNameRole), QVariant("b.txt"));
+    QCOMPARE(flm->data(flm->index(2), FileNameRole), QVariant("e.txt"));
+
+    QCOMPARE(insertedSpy.size(), 1);
+    QCOMPARE(resetSpy.size(), 0);
+}
+
+void tst_qquickfolderlistmodel::pagedPopulation()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const int fileCount = 1000;
+    for (int i = 0; i < fileCount; ++i) {
+        QFile file(dir.filePath(QString::fromLatin1("file%1.txt").arg(i)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    QQmlComponent component(&engine, testFileUrl("unsorted.qml"));
+    QTRY_VERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QAbstractListModel> flm(qobject_cast<QAbstractListModel*>(component.create()));
+    QVERIFY(flm);
+
+    QSignalSpy insertedSpy(flm.data(), SIGNAL(rowsInserted(QModelIndex,int,int)));
+    flm->setProperty("folder", QUrl::fromLocalFile(dir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), fileCount);
+
+    // The first page ends the reset, the rest is appended page by page.
+    QVERIFY(insertedSpy.size() > 0);
+    for (const QList<QVariant> &args : std::as_const(insertedSpy))
+        QVERIFY(args.at(1).toInt() > 0);
+    QCOMPARE(insertedSpy.last().at(2).toInt(), fileCount - 1);
+
+    QSet<QString> names;
+    for (int i = 0; i < fileCount; ++i)
+        names.insert(flm->data(flm->index(i), FileNameRole).toString());
+    QCOMPARE(names.size(), fileCount);
+}
+
+void tst_qquickfolderlistmodel::setFolderTwice()
+{
+    QTemporaryDir first;
+    QTemporaryDir second;
+    QVERIFY(first.isValid());
+    QVERIFY(second.isValid());
+    QFile file(second.filePath("a.txt"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    QQmlComponent component(&engine, testFileUrl("resetFiltering.qml"));
+    QTRY_VERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QAbstractListModel> flm(qobject_cast<QAbstractListModel*>(component.create()));
+    QVERIFY(flm);
+    QTRY_COMPARE(flm->property("status").toInt(), int(Ready));
+
+    QSignalSpy aboutToBeResetSpy(flm.data(), SIGNAL(modelAboutToBeReset()));
+    QSignalSpy resetSpy(flm.data(), SIGNAL(modelReset()));
+
+    // The listing of the first folder is superseded before it arrives.
+    flm->setProperty("folder", QUrl::fromLocalFile(first.path()));
+    flm->setProperty("folder", QUrl::fromLocalFile(second.path()));
+    QTRY_COMPARE(resetSpy.size(), 1);
+    QCOMPARE(aboutToBeResetSpy.size(), 1);
+    QCOMPARE(flm->property("count").toInt(), 1);
+    QCOMPARE(flm->data(flm->index(0), FileNameRole), QVariant("a.txt"));
+
+    // A missing folder ends the reset still pending for the previous one.
+    flm->setProperty("folder", QUrl::fromLocalFile(first.path()));
+    flm->setProperty("folder", QUrl::fromLocalFile(first.filePath("missing")));
+    QCOMPARE(resetSpy.size(), aboutToBeResetSpy.size());
+    QCOMPARE(flm->property("count").toInt(), 0);
+    QTest::qWait(50);
+    QCOMPARE(resetSpy.size(), aboutToBeResetSpy.size());
+    QCOMPARE(flm->property("count").toInt(), 0);
+}
+
 QTEST_MAIN(tst_qquickfolderlistmodel)
 
 #include "tst_qquickfolderlistmodel.moc"
@@ -0,0 +1,36 @@
+import QtQml
+import QtQml.WorkerScript
+
+QtObject {
+    property int responses: 0
+
+    property WorkerScript first: WorkerScript {
+        group: "a"
+        source: "script.js"
+        onMessage: ++responses
+    }
+    property WorkerScript second: WorkerScript {
+        group: "a"
+        source: "script.js"
+        onMessage: ++responses
+    }
+    property WorkerScript third: WorkerScript {
+        group: "b"
+        source: "script.js"
+        onMessage: ++responses
+    }
+    property WorkerScript fourth: WorkerScript {
+        priority: WorkerScript.HighPriority
+        source: "script.js"
+        onMessage: ++responses
+    }
+    property WorkerScript ungrouped: WorkerScript {
+        source: "script.js"
+        onMessage: ++responses
+    }
+
+    function sendAll() {
+        for (const worker of [first, second, third, fourth, ungrouped])
+            worker.sendMessage(1)
+    }
+}
@@ -0,0 +1,35 @@
+import QtQml
+import QtQml.WorkerScript
+
+WorkerScript {
+    id: worker
+    source: "script.js"
+
+    property int sentLength: -1
+    property var response
+
+    signal done()
+
+    function send() {
+        const samples = new Float64Array(1024)
+        for (let i = 0; i < samples.length; ++i)
+            samples[i] = i / 2
+        worker.sendMessage({ samples: samples, view: new Uint8Array(samples.buffer, 8, 8) },
+                           [ samples.buffer ])
+        sentLength = samples.length
+    }
+
+    function sendInvalid() {
+        try {
+            worker.sendMessage({}, [ 1 ])
+        } catch (e) {
+            return e instanceof TypeError
+        }
+        return false
+    }
+
+    onMessage: (messageObject) => {
+        worker.response = messageObject
+        worker.done()
+    }
+}
@@ -6,6 +6,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qregularexpression.h>
+#include <QtCore/qscopeguard.h>
 #include <QtQml/qjsengine.h>
 
 #include <QtQml/qqmlcomponent.h>
@@ -36,6 +37,8 @@ private slots:
     void script_var();
     void stressDispose();
     void xmlHttpRequest();
+    void threadPool();
+    void transferArrayBuffer();
 
 private:
     void waitForEchoMessage(QQuickWorkerScript *worker) {
@@ -330,6 +333,84 @@ void tst_QQuickWorkerScript::xmlHttpRequest()
     QVERIFY(root);
 }
 
+void tst_QQuickWorkerScript::threadPool()
+{
+    qputenv("QT_QML_WORKERSCRIPT_MAX_THREADS", "8");
+    auto unsetEnv = qScopeGuard([] { qunsetenv("QT_QML_WORKERSCRIPT_MAX_THREADS"); });
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("worker_pool.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+
+    auto worker = [&](const char *name) {
+        return root->property(name).value<QQuickWorkerScript *>();
+    };
+    QCOMPARE(worker("first")->group(), QStringLiteral("a"));
+    QCOMPARE(worker("fourth")->priority(), QQuickWorkerScript::HighPriority);
+    QTRY_VERIFY(worker("ungrouped")->ready());
+
+    // The shared thread plus one for each group and one for the worker with a priority.
+    const QList<QThread *> threads = engine.findChildren<QThread *>(Qt::FindDirectChildrenOnly);
+    QCOMPARE(threads.size(), 4);
+    QVERIFY(std::any_of(threads.cbegin(), threads.cend(), [](QThread *thread) {
+        return thread->priority() == QThread::HighPriority;
+    }));
+    QCOMPARE(QQmlEnginePrivate::get(&engine)->workerScriptEngine->priority(),
+             QThread::LowestPriority);
+
+    // A shared pool thread runs at the highest priority its workers ask for.
+    auto threadsAt = [&](QThread::Priority priority) {
+        return std::count_if(threads.cbegin(), threads.cend(), [priority](QThread *thread) {
+            return thread->priority() == priority;
+        });
+    };
+    worker("first")->setPriority(QQuickWorkerScript::HighestPriority);
+    QCOMPARE(threadsAt(QThread::HighestPriority), 1);
+    worker("second")->setPriority(QQuickWorkerScript::LowPriority);
+    QCOMPARE(threadsAt(QThread::HighestPriority), 1);
+    worker("first")->setPriority(QQuickWorkerScript::NormalPriority);
+    QCOMPARE(threadsAt(QThread::HighestPriority), 0);
+    QCOMPARE(threadsAt(QThread::NormalPriority), 1);
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(
+            ".*Cannot inherit the priority of an established WorkerScript"));
+    worker("first")->setPriority(QQuickWorkerScript::InheritPriority);
+    QCOMPARE(worker("first")->priority(), QQuickWorkerScript::NormalPriority);
+    QCOMPARE(threadsAt(QThread::NormalPriority), 1);
+
+    QVERIFY(QMetaObject::invokeMethod(root.data(), "sendAll"));
+    QTRY_COMPARE(root->property("responses").toInt(), 5);
+}
+
+void tst_QQuickWorkerScript::transferArrayBuffer()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker_transfer.qml"));
+    QScopedPointer<QQuickWorkerScript> worker(qobject_cast<QQuickWorkerScript *>(component.create()));
+    QVERIFY2(worker, qPrintable(component.errorString()));
+    QTRY_VERIFY(worker->ready());
+
+    QVERIFY(QMetaObject::invokeMethod(worker.data(), "send"));
+    // The storage was handed over, which detaches the buffer on this side.
+    QCOMPARE(worker->property("sentLength").toInt(), 0);
+    waitForEchoMessage(worker.data());
+
+    const QJSValue response = worker->property("response").value<QJSValue>();
+    const QJSValue samples = response.property("samples");
+    QCOMPARE(samples.property("length").toInt(), 1024);
+    QCOMPARE(samples.property(1023).toNumber(), 511.5);
+    const QJSValue view = response.property("view");
+    QCOMPARE(view.property("byteOffset").toInt(), 8);
+    QCOMPARE(view.property("length").toInt(), 8);
+    // Both views still share one buffer after the round trip.
+    QVERIFY(view.property("buffer").strictlyEquals(samples.property("buffer")));
+
+    QVariant invalidRejected;
+    QVERIFY(QMetaObject::invokeMethod(worker.data(), "sendInvalid",
+                                      Q_RETURN_ARG(QVariant, invalidRejected)));
+    QVERIFY(invalidRejected.toBool());
+}
+
 QTEST_MAIN(tst_QQuickWorkerScript)
 
 #include "tst_qquickworkerscript.moc"
@@ -16,6 +16,7 @@
 #include <QtQuick/private/qquickshadereffectsource_p.h>
 #include <QtQuick/private/qquicktaphandler_p.h>
 #include <QtQuick/private/qquickwindow_p.h>
+#include <QtQuick/private/qquickdeliveryagent_p_p.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include <QtQuickTestUtils/private/visualtestutils_p.h>
 #include <QtQuickTestUtils/private/viewtestutils_p.h>
@@ -59,6 +60,25 @@ struct HoverItem : public QQuickItem
     bool block = false;
 };
 
+struct PressItem : public QQuickItem
+{
+    PressItem(QQuickItem *parent) : QQuickItem(parent)
+    {
+        setAcceptedMouseButtons(Qt::LeftButton);
+    }
+    void mousePressEvent(QMouseEvent *e) override
+    {
+        ++presses;
+        e->accept();
+    }
+    void mouseReleaseEvent(QMouseEvent *e) override
+    {
+        e->accept();
+    }
+
+    int presses = 0;
+};
+
 // A QQuick3DViewport simulator
 class SubsceneRootItem : public QQuickShaderEffectSource
 {
@@ -138,6 +158,7 @@ private slots:
     void hoverPropagation_nested_data();
     void hoverPropagation_nested();
     void hoverPropagation_siblings();
+    void pointerBoundsIndex();
 
 private:
     QScopedPointer<QPointingDevice> touchDevice = QScopedPointer<QPointingDevice>(QTest::createTouchDevice());
@@ -521,6 +542,84 @@ void tst_qquickdeliveryagent::hoverPropagation_siblings()
     QCOMPARE(sibling2.hoverEnter, true);
 }
 
+void tst_qquickdeliveryagent::pointerBoundsIndex()
+{
+    // Check that the pointer bounds index follows items that are moved,
+    // resized, hidden or reparented, and pointer handlers that are added
+    // or removed, so that no item is skipped where it can be hit.
+    const bool wasEnabled = QQuickDeliveryAgentPrivate::pointerBoundsIndexEnabled;
+    QQuickDeliveryAgentPrivate::pointerBoundsIndexEnabled = true;
+    const auto restore = qScopeGuard([wasEnabled] {
+        QQuickDeliveryAgentPrivate::pointerBoundsIndexEnabled = wasEnabled;
+    });
+
+    QQuickWindow window;
+    window.resize(300, 300);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QQuickItem container(window.contentItem());
+    PressItem target(&container);
+    target.setSize(QSizeF(50, 50));
+    QQuickItem otherContainer(window.contentItem());
+    otherContainer.setPosition(QPointF(0, 200));
+
+    auto pressesAt = [&](const QPoint &pos) {
+        const int before = target.presses;
+        QTest::mouseClick(&window, Qt::LeftButton, Qt::NoModifier, pos);
+        return target.presses - before;
+    };
+
+    QCOMPARE(pressesAt(QPoint(25, 25)), 1);
+    QCOMPARE(pressesAt(QPoint(125, 25)), 0);
+
+    // Moving the item
+    target.setX(100);
+    QCOMPARE(pressesAt(QPoint(125, 25)), 1);
+    QCOMPARE(pressesAt(QPoint(25, 25)), 0);
+
+    // Moving an ancestor, which leaves the bounds of the item itself as they are
+    container.setY(100);
+    QCOMPARE(pressesAt(QPoint(125, 125)), 1);
+    QCOMPARE(pressesAt(QPoint(125, 25)), 0);
+
+    // Resizing the item
+    target.setWidth(100);
+    QCOMPARE(pressesAt(QPoint(175, 125)), 1);
+
+    // Hiding and showing the item, and an ancestor
+    target.setVisible(false);
+    QCOMPARE(pressesAt(QPoint(125, 125)), 0);
+    target.setVisible(true);
+    QCOMPARE(pressesAt(QPoint(125, 125)), 1);
+    container.setVisible(false);
+    QCOMPARE(pressesAt(QPoint(125, 125)), 0);
+    container.setVisible(true);
+    QCOMPARE(pressesAt(QPoint(125, 125)), 1);
+
+    // Reparenting the item
+    target.setParentItem(&otherContainer);
+    QCOMPARE(pressesAt(QPoint(125, 225)), 1);
+    QCOMPARE(pressesAt(QPoint(125, 125)), 0);
+
+    // Adding a handler that accepts points outside of the item
+    auto *tapHandler = new QQuickTapHandler(&target);
+    tapHandler->setMargin(20);
+    QSignalSpy tappedSpy(tapHandler, &QQuickTapHandler::tapped);
+    QTest::mouseClick(&window, Qt::LeftButton, Qt::NoModifier, QPoint(90, 225));
+    QCOMPARE(tappedSpy.size(), 1);
+    QVERIFY(QQuickItemPrivate::get(&target)->extra->pointerBoundsUnbounded);
+
+    // Removing it again
+    delete tapHandler;
+    QVERIFY(QQuickItemPrivate::get(&target)->pointerBoundsDirty);
+    QVERIFY(QQuickItemPrivate::get(&otherContainer)->pointerBoundsDirty);
+    QVERIFY(QQuickItemPrivate::get(window.contentItem())->pointerBoundsDirty);
+    QCOMPARE(pressesAt(QPoint(125, 225)), 1);
+    QVERIFY(!QQuickItemPrivate::get(&target)->extra->pointerBoundsUnbounded);
+    QVERIFY(!QQuickItemPrivate::get(window.contentItem())->extra->pointerBoundsUnbounded);
+}
+
 QTEST_MAIN(tst_qquickdeliveryagent)
 
 #include "tst_qquickdeliveryagent.moc"
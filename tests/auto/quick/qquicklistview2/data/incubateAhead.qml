@@ -0,0 +1,14 @@
+import QtQuick
+
+ListView {
+    width: 200
+    height: 200
+    cacheBuffer: 40
+    model: 1000
+    delegate: Rectangle {
+        required property int index
+        width: ListView.view.width
+        height: 20
+        color: index % 2 ? "lightsteelblue" : "beige"
+    }
+}
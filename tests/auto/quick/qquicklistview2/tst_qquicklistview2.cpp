@@ -49,6 +49,7 @@ private slots:
     void maxExtent();
     void isCurrentItem_DelegateModel();
     void isCurrentItem_NoRegressionWithDelegateModelGroups();
+    void incubateAheadOfFlick();
 
 private:
     void flickWithTouch(QQuickWindow *window, const QPoint &from, const QPoint &to);
@@ -909,6 +910,44 @@ void tst_QQuickListView2::isCurrentItem_NoRegressionWithDelegateModelGroups()
     QCOMPARE(item3->property("isCurrent").toBool(), false);
 }
 
+void tst_QQuickListView2::incubateAheadOfFlick()
+{
+    // Same as running with QML_VIEW_INCUBATION_LOOKAHEAD=500.
+    const int lookahead = QQuickItemViewPrivate::incubationLookahead;
+    QQuickItemViewPrivate::incubationLookahead = 500;
+    auto restore = qScopeGuard([lookahead] {
+        QQuickItemViewPrivate::incubationLookahead = lookahead;
+    });
+
+    QQuickView window;
+    QVERIFY(QQuickTest::showView(window, testFileUrl("incubateAhead.qml")));
+    QQuickListView *listView = qobject_cast<QQuickListView *>(window.rootObject());
+    QVERIFY(listView);
+    QQuickItemViewPrivate *listViewPrivate = QQuickItemViewPrivate::get(listView);
+
+    // Track how far past the cache buffer delegates exist while flicking.
+    qreal furthestAhead = 0;
+    connect(listView, &QQuickFlickable::contentYChanged, this, [&] {
+        if (!listView->isFlicking())
+            return;
+        qreal end = 0;
+        for (FxViewItem *item : std::as_const(listViewPrivate->visibleItems))
+            end = qMax(end, item->endPosition());
+        const qreal bufferEnd = listView->contentY() + listView->height() + listView->cacheBuffer();
+        furthestAhead = qMax(furthestAhead, end - bufferEnd);
+    });
+
+    listView->flick(0, -3000);
+    QVERIFY(listView->isFlicking());
+    QTRY_VERIFY_WITH_TIMEOUT(!listView->isFlicking(), 10000);
+
+    // The lookahead delegates are incubated asynchronously, from the polish
+    // pass rather than from within viewportMoved().
+    QCOMPARE_GT(furthestAhead, 2 * 20);
+    QVERIFY(!listViewPrivate->incubateAheadPending);
+    QCOMPARE_GT(listViewPrivate->flickFrameCount, 0);
+}
+
 QTEST_MAIN(tst_QQuickListView2)
 
 #include "tst_qquicklistview2.moc"
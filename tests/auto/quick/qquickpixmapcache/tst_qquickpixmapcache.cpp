@@ -30,8 +30,10 @@ private slots:
     void parallel();
     void parallel_data();
     void massive();
+    void parallelDecoding();
     void cancelcrash();
     void shrinkcache();
+    void cacheLimits();
 #if QT_CONFIG(concurrent)
     void networkCrash();
 #endif
@@ -260,6 +262,52 @@ void tst_qquickpixmapcache::parallel()
     qDeleteAll(pixmaps);
 }
 
+void tst_qquickpixmapcache::parallelDecoding()
+{
+    QQmlEngine engine;
+    const QUrl url = testFileUrl("exists.png");
+    const int count = 64;
+
+    // Distinct request sizes, so that every pixmap needs its own decode.
+    QList<QQuickPixmap *> pixmaps;
+    QList<Slotter *> getters;
+    for (int i = 0; i < count; ++i) {
+        QQuickPixmap *pixmap = new QQuickPixmap;
+        pixmap->load(&engine, url, QRect(), QSize(i + 1, i + 1),
+                     QQuickPixmap::Asynchronous | QQuickPixmap::Cache);
+        QVERIFY(pixmap->isLoading());
+        if (i % 4 == 0)
+            pixmap->setLoadPriority(QQuickPixmap::LowPriority);
+        Slotter *getter = new Slotter;
+        QVERIFY(pixmap->connectFinished(getter, SLOT(got())));
+        pixmaps.append(pixmap);
+        getters.append(getter);
+    }
+
+    // Release some of them, likely before they got decoded.
+    for (int i = 1; i < count; i += 3) {
+        pixmaps[i]->clear(getters[i]);
+        slotters--;
+    }
+
+    QTestEventLoop::instance().enterLoop(10);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+
+    for (int i = 0; i < count; ++i) {
+        if (i % 3 == 1) {
+            QVERIFY(!getters[i]->gotslot);
+            continue;
+        }
+        QVERIFY(getters[i]->gotslot);
+        QVERIFY(pixmaps[i]->isReady());
+        QCOMPARE(pixmaps[i]->implicitSize(), QSize(100, 100));
+        QCOMPARE(pixmaps[i]->width(), i + 1);
+    }
+
+    qDeleteAll(getters);
+    qDeleteAll(pixmaps);
+}
+
 void tst_qquickpixmapcache::massive()
 {
     QQmlEngine engine;
@@ -339,6 +387,53 @@ void tst_qquickpixmapcache::shrinkcache()
     }
 }
 
+void tst_qquickpixmapcache::cacheLimits()
+{
+    QQmlEngine engine;
+    const QUrl url1 = testFileUrl("exists1.png");
+    const QUrl url2 = testFileUrl("exists2.png");
+    const qint64 oldUnreferencedLimit = QQuickPixmap::unreferencedCacheLimit();
+    const qint64 oldTotalLimit = QQuickPixmap::totalCacheLimit();
+
+    QQuickPixmap::purgeCache();
+    QQuickPixmap::resetCacheStatistics();
+
+    qint64 cost = 0;
+    {
+        QQuickPixmap p1(&engine, url1);
+        QVERIFY(p1.isReady());
+        cost = p1.textureFactory()->textureByteCount();
+        QCOMPARE(QQuickPixmap::cacheStatistics().misses, quint64(1));
+        QCOMPARE(QQuickPixmap::cacheStatistics().bytes, cost);
+
+        QQuickPixmap p2(&engine, url1);
+        QCOMPARE(QQuickPixmap::cacheStatistics().hits, quint64(1));
+        QCOMPARE(QQuickPixmap::cacheStatistics().unreferencedBytes, qint64(0));
+    }
+    QCOMPARE(QQuickPixmap::cacheStatistics().unreferencedBytes, cost);
+    QVERIFY(QQuickPixmap::isCached(url1, QRect(), QSize(), 0, QQuickImageProviderOptions()));
+
+    // The total limit evicts unreferenced pixmaps when a new one comes in.
+    QQuickPixmap::setTotalCacheLimit(cost);
+    {
+        QQuickPixmap p3(&engine, url2);
+        QVERIFY(p3.isReady());
+        QVERIFY(!QQuickPixmap::isCached(url1, QRect(), QSize(), 0, QQuickImageProviderOptions()));
+        QCOMPARE(QQuickPixmap::cacheStatistics().evictions, quint64(1));
+    }
+    QQuickPixmap::setTotalCacheLimit(-1);
+    QVERIFY(QQuickPixmap::isCached(url2, QRect(), QSize(), 0, QQuickImageProviderOptions()));
+
+    // Shrinking the unreferenced limit evicts right away.
+    QQuickPixmap::setUnreferencedCacheLimit(0);
+    QVERIFY(!QQuickPixmap::isCached(url2, QRect(), QSize(), 0, QQuickImageProviderOptions()));
+    QCOMPARE(QQuickPixmap::cacheStatistics().evictions, quint64(2));
+    QCOMPARE(QQuickPixmap::cacheStatistics().unreferencedBytes, qint64(0));
+
+    QQuickPixmap::setUnreferencedCacheLimit(oldUnreferencedLimit);
+    QQuickPixmap::setTotalCacheLimit(oldTotalLimit);
+}
+
 #if QT_CONFIG(concurrent)
 
 void createNetworkServer(TestHTTPServer *server)
@@ -450,7 +545,6 @@ void tst_qquickpixmapcache::asynchronousNoCache()
     QScopedPointer<QObject> root {component.create()}; // should not crash
 }
 
-
 #if PIXMAP_DATA_LEAK_TEST
 // This test should not be enabled by default as it
 // produces spurious output in the expected case.
@@ -0,0 +1,178 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#include <qtest.h>
+#include <QtTest/QtTest>
+#include <QtQuick/private/qquickpixmapcache_p.h>
+#include <QtQml/qqmlengine.h>
+
+// The disk cache directory is read once per process, when the first image gets loaded.
+// These tests run in a binary of their own so that the other pixmap cache tests keep
+// covering the default, disk cache disabled, path.
+class tst_qquickpixmapdiskcache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void diskCacheRoundTrip();
+    void diskCacheCorruptHeader();
+    void diskCacheHitAfterRestart();
+
+private:
+    QUrl writeDiskCacheSource(const QString &name);
+    QString waitForDiskCacheEntry(const QStringList &existingEntries);
+
+    QQmlEngine engine;
+    QTemporaryDir diskCacheDir;
+};
+
+void tst_qquickpixmapdiskcache::initTestCase()
+{
+    QVERIFY(diskCacheDir.isValid());
+    qputenv("QML_PIXMAP_DISK_CACHE_PATH", diskCacheDir.filePath("cache").toLocal8Bit());
+}
+
+void tst_qquickpixmapdiskcache::cleanupTestCase()
+{
+    qunsetenv("QML_PIXMAP_DISK_CACHE_PATH");
+}
+
+static QStringList diskCacheEntries(const QString &directory)
+{
+    return QDir(directory).entryList({ QStringLiteral("*.qpc") }, QDir::Files);
+}
+
+// Writes an image large enough to be stored in the disk cache.
+QUrl tst_qquickpixmapdiskcache::writeDiskCacheSource(const QString &name)
+{
+    QImage image(256, 256, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    for (int i = 0; i < image.width(); ++i)
+        image.setPixel(i, i, qRgb(0, 255, 0));
+    const QString fileName = diskCacheDir.filePath(name);
+    if (!image.save(fileName))
+        return QUrl();
+    return QUrl::fromLocalFile(fileName);
+}
+
+// Entries are written in the background, wait for the one that is not in existingEntries.
+QString tst_qquickpixmapdiskcache::waitForDiskCacheEntry(const QStringList &existingEntries)
+{
+    const QString directory = diskCacheDir.filePath("cache");
+    QStringList entries;
+    if (!QTest::qWaitFor([&] {
+            entries = diskCacheEntries(directory);
+            return entries.size() > existingEntries.size();
+        })) {
+        return QString();
+    }
+    for (const QString &entry : std::as_const(entries)) {
+        if (!existingEntries.contains(entry))
+            return directory + QLatin1Char('/') + entry;
+    }
+    return QString();
+}
+
+void tst_qquickpixmapdiskcache::diskCacheRoundTrip()
+{
+    const QUrl url = writeDiskCacheSource("roundTrip.png");
+    QVERIFY(url.isValid());
+    const QImage expected = QImage(url.toLocalFile()).convertToFormat(QImage::Format_RGB32);
+    const QStringList existingEntries = diskCacheEntries(diskCacheDir.filePath("cache"));
+
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QQuickPixmap::Options{});
+        QVERIFY(p.isReady());
+        QCOMPARE(p.image().convertToFormat(QImage::Format_RGB32), expected);
+    }
+    QVERIFY(!waitForDiskCacheEntry(existingEntries).isEmpty());
+
+    // Loaded from the disk cache this time.
+    QQuickPixmap p;
+    p.load(&engine, url, QQuickPixmap::Options{});
+    QVERIFY(p.isReady());
+    QCOMPARE(p.implicitSize(), expected.size());
+    QCOMPARE(p.image().convertToFormat(QImage::Format_RGB32), expected);
+}
+
+void tst_qquickpixmapdiskcache::diskCacheCorruptHeader()
+{
+#ifdef Q_OS_WEBOS
+    QSKIP("QQuickPixmap always loads with QQuickPixmap::Cache option in webOS");
+#endif
+    const QUrl url = writeDiskCacheSource("corruptHeader.png");
+    QVERIFY(url.isValid());
+    const QImage expected = QImage(url.toLocalFile()).convertToFormat(QImage::Format_RGB32);
+    const QStringList existingEntries = diskCacheEntries(diskCacheDir.filePath("cache"));
+
+    {
+        QQuickPixmap p;
+        p.load(&engine, url, QQuickPixmap::Options{});
+        QVERIFY(p.isReady());
+    }
+    const QString entry = waitForDiskCacheEntry(existingEntries);
+    QVERIFY(!entry.isEmpty());
+
+    {
+        QFile file(entry);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QCOMPARE(file.write("XXXX", 4), 4);
+    }
+
+    // The entry is ignored and the image decoded again.
+    QQuickPixmap p;
+    p.load(&engine, url, QQuickPixmap::Options{});
+    QVERIFY(p.isReady());
+    QCOMPARE(p.image().convertToFormat(QImage::Format_RGB32), expected);
+
+    // The invalid entry got replaced by a new one.
+    QTRY_VERIFY([&] {
+        QFile file(entry);
+        return file.open(QIODevice::ReadOnly) && file.read(4) == "QPXC";
+    }());
+}
+
+void tst_qquickpixmapdiskcache::diskCacheHitAfterRestart()
+{
+#ifdef Q_OS_WEBOS
+    QSKIP("QQuickPixmap always loads with QQuickPixmap::Cache option in webOS");
+#endif
+    const QUrl url = writeDiskCacheSource("hitAfterRestart.png");
+    QVERIFY(url.isValid());
+    const QStringList existingEntries = diskCacheEntries(diskCacheDir.filePath("cache"));
+
+    {
+        QQmlEngine firstRun;
+        QQuickPixmap p;
+        p.load(&firstRun, url, QQuickPixmap::Options{});
+        QVERIFY(p.isReady());
+    }
+    const QString entry = waitForDiskCacheEntry(existingEntries);
+    QVERIFY(!entry.isEmpty());
+
+    // Change the last pixel of the entry, so that it shows whether the image
+    // was read from the disk cache rather than decoded again.
+    {
+        QFile file(entry);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.seek(file.size() - 4));
+        const quint32 blue = qRgb(0, 0, 255);
+        QCOMPARE(file.write(reinterpret_cast<const char *>(&blue), 4), 4);
+    }
+
+    // A new engine loading without the in-memory cache only has the disk
+    // cache to go by, like the next run of the application would.
+    QQmlEngine secondRun;
+    QQuickPixmap p;
+    p.load(&secondRun, url, QQuickPixmap::Options{});
+    QVERIFY(p.isReady());
+    const QImage image = p.image();
+    QCOMPARE(image.pixel(image.width() - 1, image.height() - 1), qRgb(0, 0, 255));
+    QCOMPARE(image.pixel(0, 0), qRgb(0, 255, 0));
+}
+
+QTEST_MAIN(tst_qquickpixmapdiskcache)
+
+#include "tst_qquickpixmapdiskcache.moc"
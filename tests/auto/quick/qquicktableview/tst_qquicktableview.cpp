@@ -265,6 +265,8 @@ private slots:
     void editWarning_nonEditableModelItem();
     void attachedPropertiesOnEditDelegate();
     void requiredPropertiesOnEditDelegate();
+    void rowSizeIndex();
+    void rowSizesAfterInsertAndRemove();
 };
 
 tst_QQuickTableView::tst_QQuickTableView()
@@ -7126,6 +7128,127 @@ void tst_QQuickTableView::requiredPropertiesOnEditDelegate()
     QCOMPARE(textInput->property("current").toBool(), false);
 }
 
+void tst_QQuickTableView::rowSizeIndex()
+{
+    // Check that the row size index returns the positions of rows
+    // with known heights, and estimates the rest from their average.
+    QQuickTableViewSizeIndex index;
+    index.reset(1000000);
+
+    QCOMPARE(index.position(10, 20), 200.);
+    QCOMPARE(index.indexAt(205, 20), 10);
+
+    index.setSize(0, 10);
+    index.setSize(1, 30);
+    QCOMPARE(index.measuredCount(), 2);
+    QCOMPARE(index.estimatedSize(20), 20.);
+    QCOMPARE(index.position(1, 50), 10.);
+    QCOMPARE(index.position(2, 50), 40.);
+    QCOMPARE(index.position(3, 50), 60.);
+    QCOMPARE(index.totalSize(50), 20000000.);
+
+    index.setSize(500000, 60);
+    QCOMPARE(index.measuredCount(), 3);
+    QCOMPARE(index.estimatedSize(50), 100. / 3);
+    QCOMPARE(index.position(500001, 50), 40 + 499998 * (100. / 3) + 60);
+
+    for (const qreal y : { 0., 9., 10., 39., 40., 1000., 16666700., 33333333. }) {
+        const int row = index.indexAt(y, 50);
+        QVERIFY(index.position(row, 50) <= y);
+        QVERIFY(index.position(row + 1, 50) > y);
+    }
+    QCOMPARE(index.indexAt(-10, 50), 0);
+    QCOMPARE(index.indexAt(1e12, 50), 999999);
+
+    // Changing a size moves everything after it
+    index.setSize(1, 20);
+    QCOMPARE(index.measuredCount(), 3);
+    QCOMPARE(index.position(2, 50), 30.);
+    QCOMPARE(index.indexAt(29, 50), 1);
+    QCOMPARE(index.indexAt(30, 50), 2);
+
+    // Inserting, removing and moving shifts the measured sizes along
+    // with their rows, instead of forgetting them.
+    index.reset(6);
+    index.setSize(1, 10);
+    index.setSize(3, 30);
+    index.insert(2, 2);
+    QCOMPARE(index.count(), 8);
+    QCOMPARE(index.measuredCount(), 2);
+    QCOMPARE(index.position(2, 50), 20. + 10);
+    QCOMPARE(index.position(5, 50), 20. + 10 + 2 * 20 + 20);
+    QCOMPARE(index.position(6, 50), 20. + 10 + 2 * 20 + 20 + 30);
+
+    index.remove(0, 3);
+    QCOMPARE(index.count(), 5);
+    QCOMPARE(index.measuredCount(), 1);
+    QCOMPARE(index.position(2, 50), 2 * 30.);
+    QCOMPARE(index.position(3, 50), 3 * 30.);
+    QCOMPARE(index.indexAt(59, 50), 1);
+    QCOMPARE(index.indexAt(60, 50), 2);
+
+    index.move(2, 4, 1);
+    QCOMPARE(index.position(4, 50), 4 * 30.);
+    QCOMPARE(index.indexAt(119, 50), 3);
+    QCOMPARE(index.indexAt(120, 50), 4);
+    index.move(4, 0, 1);
+    QCOMPARE(index.position(1, 50), 30.);
+    QCOMPARE(index.measuredCount(), 1);
+
+    index.reset(10);
+    QCOMPARE(index.measuredCount(), 0);
+    QCOMPARE(index.totalSize(5), 50.);
+}
+
+void tst_QQuickTableView::rowSizesAfterInsertAndRemove()
+{
+    // Check that the heights measured for rows that have scrolled
+    // out of view are kept when rows are added to or removed from
+    // the model, so that the estimated row positions stay the same.
+    LOAD_TABLEVIEW("alternatingrowheightcolumnwidth.qml");
+
+    TestModel model(200, 5);
+    tableView->setModel(QVariant::fromValue(&model));
+    WAIT_UNTIL_POLISHED;
+
+    // The rows at the top have now been measured
+    const int measuredTopRows = tableViewPrivate->loadedRows.count();
+    const qreal measuredTopHeight = tableViewPrivate->estimatedRowY(measuredTopRows);
+    QCOMPARE(tableViewPrivate->rowSizes.measuredCount(), measuredTopRows);
+
+    // Jump further down, and measure some more rows there
+    tableView->setContentY(tableViewPrivate->estimatedRowY(100));
+    QTRY_VERIFY(tableView->topRow() > measuredTopRows);
+    const int topRow = tableView->topRow();
+    const int measuredCount = tableViewPrivate->rowSizes.measuredCount();
+    QCOMPARE_GT(measuredCount, measuredTopRows);
+    const qreal contentY = tableView->contentY();
+
+    // Insert rows between the two measured areas
+    QVERIFY(topRow > 53);
+    model.insertRows(50, 3);
+    WAIT_UNTIL_POLISHED;
+    QCOMPARE(tableViewPrivate->rowSizes.count(), 203);
+    QCOMPARE_GE(tableViewPrivate->rowSizes.measuredCount(), measuredCount);
+    QCOMPARE(tableViewPrivate->estimatedRowY(measuredTopRows), measuredTopHeight);
+    QCOMPARE(tableView->topRow(), topRow);
+    QCOMPARE(tableView->contentY(), contentY);
+
+    // Remove them again
+    model.removeRows(50, 3);
+    WAIT_UNTIL_POLISHED;
+    QCOMPARE(tableViewPrivate->rowSizes.count(), 200);
+    QCOMPARE_GE(tableViewPrivate->rowSizes.measuredCount(), measuredCount);
+    QCOMPARE(tableViewPrivate->estimatedRowY(measuredTopRows), measuredTopHeight);
+
+    // Scrolling back up should find the top rows where they were measured
+    tableView->setContentY(0);
+    QTRY_COMPARE(tableView->topRow(), 0);
+    QCOMPARE(tableViewPrivate->estimatedRowY(measuredTopRows), measuredTopHeight);
+    const auto item = tableViewPrivate->loadedTableItem(QPoint(0, measuredTopRows - 1))->item;
+    QCOMPARE(item->y() + item->height() + tableView->rowSpacing(), measuredTopHeight);
+}
+
 QTEST_MAIN(tst_QQuickTableView)
 
 #include "tst_qquicktableview.moc"
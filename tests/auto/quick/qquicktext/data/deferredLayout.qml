@@ -0,0 +1,29 @@
+import QtQuick
+
+Item {
+    width: 500
+    height: 500
+
+    Text {
+        id: text
+        objectName: "text"
+        width: 400
+        height: 200
+        wrapMode: Text.WordWrap
+        elide: Text.ElideRight
+        maximumLineCount: 3
+        verticalAlignment: Text.AlignVCenter
+        text: "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog."
+    }
+
+    Text {
+        objectName: "reference"
+        width: 100
+        height: text.height
+        wrapMode: text.wrapMode
+        elide: text.elide
+        maximumLineCount: text.maximumLineCount
+        verticalAlignment: text.verticalAlignment
+        text: text.text
+    }
+}
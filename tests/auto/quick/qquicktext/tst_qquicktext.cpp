@@ -154,6 +154,11 @@ private slots:
 
     void displaySuperscriptedTag();
 
+    void deferredLayout_data();
+    void deferredLayout();
+
+    void sharedGlyphRuns();
+
 private:
     QStringList standard;
     QStringList richText;
@@ -4806,6 +4811,83 @@ void tst_qquicktext::displaySuperscriptedTag()
     QCOMPARE(color.green(), 255);
 }
 
+void tst_qquicktext::deferredLayout_data()
+{
+    QTest::addColumn<QByteArray>("property");
+
+    for (const char *property : { "lineCount", "truncated", "contentWidth", "contentHeight",
+                                  "paintedWidth", "paintedHeight", "advance", "baselineOffset",
+                                  "implicitWidth", "implicitHeight" }) {
+        QTest::newRow(property) << QByteArray(property);
+    }
+}
+
+void tst_qquicktext::deferredLayout()
+{
+    QFETCH(QByteArray, property);
+
+    // Same as running with QML_TEXT_DEFERRED_LAYOUT=1.
+    const bool wasDeferred = QQuickTextPrivate::deferGeometryLayout;
+    QQuickTextPrivate::deferGeometryLayout = true;
+    auto restore = qScopeGuard([wasDeferred] {
+        QQuickTextPrivate::deferGeometryLayout = wasDeferred;
+    });
+
+    QQuickView window;
+    QVERIFY(QQuickTest::showView(window, testFileUrl("deferredLayout.qml")));
+    QQuickText *text = window.rootObject()->findChild<QQuickText *>("text");
+    QVERIFY(text);
+    QQuickText *reference = window.rootObject()->findChild<QQuickText *>("reference");
+    QVERIFY(reference);
+
+    // Reading the value right after the width change has to flush the
+    // layout that was postponed to polish.
+    text->setWidth(reference->width());
+    QVERIFY(QQuickTextPrivate::get(text)->layoutDeferred);
+    QCOMPARE(text->property(property), reference->property(property));
+    QVERIFY(!QQuickTextPrivate::get(text)->layoutDeferred);
+}
+
+static QList<QGlyphRun> sharedGlyphRunsFor(QTextLayout &layout, const QTextOption &option)
+{
+    layout.setTextOption(option);
+    layout.beginLayout();
+    QTextLine line = layout.createLine();
+    line.setLineWidth(200);
+    layout.endLayout();
+    return QQuickTextNode::sharedGlyphRuns(&layout, line);
+}
+
+void tst_qquicktext::sharedGlyphRuns()
+{
+    QQuickTextNode::clearGlyphRunCache();
+    auto cleanup = qScopeGuard([] { QQuickTextNode::clearGlyphRunCache(); });
+
+    const QString text = QStringLiteral("a\tb");
+    QTextLayout first(text, QFont());
+    const QList<QGlyphRun> firstRuns = sharedGlyphRunsFor(first, QTextOption());
+    QVERIFY(!firstRuns.isEmpty());
+    const qreal tabbedX = firstRuns.last().positions().last().x();
+
+    QTextLayout same(text, QFont());
+    QCOMPARE(sharedGlyphRunsFor(same, QTextOption()), firstRuns);
+
+    // The tab stops are part of the key: the glyph after the tab moves.
+    QTextOption wideTabs;
+    wideTabs.setTabStopDistance(150);
+    QTextLayout wide(text, QFont());
+    const QList<QGlyphRun> wideRuns = sharedGlyphRunsFor(wide, wideTabs);
+    QVERIFY(!wideRuns.isEmpty());
+    QCOMPARE_GT(wideRuns.last().positions().last().x(), tabbedX);
+
+    QTextOption explicitTabs;
+    explicitTabs.setTabs({ QTextOption::Tab(40, QTextOption::LeftTab) });
+    QTextLayout narrow(text, QFont());
+    const QList<QGlyphRun> narrowRuns = sharedGlyphRunsFor(narrow, explicitTabs);
+    QVERIFY(!narrowRuns.isEmpty());
+    QCOMPARE_LT(narrowRuns.last().positions().last().x(), tabbedX);
+}
+
 QTEST_MAIN(tst_qquicktext)
 
 #include "tst_qquicktext.moc"
@@ -66,6 +66,10 @@ private slots:
     void textFormat();
     void lineCount_data();
     void lineCount();
+    void append_data();
+    void append();
+    void naturalWidthAfterEdits_data();
+    void naturalWidthAfterEdits();
 
     // ### these tests may be trivial
     void hAlign();
@@ -155,6 +159,8 @@ private slots:
     void getFormattedText();
     void append_data();
     void append();
+    void naturalWidthAfterEdits_data();
+    void naturalWidthAfterEdits();
     void insert_data();
     void insert();
     void remove_data();
@@ -742,6 +748,129 @@ void tst_qquicktextedit::lineCount()
     }
 }
 
+void tst_qquicktextedit::append_data()
+{
+    QTest::addColumn<bool>("implicitResize");
+    QTest::addColumn<bool>("lineCountConnected");
+
+    QTest::newRow("implicit resize") << true << false;
+    QTest::newRow("implicit resize, lineCountChanged connected") << true << true;
+    QTest::newRow("no implicit resize") << false << false;
+    QTest::newRow("no implicit resize, lineCountChanged connected") << false << true;
+}
+
+// Appending lays out only the new blocks; the results have to match a
+// TextEdit that got all of the text at once.
+void tst_qquicktextedit::append()
+{
+    QFETCH(bool, implicitResize);
+    QFETCH(bool, lineCountConnected);
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick\nTextEdit { width: 200; wrapMode: TextEdit.Wrap }", QUrl());
+    QScopedPointer<QQuickTextEdit> textEdit(qobject_cast<QQuickTextEdit *>(component.create()));
+    QVERIFY(textEdit);
+    QScopedPointer<QQuickTextEdit> reference(qobject_cast<QQuickTextEdit *>(component.create()));
+    QVERIFY(reference);
+    QQuickTextEditPrivate::get(textEdit.data())->setImplicitResizeEnabled(implicitResize);
+    QQuickTextEditPrivate::get(reference.data())->setImplicitResizeEnabled(implicitResize);
+
+    // The line count is only kept up to date while lineCountChanged is connected.
+    QList<int> lineCounts;
+    if (lineCountConnected) {
+        connect(textEdit.data(), &QQuickTextEdit::lineCountChanged, this, [&] {
+            lineCounts.append(textEdit->lineCount());
+        });
+    }
+
+    const QString line = QStringLiteral("Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+    QStringList lines;
+    for (int i = 0; i < 20; ++i) {
+        lines.append(line + QString::number(i));
+        textEdit->append(lines.last());
+    }
+    reference->setText(lines.join(QLatin1Char('\n')));
+
+    QCOMPARE_GT(reference->lineCount(), lines.size()); // the lines wrap
+    QCOMPARE(textEdit->lineCount(), reference->lineCount());
+    QCOMPARE(textEdit->contentHeight(), reference->contentHeight());
+    QCOMPARE(textEdit->contentWidth(), reference->contentWidth());
+    QCOMPARE(textEdit->implicitWidth(), reference->implicitWidth());
+    QCOMPARE(textEdit->implicitHeight(), reference->implicitHeight());
+    if (implicitResize)
+        QCOMPARE_GT(textEdit->implicitWidth(), textEdit->width()); // the unwrapped width
+    if (lineCountConnected) {
+        QVERIFY(!lineCounts.isEmpty());
+        QCOMPARE(lineCounts.last(), reference->lineCount());
+    }
+}
+
+void tst_qquicktextedit::naturalWidthAfterEdits_data()
+{
+    QTest::addColumn<QString>("wrapMode");
+
+    QTest::newRow("no wrap") << QStringLiteral("NoWrap");
+    QTest::newRow("wrap") << QStringLiteral("Wrap");
+}
+
+// The natural width is only measured again when an edit can have changed it;
+// after each edit it has to match a TextEdit that got the text through setText().
+void tst_qquicktextedit::naturalWidthAfterEdits()
+{
+    QFETCH(QString, wrapMode);
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick\nTextEdit { width: 200; wrapMode: TextEdit." + wrapMode.toUtf8() + " }", QUrl());
+    QScopedPointer<QQuickTextEdit> textEdit(qobject_cast<QQuickTextEdit *>(component.create()));
+    QVERIFY(textEdit);
+
+    auto verifyImplicitWidth = [&]() {
+        QScopedPointer<QQuickTextEdit> reference(qobject_cast<QQuickTextEdit *>(component.create()));
+        if (!reference)
+            return false;
+        reference->setWidth(textEdit->width());
+        reference->setFont(textEdit->font());
+        reference->setText(textEdit->text());
+        if (textEdit->implicitWidth() != reference->implicitWidth()) {
+            qWarning() << "implicitWidth" << textEdit->implicitWidth() << "expected" << reference->implicitWidth();
+            return false;
+        }
+        return textEdit->contentWidth() == reference->contentWidth();
+    };
+
+    const QString longLine = QStringLiteral("Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+    textEdit->setText(longLine);
+    QVERIFY(verifyImplicitWidth());
+    QCOMPARE_GT(textEdit->implicitWidth(), textEdit->width());
+
+    textEdit->append(QStringLiteral("short"));
+    QVERIFY(verifyImplicitWidth());
+    textEdit->insert(textEdit->text().size(), QStringLiteral(" and a bit"));
+    QVERIFY(verifyImplicitWidth());
+    textEdit->append(longLine + longLine);
+    QVERIFY(verifyImplicitWidth());
+    textEdit->insert(0, QStringLiteral("x\n"));
+    QVERIFY(verifyImplicitWidth());
+    textEdit->insert(10, QStringLiteral("\n"));
+    QVERIFY(verifyImplicitWidth());
+    textEdit->remove(0, textEdit->text().indexOf(QStringLiteral("short")));
+    QVERIFY(verifyImplicitWidth());
+    textEdit->remove(textEdit->text().indexOf(longLine), longLine.size());
+    QVERIFY(verifyImplicitWidth());
+
+    textEdit->setWidth(120);
+    QVERIFY(verifyImplicitWidth());
+    QFont font = textEdit->font();
+    font.setPixelSize(font.pixelSize() > 0 ? font.pixelSize() * 2 : 30);
+    textEdit->setFont(font);
+    QVERIFY(verifyImplicitWidth());
+
+    // Everything fits
+    textEdit->setText(QStringLiteral("a\nb"));
+    QVERIFY(verifyImplicitWidth());
+    QCOMPARE_LT(textEdit->implicitWidth(), textEdit->width());
+}
+
 //the alignment tests may be trivial o.oa
 void tst_qquicktextedit::hAlign()
 {
@@ -485,6 +485,7 @@ private slots:
     void showHideAnimate();
 
     void testExpose();
+    void dirtyNodeValues();
 
     void requestActivate();
 
@@ -508,6 +509,7 @@ private slots:
 
     void animatingSignal();
     void frameSignals();
+    void rendererFrameStats();
 
     void contentItemSize();
 
@@ -2162,6 +2164,47 @@ void tst_qquickwindow::testExpose()
     QTRY_COMPARE(swapSpy.size(), 1);
 }
 
+void tst_qquickwindow::dirtyNodeValues()
+{
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.setGeometry(100, 100, 300, 200);
+
+    QQuickRectangle *faded = new QQuickRectangle(window.contentItem());
+    faded->setSize(QSizeF(50, 50));
+    faded->setOpacity(0.5);
+    QQuickRectangle *rotated = new QQuickRectangle(window.contentItem());
+    rotated->setSize(QSizeF(50, 50));
+    rotated->setRotation(90);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    window.grabWindow();
+    QQuickItemPrivate *fadedPriv = QQuickItemPrivate::get(faded);
+    QQuickItemPrivate *rotatedPriv = QQuickItemPrivate::get(rotated);
+    QVERIFY(fadedPriv->opacityNode());
+
+    // Position and opacity changes only set the values of existing nodes
+    faded->setPosition(QPointF(10, 20));
+    faded->setOpacity(0.25);
+    // The matrix of a rotated item also depends on its size
+    rotated->setX(30);
+    rotated->setWidth(100);
+    window.grabWindow();
+
+    QMatrix4x4 fadedMatrix;
+    fadedMatrix.translate(10, 20);
+    QCOMPARE(fadedPriv->itemNode()->matrix(), fadedMatrix);
+    QCOMPARE(fadedPriv->opacityNode()->opacity(), 0.25);
+
+    QMatrix4x4 rotatedMatrix;
+    rotatedMatrix.translate(30, 0);
+    rotatedMatrix.translate(50, 25);
+    rotatedMatrix.rotate(90, 0, 0, 1);
+    rotatedMatrix.translate(-50, -25);
+    QCOMPARE(rotatedPriv->itemNode()->matrix(), rotatedMatrix);
+}
+
 void tst_qquickwindow::requestActivate()
 {
 #ifdef Q_OS_ANDROID
@@ -2478,6 +2521,33 @@ void tst_qquickwindow::frameSignals()
     QTRY_COMPARE(beforeSpy.size(), afterSpy.size());
 }
 
+void tst_qquickwindow::rendererFrameStats()
+{
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.setGeometry(100, 100, 300, 200);
+
+    QQuickRectangle *rect = new QQuickRectangle(window.contentItem());
+    rect->setSize(QSizeF(100, 100));
+    rect->setColor(Qt::red);
+
+    QQuickWindowPrivate *wd = QQuickWindowPrivate::get(&window);
+    wd->setRendererFrameStatsEnabled(true);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    if (!QSGRendererInterface::isApiRhiBased(window.rendererInterface()->graphicsApi()))
+        QSKIP("Frame stats are only reported by the RHI-based renderer");
+
+    QTRY_VERIFY(wd->rendererFrameStats().drawCallCount > 0);
+    const QSGRendererFrameStats stats = wd->rendererFrameStats();
+    QVERIFY(stats.opaqueBatchCount + stats.alphaBatchCount > 0);
+    QVERIFY(stats.recordTime >= 0);
+
+    wd->setRendererFrameStatsEnabled(false);
+    QCOMPARE(wd->rendererFrameStats().drawCallCount, 0);
+}
+
 // QTBUG-36938
 void tst_qquickwindow::contentItemSize()
 {
@@ -0,0 +1,133 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QtTest>
+#include <QtCore/qendian.h>
+#include <QtCore/qlibraryinfo.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtGui/qrawfont.h>
+#include <QtQuick/private/qsgrhidistancefieldglyphcache_p.h>
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+class tst_QSGRhiDistanceFieldGlyphCache : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_QSGRhiDistanceFieldGlyphCache() : QQmlDataTest(QT_QMLTEST_DATADIR) {}
+
+private slots:
+    void fileName();
+    void identity();
+    void rejectOtherFont();
+    void generator();
+
+private:
+    bool writeAtlas(const QString &fileName, const QByteArray &identity, const QByteArray &table);
+};
+
+bool tst_QSGRhiDistanceFieldGlyphCache::writeAtlas(const QString &fileName,
+                                                   const QByteArray &identity,
+                                                   const QByteArray &table)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(identity + table) == identity.size() + table.size();
+}
+
+void tst_QSGRhiDistanceFieldGlyphCache::fileName()
+{
+    const QRawFont font(testFile("tarzeau_ocr_a.ttf"), 12);
+    QVERIFY(font.isValid());
+    const QString name = QSGRhiDistanceFieldGlyphCache::pregeneratedCacheFileName(font);
+    QVERIFY(name.endsWith(QLatin1String(".qtdf")));
+    QCOMPARE(name, name.toLower());
+    QVERIFY(!name.contains(QLatin1Char(' ')));
+}
+
+void tst_QSGRhiDistanceFieldGlyphCache::identity()
+{
+    const QRawFont font(testFile("tarzeau_ocr_a.ttf"), 12);
+    QVERIFY(font.isValid());
+
+    // The identity depends on the font, not on the size it is loaded at.
+    const QByteArray identity = QSGRhiDistanceFieldGlyphCache::pregeneratedCacheIdentity(font);
+    QCOMPARE(identity.size(), 20);
+    QVERIFY(identity.startsWith("QTDF"));
+    const QRawFont largerFont(testFile("tarzeau_ocr_a.ttf"), 48);
+    QCOMPARE(QSGRhiDistanceFieldGlyphCache::pregeneratedCacheIdentity(largerFont), identity);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QSGRhiDistanceFieldGlyphCache::pregeneratedCacheFileName(font));
+    const QByteArray table("qtdf table contents");
+    QVERIFY(writeAtlas(fileName, identity, table));
+    QCOMPARE(QSGRhiDistanceFieldGlyphCache::readPregeneratedCacheFile(fileName, font), table);
+}
+
+void tst_QSGRhiDistanceFieldGlyphCache::rejectOtherFont()
+{
+    const QRawFont font(testFile("tarzeau_ocr_a.ttf"), 12);
+    const QRawFont otherFont(testFile("daniel.ttf"), 12);
+    QVERIFY(font.isValid());
+    QVERIFY(otherFont.isValid());
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QLatin1String("atlas.qtdf"));
+    const QByteArray table("qtdf table contents");
+    const QRegularExpression warning(QLatin1String("was not generated for this version of font"));
+
+    // Generated for another font.
+    QVERIFY(writeAtlas(fileName, QSGRhiDistanceFieldGlyphCache::pregeneratedCacheIdentity(otherFont), table));
+    QTest::ignoreMessage(QtWarningMsg, warning);
+    QVERIFY(QSGRhiDistanceFieldGlyphCache::readPregeneratedCacheFile(fileName, font).isEmpty());
+
+    // Same font, but a different glyph count, as with another build of it.
+    QByteArray identity = QSGRhiDistanceFieldGlyphCache::pregeneratedCacheIdentity(font);
+    identity[11] = char(identity.at(11) + 1);
+    QVERIFY(writeAtlas(fileName, identity, table));
+    QTest::ignoreMessage(QtWarningMsg, warning);
+    QVERIFY(QSGRhiDistanceFieldGlyphCache::readPregeneratedCacheFile(fileName, font).isEmpty());
+
+    // A bare qtdf table without an identity block.
+    QVERIFY(writeAtlas(fileName, QByteArray(), table));
+    QTest::ignoreMessage(QtWarningMsg, warning);
+    QVERIFY(QSGRhiDistanceFieldGlyphCache::readPregeneratedCacheFile(fileName, font).isEmpty());
+}
+
+void tst_QSGRhiDistanceFieldGlyphCache::generator()
+{
+#if !QT_CONFIG(process)
+    QSKIP("Running the generator requires QProcess");
+#else
+    const QString generator = QLibraryInfo::path(QLibraryInfo::BinariesPath)
+            + QLatin1String("/qmldistancefieldgen");
+    if (!QFileInfo::exists(generator) && !QFileInfo::exists(generator + QLatin1String(".exe")))
+        QSKIP("qmldistancefieldgen is not available");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QProcess process;
+    process.start(generator, { QLatin1String("--chars"), QLatin1String("ABC"),
+                               QLatin1String("-o"), dir.path(), testFile("tarzeau_ocr_a.ttf") });
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QVERIFY2(process.exitCode() == 0, process.readAllStandardError().constData());
+
+    const QRawFont font(testFile("tarzeau_ocr_a.ttf"), 12);
+    const QString fileName = dir.filePath(QSGRhiDistanceFieldGlyphCache::pregeneratedCacheFileName(font));
+    QVERIFY(QFileInfo::exists(fileName));
+
+    // The loader accepts the file and finds a 5.12 qtdf table with three glyphs in it.
+    const QByteArray table = QSGRhiDistanceFieldGlyphCache::readPregeneratedCacheFile(fileName, font);
+    QVERIFY(table.size() > 14);
+    QCOMPARE(quint8(table.at(0)), quint8(5));
+    QCOMPARE(quint8(table.at(1)), quint8(12));
+    QCOMPARE(qFromBigEndian<quint32>(table.constData() + 10), quint32(3));
+#endif
+}
+
+QTEST_MAIN(tst_QSGRhiDistanceFieldGlyphCache)
+
+#include "tst_qsgrhidistancefieldglyphcache.moc"
@@ -96,6 +96,7 @@ private slots:
     void createTextureFromImage();
     void withAdoptedRhi();
     void resizeTextureFromImage();
+    void retireTextureAtlas();
 
 private:
     QQuickView *createView(const QString &file, QWindow *parent = nullptr, int x = -1, int y = -1, int w = -1, int h = -1);
@@ -777,6 +778,66 @@ void tst_SceneGraph::resizeTextureFromImage()
     TestOffscreenScene::cleanup();
 }
 
+void tst_SceneGraph::retireTextureAtlas()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping test due to not running with QRhi");
+
+    // The atlas manager reads these when the render context is initialized.
+    qputenv("QSG_ATLAS_WIDTH", "256");
+    qputenv("QSG_ATLAS_HEIGHT", "256");
+    qputenv("QSG_ATLAS_MAX_RETIRED", "1");
+    QLoggingCategory::setFilterRules(QStringLiteral("qt.scenegraph.general.debug=true"));
+    auto cleanup = qScopeGuard([] {
+        QLoggingCategory::setFilterRules(QString());
+        qunsetenv("QSG_ATLAS_WIDTH");
+        qunsetenv("QSG_ATLAS_HEIGHT");
+        qunsetenv("QSG_ATLAS_MAX_RETIRED");
+    });
+
+    {
+        QScopedPointer<TestOffscreenScene> scene(createOffscreenScene(testFileUrl(QLatin1String("renderControl_rect.qml"))));
+        QVERIFY(scene->renderControl && scene->window && scene->rootItem);
+
+        QImage image(60, 60, QImage::Format_RGBA8888_Premultiplied);
+        image.fill(Qt::red);
+
+        // Textures in the same atlas share a comparison key. Keep adding
+        // until one lands in a different atlas, which means the first one
+        // was retired.
+        ScopedList<QSGTexture *> firstAtlas;
+        QScopedPointer<QSGTexture> secondAtlas;
+        for (int i = 0; i < 100 && !secondAtlas; ++i) {
+            QSGTexture *t = scene->window->createTextureFromImage(image, QQuickWindow::TextureCanUseAtlas);
+            QVERIFY(t);
+            QVERIFY(t->isAtlasTexture());
+            if (firstAtlas.isEmpty() || t->comparisonKey() == firstAtlas.first()->comparisonKey())
+                firstAtlas.append(t);
+            else
+                secondAtlas.reset(t);
+        }
+        QVERIFY(secondAtlas);
+        QVERIFY(firstAtlas.size() > 1);
+
+        // Removing textures from the retired atlas while it still has others
+        // keeps it alive, and new textures keep going to the current one.
+        delete firstAtlas.takeLast();
+        QCoreApplication::sendPostedEvents();
+        QScopedPointer<QSGTexture> t(scene->window->createTextureFromImage(image, QQuickWindow::TextureCanUseAtlas));
+        QVERIFY(t->isAtlasTexture());
+        QCOMPARE(t->comparisonKey(), secondAtlas->comparisonKey());
+
+        // The retired atlas is released once its last texture is gone, without
+        // waiting for another texture to be created.
+        QTest::ignoreMessage(QtDebugMsg, QRegularExpression("rhi texture atlas .* drained, releasing"));
+        qDeleteAll(firstAtlas);
+        firstAtlas.clear();
+        QCoreApplication::sendPostedEvents();
+    }
+
+    TestOffscreenScene::cleanup();
+}
+
 bool tst_SceneGraph::isRunningOnRhi()
 {
     static bool retval = false;
@@ -4,8 +4,12 @@
 #include <qtest.h>
 
 #include <QDebug>
+#include <QtCore/QStringListModel>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
 
 #include <private/qqmlchangeset_p.h>
+#include <private/qqmldelegatemodel_p.h>
 
 class tst_qqmlchangeset : public QObject
 {
@@ -13,6 +17,10 @@ class tst_qqmlchangeset : public QObject
 
 private slots:
     void move();
+    void change_data();
+    void change();
+    void dataChanged_data();
+    void dataChanged();
 };
 
 void tst_qqmlchangeset::move()
@@ -26,5 +34,84 @@ void tst_qqmlchangeset::move()
     }
 }
 
+void tst_qqmlchangeset::change_data()
+{
+    QTest::addColumn<int>("stride");
+
+    QTest::newRow("sequential") << 1;
+    QTest::newRow("reversed") << -1;
+    QTest::newRow("strided") << 7;
+}
+
+void tst_qqmlchangeset::change()
+{
+    QFETCH(int, stride);
+
+    // Single row changes as emitted by a model updating its rows one by one.
+    QBENCHMARK {
+        QQmlChangeSet set;
+        const int MAX_ROWS = 10000;
+        for (int i = 0; i < MAX_ROWS; ++i) {
+            const int row = stride > 0 ? (i * stride) % MAX_ROWS : MAX_ROWS - 1 - i;
+            set.change(row, 1);
+        }
+    }
+}
+
+void tst_qqmlchangeset::dataChanged_data()
+{
+    QTest::addColumn<bool>("coalesce");
+
+    QTest::newRow("immediate") << false;
+    QTest::newRow("coalesced") << true;
+}
+
+void tst_qqmlchangeset::dataChanged()
+{
+    QFETCH(bool, coalesce);
+
+    // Read when the DelegateModel is created.
+    if (coalesce)
+        qputenv("QT_QML_COALESCE_MODEL_CHANGES", "1");
+    else
+        qunsetenv("QT_QML_COALESCE_MODEL_CHANGES");
+
+    const int MAX_ROWS = 10000;
+    const int DELEGATES = 100;
+    QStringList rows;
+    for (int i = 0; i < MAX_ROWS; ++i)
+        rows.append(QString::number(i));
+    QStringListModel list(rows);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData("import QtQml\n"
+                      "import QtQml.Models\n"
+                      "DelegateModel { delegate: QtObject { property string text: model.display } }",
+                      QUrl());
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+    auto *model = qobject_cast<QQmlDelegateModel *>(root.data());
+    QVERIFY(model);
+    model->setModel(QVariant::fromValue<QObject *>(&list));
+
+    QList<QObject *> delegates;
+    for (int i = 0; i < DELEGATES; ++i)
+        delegates.append(model->object(i, QQmlIncubator::Synchronous));
+
+    int value = 0;
+    QBENCHMARK {
+        // Every delegate is updated many times within one pass of the event loop.
+        for (int i = 0; i < MAX_ROWS; ++i)
+            list.setData(list.index(i % DELEGATES), QString::number(++value));
+        QCoreApplication::processEvents();
+    }
+
+    QCOMPARE(delegates.last()->property("text").toString(), QString::number(value));
+    for (QObject *delegate : std::as_const(delegates))
+        model->release(delegate);
+    qunsetenv("QT_QML_COALESCE_MODEL_CHANGES");
+}
+
 QTEST_MAIN(tst_qqmlchangeset)
 #include "tst_qqmlchangeset.moc"
@@ -0,0 +1,126 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+
+#include <QtGui/QStandardItemModel>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
+
+#include <private/qqmldelegatemodel_p.h>
+
+class tst_qqmldelegatemodel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sortedInsertRemove_data();
+    void sortedInsertRemove();
+    void sortedChange_data();
+    void sortedChange();
+
+private:
+    void rows_data();
+    QObject *createSorted(QQmlEngine *engine, QStandardItemModel *list, int rows);
+};
+
+static const int ValueRole = Qt::UserRole;
+
+void tst_qqmldelegatemodel::rows_data()
+{
+    QTest::addColumn<int>("rows");
+
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+// Returns a DelegateModel over list, whose default group is sorted by value, or null.
+QObject *tst_qqmldelegatemodel::createSorted(QQmlEngine *engine, QStandardItemModel *list, int rows)
+{
+    list->setItemRoleNames({ { ValueRole, "value" } });
+    for (int i = 0; i < rows; ++i) {
+        auto *item = new QStandardItem;
+        item->setData((i * 7919) % rows, ValueRole);
+        list->appendRow(item);
+    }
+
+    QQmlComponent component(engine);
+    component.setData("import QtQml\n"
+                      "import QtQml.Models\n"
+                      "DelegateModel {\n"
+                      "    property QtObject sortedGroup: sorted\n"
+                      "    groups: DelegateModelGroup {\n"
+                      "        id: sorted\n"
+                      "        name: \"sorted\"\n"
+                      "        includeByDefault: true\n"
+                      "        sortRole: \"value\"\n"
+                      "    }\n"
+                      "    delegate: QtObject {}\n"
+                      "}",
+                      QUrl());
+    QObject *root = component.create();
+    if (!root) {
+        qWarning() << component.errorString();
+        return nullptr;
+    }
+    qobject_cast<QQmlDelegateModel *>(root)->setModel(QVariant::fromValue<QObject *>(list));
+    return root;
+}
+
+void tst_qqmldelegatemodel::sortedInsertRemove_data()
+{
+    rows_data();
+}
+
+void tst_qqmldelegatemodel::sortedInsertRemove()
+{
+    QFETCH(int, rows);
+
+    QQmlEngine engine;
+    QStandardItemModel list;
+    QScopedPointer<QObject> root(createSorted(&engine, &list, rows));
+    QVERIFY(root);
+    QObject *group = root->property("sortedGroup").value<QObject *>();
+    QCOMPARE(group->property("count").toInt(), rows);
+
+    // Each row is placed into, and taken out of, the sorted group by itself, so the cost is
+    // that of one change with the group at its full size.
+    int value = 0;
+    QBENCHMARK {
+        auto *item = new QStandardItem;
+        item->setData(value++ % rows, ValueRole);
+        list.insertRow(rows / 2, item);
+        list.removeRow(rows / 2);
+    }
+
+    QCOMPARE(group->property("count").toInt(), rows);
+}
+
+void tst_qqmldelegatemodel::sortedChange_data()
+{
+    rows_data();
+}
+
+void tst_qqmldelegatemodel::sortedChange()
+{
+    QFETCH(int, rows);
+
+    QQmlEngine engine;
+    QStandardItemModel list;
+    QScopedPointer<QObject> root(createSorted(&engine, &list, rows));
+    QVERIFY(root);
+    QObject *group = root->property("sortedGroup").value<QObject *>();
+
+    // Changing the value of one row moves it to its new sorted position.
+    int value = 0;
+    QBENCHMARK {
+        list.item(value % rows)->setData(int((value * qint64(104729)) % rows), ValueRole);
+        ++value;
+    }
+
+    QCOMPARE(group->property("count").toInt(), rows);
+}
+
+QTEST_MAIN(tst_qqmldelegatemodel)
+#include "tst_qqmldelegatemodel.moc"
@@ -0,0 +1,79 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+
+#include <QtQml/qqmlcomponent.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQmlModels/private/qqmllistmodel_p.h>
+
+class tst_qqmllistmodel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void append_data();
+    void append();
+};
+
+void tst_qqmllistmodel::append_data()
+{
+    QTest::addColumn<bool>("columns");
+
+    QTest::newRow("objects") << false;
+    QTest::newRow("columns") << true;
+}
+
+// Loads 1M rows of two roles, either as one object per row or column by column.
+void tst_qqmllistmodel::append()
+{
+    QFETCH(bool, columns);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(R"(
+        import QtQml.Models
+
+        ListModel {
+            property var rows: []
+            property var names: []
+            property var costs
+
+            function prepare(count) {
+                const r = new Array(count)
+                const n = new Array(count)
+                const c = new Float64Array(count)
+                for (let i = 0; i < count; ++i) {
+                    n[i] = "item " + i
+                    c[i] = i * 0.5
+                    r[i] = { name: n[i], cost: c[i] }
+                }
+                rows = r
+                names = n
+                costs = c
+            }
+
+            function load(columns) {
+                clear()
+                if (columns)
+                    appendColumns({ name: names, cost: costs })
+                else
+                    append(rows)
+            }
+        }
+    )", QUrl());
+    QScopedPointer<QObject> object(component.create());
+    QQmlListModel *model = qobject_cast<QQmlListModel *>(object.data());
+    QVERIFY2(model, qPrintable(component.errorString()));
+
+    const int count = 1000000;
+    QVERIFY(QMetaObject::invokeMethod(model, "prepare", Q_ARG(QVariant, count)));
+
+    QBENCHMARK {
+        QVERIFY(QMetaObject::invokeMethod(model, "load", Q_ARG(QVariant, columns)));
+    }
+    QCOMPARE(model->count(), count);
+}
+
+QTEST_MAIN(tst_qqmllistmodel)
+#include "tst_qqmllistmodel.moc"
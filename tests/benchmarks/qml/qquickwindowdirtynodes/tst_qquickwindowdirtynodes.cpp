@@ -0,0 +1,85 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/private/qquickrectangle_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
+
+#include <qtest.h>
+#include <QtTest/QtTest>
+
+// updateDirtyNodes() is called directly, so the sync has to happen on the
+// test's thread. The render loop is chosen once per process, which is why
+// this benchmark has a binary of its own.
+class tst_qquickwindowdirtynodes : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void updateDirtyNodes_data();
+    void updateDirtyNodes();
+
+private:
+    QQuickWindow *window = nullptr;
+};
+
+void tst_qquickwindowdirtynodes::initTestCase()
+{
+    qputenv("QSG_RENDER_LOOP", "basic");
+    window = new QQuickWindow;
+    window->resize(250, 250);
+    window->setPosition(100, 100);
+    for (int i = 0; i < 8000; ++i) {
+        QQuickRectangle *r = new QQuickRectangle(window->contentItem());
+        for (int j = 0; j < 10; ++j)
+            new QQuickRectangle(r);
+    }
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+}
+
+void tst_qquickwindowdirtynodes::cleanupTestCase()
+{
+    delete window;
+    qunsetenv("QSG_RENDER_LOOP");
+}
+
+void tst_qquickwindowdirtynodes::updateDirtyNodes_data()
+{
+    QTest::addColumn<bool>("rotate");
+    QTest::addColumn<bool>("fade");
+
+    QTest::newRow("position") << false << false;
+    QTest::newRow("position, rotation") << true << false;
+    QTest::newRow("position, opacity") << false << true;
+}
+
+void tst_qquickwindowdirtynodes::updateDirtyNodes()
+{
+    QFETCH(bool, rotate);
+    QFETCH(bool, fade);
+
+    QQuickWindowPrivate *wd = QQuickWindowPrivate::get(window);
+    QList<QQuickItem *> items;
+    for (QQuickItem *item : window->contentItem()->childItems())
+        items << item << item->childItems();
+
+    int frame = 0;
+    QBENCHMARK {
+        ++frame;
+        for (QQuickItem *item : std::as_const(items)) {
+            item->setX(frame % 100);
+            if (rotate)
+                item->setRotation(frame % 360);
+            if (fade)
+                item->setOpacity(frame % 2 ? 0.5 : 1.0);
+        }
+        wd->updateDirtyNodes();
+    }
+}
+
+QTEST_MAIN(tst_qquickwindowdirtynodes)
+
+#include "tst_qquickwindowdirtynodes.moc"
@@ -0,0 +1,27 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+import QtQuick
+
+Item {
+    width: 400
+    height: 400
+
+    Grid {
+        columns: 50
+        Repeater {
+            model: 2500
+            Rectangle {
+                width: 8
+                height: 8
+                color: hh.hovered ? "red" : "gray"
+                HoverHandler {
+                    id: hh
+                }
+                Text {
+                    text: index
+                    font.pixelSize: 4
+                }
+            }
+        }
+    }
+}
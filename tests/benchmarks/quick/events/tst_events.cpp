@@ -4,6 +4,8 @@
 #include <qtest.h>
 #include <QtQuick>
 #include <QtQuick/private/qquickmousearea_p.h>
+#include <QtQuick/private/qquickdeliveryagent_p_p.h>
+#include <QtCore/qscopeguard.h>
 #include <QDebug>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include <QtQuickTestUtils/private/viewtestutils_p.h>
@@ -23,10 +25,16 @@ public:
     tst_events();
 
 private slots:
+    void mousePressRelease_data() { boundsIndexData(); }
     void mousePressRelease();
+    void mouseMove_data() { boundsIndexData(); }
     void mouseMove();
+    void touchToMousePressRelease_data() { boundsIndexData(); }
     void touchToMousePressRelease();
+    void touchToMousePressMove_data() { boundsIndexData(); }
     void touchToMousePressMove();
+    void hoverMove_data() { boundsIndexData(); }
+    void hoverMove();
 
 public slots:
     void initTestCase() override {
@@ -38,9 +46,26 @@ public slots:
     }
 
 private:
+    // Each benchmark runs with and without QT_QUICK_POINTER_BOUNDS_INDEX,
+    // so that the two delivery paths can be compared side by side.
+    void boundsIndexData()
+    {
+        QTest::addColumn<bool>("boundsIndex");
+        QTest::newRow("no index") << false;
+        QTest::newRow("bounds index") << true;
+    }
+
     TestView window;
 };
 
+#define USE_BOUNDS_INDEX_FROM_DATA() \
+    QFETCH(bool, boundsIndex); \
+    const bool wasBoundsIndexEnabled = QQuickDeliveryAgentPrivate::pointerBoundsIndexEnabled; \
+    QQuickDeliveryAgentPrivate::pointerBoundsIndexEnabled = boundsIndex; \
+    auto restoreBoundsIndex = qScopeGuard([wasBoundsIndexEnabled] { \
+        QQuickDeliveryAgentPrivate::pointerBoundsIndexEnabled = wasBoundsIndexEnabled; \
+    })
+
 tst_events::tst_events()
     : QQmlDataTest(QT_QMLTEST_DATADIR)
 {
@@ -48,6 +73,7 @@ tst_events::tst_events()
 
 void tst_events::mousePressRelease()
 {
+    USE_BOUNDS_INDEX_FROM_DATA();
     QQuickMouseArea *mouseArea = window.rootObject()->findChild<QQuickMouseArea *>("mouseArea");
     QCOMPARE(mouseArea->pressed(), false);
 
@@ -65,6 +91,7 @@ void tst_events::mousePressRelease()
 
 void tst_events::mouseMove()
 {
+    USE_BOUNDS_INDEX_FROM_DATA();
     QQuickMouseArea *mouseArea = window.rootObject()->findChild<QQuickMouseArea *>("mouseArea");
     const QPoint localPos1(100, 100);
     const QPoint globalPos1 = window.mapToGlobal(localPos1);
@@ -89,6 +116,7 @@ void tst_events::mouseMove()
 
 void tst_events::touchToMousePressRelease()
 {
+    USE_BOUNDS_INDEX_FROM_DATA();
     QQuickMouseArea *mouseArea = window.rootObject()->findChild<QQuickMouseArea *>("mouseArea");
     QCOMPARE(mouseArea->pressed(), false);
 
@@ -105,6 +133,7 @@ void tst_events::touchToMousePressRelease()
 
 void tst_events::touchToMousePressMove()
 {
+    USE_BOUNDS_INDEX_FROM_DATA();
     QQuickMouseArea *mouseArea = window.rootObject()->findChild<QQuickMouseArea *>("mouseArea");
     QCOMPARE(mouseArea->pressed(), false);
 
@@ -127,5 +156,26 @@ void tst_events::touchToMousePressMove()
     QCOMPARE(mouseArea->pressed(), false);
 }
 
+void tst_events::hoverMove()
+{
+    USE_BOUNDS_INDEX_FROM_DATA();
+    TestView hoverWindow;
+    hoverWindow.setBaseSize(QSize(400, 400));
+    hoverWindow.setSource(testFileUrl("hoverevent.qml"));
+    hoverWindow.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&hoverWindow));
+
+    const QPoint localPos1(100, 100);
+    const QPoint globalPos1 = hoverWindow.mapToGlobal(localPos1);
+    const QPoint localPos2(300, 300);
+    const QPoint globalPos2 = hoverWindow.mapToGlobal(localPos2);
+    QMouseEvent moveEvent1(QEvent::MouseMove, localPos1, globalPos1, Qt::NoButton, Qt::NoButton, {});
+    QMouseEvent moveEvent2(QEvent::MouseMove, localPos2, globalPos2, Qt::NoButton, Qt::NoButton, {});
+    QBENCHMARK {
+        hoverWindow.handleEvent(&moveEvent1);
+        hoverWindow.handleEvent(&moveEvent2);
+    }
+}
+
 QTEST_MAIN(tst_events)
 #include "tst_events.moc"
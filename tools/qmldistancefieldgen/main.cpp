@@ -0,0 +1,291 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtQuick/private/qsgareaallocator_p.h>
+#include <QtQuick/private/qsgrhidistancefieldglyphcache_p.h>
+
+#include <QtGui/private/qdistancefield_p.h>
+#include <QtGui/private/qfontengine_p.h>
+#include <QtGui/private/qrawfont_p.h>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QtEndian>
+#include <QtCore/qmath.h>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QRawFont>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+// Must match the values QSGRhiDistanceFieldGlyphCache is compiled with and the
+// qtdf version it accepts, see qsgrhidistancefieldglyphcache.cpp.
+static const int glyphPadding = 2;
+static const quint8 qtdfMajorVersion = 5;
+static const quint8 qtdfMinorVersion = 12;
+
+struct GlyphEntry
+{
+    glyph_t glyph = 0;
+    QRectF boundingRect; // in base font size scale
+    QDistanceField field;
+    QRect alloc;         // including padding, in allocator coordinates
+};
+
+static void writeUInt8(QByteArray &out, quint8 v)
+{
+    out.append(char(v));
+}
+
+static void writeUInt16(QByteArray &out, quint16 v)
+{
+    char buf[sizeof(v)];
+    qToBigEndian(v, buf);
+    out.append(buf, sizeof(v));
+}
+
+static void writeUInt32(QByteArray &out, quint32 v)
+{
+    char buf[sizeof(v)];
+    qToBigEndian(v, buf);
+    out.append(buf, sizeof(v));
+}
+
+static void writeFixed(QByteArray &out, qreal v)
+{
+    writeUInt32(out, quint32(qint32(qRound(v * 65536))));
+}
+
+static bool allocateGlyphs(QList<GlyphEntry> &glyphs, int textureSize, int textureCount,
+                           qreal radius)
+{
+    QSGAreaAllocator allocator(QSize(textureSize, textureSize * textureCount));
+    for (GlyphEntry &entry : glyphs) {
+        const int width = qCeil(entry.boundingRect.width() + radius * 2);
+        const int height = qCeil(entry.boundingRect.height() + radius * 2);
+        entry.alloc = allocator.allocate(QSize(width + glyphPadding * 2, height + glyphPadding * 2));
+        if (entry.alloc.isNull())
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    // Only font loading is needed, never a window.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("qmldistancefieldgen"_L1);
+    QCoreApplication::setApplicationVersion(QLatin1String(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+            "Renders the distance-field glyphs for a font into a .qtdf atlas file "
+            "that Qt Quick loads at startup instead of rendering the glyphs at runtime."_L1);
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption charsOption("chars"_L1, "Characters to include."_L1, "string"_L1);
+    parser.addOption(charsOption);
+    QCommandLineOption charsFileOption("chars-file"_L1,
+                                       "UTF-8 text file containing the characters to include."_L1,
+                                       "file"_L1);
+    parser.addOption(charsFileOption);
+    QCommandLineOption outputDirOption({ "o"_L1, "output-dir"_L1 },
+                                       "Directory to write the atlas to."_L1, "directory"_L1,
+                                       "."_L1);
+    parser.addOption(outputDirOption);
+    QCommandLineOption textureSizeOption("texture-size"_L1,
+                                         "Width and height of each atlas texture."_L1, "size"_L1,
+                                         "2048"_L1);
+    parser.addOption(textureSizeOption);
+    QCommandLineOption maxTexturesOption("max-textures"_L1,
+                                         "Maximum number of atlas textures."_L1, "count"_L1,
+                                         "8"_L1);
+    parser.addOption(maxTexturesOption);
+    parser.addPositionalArgument("font"_L1, "The font file to generate the atlas for."_L1);
+
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 1) {
+        parser.showHelp(1);
+        return 1;
+    }
+
+    QString chars = parser.value(charsOption);
+    if (parser.isSet(charsFileOption)) {
+        QFile charsFile(parser.value(charsFileOption));
+        if (!charsFile.open(QIODevice::ReadOnly)) {
+            fprintf(stderr, "Cannot open %s\n", qPrintable(charsFile.fileName()));
+            return 1;
+        }
+        chars += QString::fromUtf8(charsFile.readAll());
+    }
+    if (chars.isEmpty()) {
+        fprintf(stderr, "No characters given, use --chars or --chars-file\n");
+        return 1;
+    }
+
+    bool ok = false;
+    const int textureSize = parser.value(textureSizeOption).toInt(&ok);
+    if (!ok || textureSize <= 0) {
+        fprintf(stderr, "Invalid texture size %s\n", qPrintable(parser.value(textureSizeOption)));
+        return 1;
+    }
+    const int maxTextures = parser.value(maxTexturesOption).toInt(&ok);
+    if (!ok || maxTextures <= 0) {
+        fprintf(stderr, "Invalid texture count %s\n", qPrintable(parser.value(maxTexturesOption)));
+        return 1;
+    }
+
+    QRawFont font(positional.first(), 12);
+    if (!font.isValid()) {
+        fprintf(stderr, "Cannot load font %s\n", qPrintable(positional.first()));
+        return 1;
+    }
+
+    // Same choices as the QSGDistanceFieldGlyphCache constructor, so that the
+    // runtime cache can extend the atlas with glyphs that are not in it.
+    const int glyphCount = QRawFontPrivate::get(font)->fontEngine->glyphCount();
+    const bool doubleResolution = qt_fontHasNarrowOutlines(font)
+            && glyphCount < QT_DISTANCEFIELD_HIGHGLYPHCOUNT();
+    const int scale = QT_DISTANCEFIELD_SCALE(doubleResolution);
+    const int pixelSize = QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution) * scale;
+    const qreal radius = QT_DISTANCEFIELD_RADIUS(doubleResolution) / qreal(scale);
+    font.setPixelSize(pixelSize);
+
+    QList<quint32> glyphIndexes = font.glyphIndexesForString(chars);
+    std::sort(glyphIndexes.begin(), glyphIndexes.end());
+    glyphIndexes.erase(std::unique(glyphIndexes.begin(), glyphIndexes.end()), glyphIndexes.end());
+
+    QList<GlyphEntry> glyphs;
+    glyphs.reserve(glyphIndexes.size());
+    QTransform scaleDown;
+    scaleDown.scale(qreal(1) / scale, qreal(1) / scale);
+    for (quint32 glyphIndex : std::as_const(glyphIndexes)) {
+        if (glyphIndex == 0)
+            continue;
+        const QPainterPath path = font.pathForGlyph(glyphIndex);
+        GlyphEntry entry;
+        entry.glyph = glyphIndex;
+        entry.boundingRect = scaleDown.mapRect(path.boundingRect());
+        // Empty glyphs (e.g. spaces) never occupy atlas space.
+        if (entry.boundingRect.isEmpty())
+            continue;
+        entry.field = QDistanceField(path, glyphIndex, doubleResolution);
+        glyphs.append(entry);
+    }
+
+    if (glyphs.isEmpty()) {
+        fprintf(stderr, "None of the characters have a visible glyph in %s\n",
+                qPrintable(positional.first()));
+        return 1;
+    }
+
+    // Tallest first packs noticeably tighter with the area allocator.
+    std::sort(glyphs.begin(), glyphs.end(), [](const GlyphEntry &a, const GlyphEntry &b) {
+        return a.boundingRect.height() > b.boundingRect.height();
+    });
+
+    // The runtime creates one texture per textureSize high slice of the
+    // allocator, so use as few slices as the glyphs need.
+    int textureCount = 1;
+    while (!allocateGlyphs(glyphs, textureSize, textureCount, radius)) {
+        if (++textureCount > maxTextures) {
+            fprintf(stderr, "Glyphs do not fit into %d textures of %dx%d\n",
+                    maxTextures, textureSize, textureSize);
+            return 1;
+        }
+    }
+
+    QSGAreaAllocator allocator(QSize(textureSize, textureSize * textureCount));
+    QList<QSize> textureExtents(textureCount);
+    for (GlyphEntry &entry : glyphs) {
+        const QRect alloc = allocator.allocate(entry.alloc.size());
+        Q_ASSERT(!alloc.isNull());
+        entry.alloc = alloc;
+        QSize &extent = textureExtents[alloc.y() / textureSize];
+        extent = extent.expandedTo(QSize(alloc.right() + 1, alloc.bottom() % textureSize + 1));
+    }
+
+    QList<QByteArray> textureData(textureCount);
+    for (int i = 0; i < textureCount; ++i)
+        textureData[i] = QByteArray(textureExtents.at(i).width() * textureExtents.at(i).height(), 0);
+
+    QByteArray glyphRecords;
+    for (const GlyphEntry &entry : std::as_const(glyphs)) {
+        const int textureIndex = entry.alloc.y() / textureSize;
+        const QPoint topLeft(entry.alloc.x(), entry.alloc.y() % textureSize);
+        const qreal width = entry.boundingRect.width();
+        const qreal height = entry.boundingRect.height();
+
+        writeUInt32(glyphRecords, entry.glyph);
+        writeFixed(glyphRecords, topLeft.x() + glyphPadding);
+        writeFixed(glyphRecords, topLeft.y() + glyphPadding);
+        writeFixed(glyphRecords, width);
+        writeFixed(glyphRecords, height);
+        writeFixed(glyphRecords, radius);
+        writeFixed(glyphRecords, radius);
+        writeFixed(glyphRecords, entry.boundingRect.x());
+        writeFixed(glyphRecords, entry.boundingRect.y());
+        writeFixed(glyphRecords, width);
+        writeFixed(glyphRecords, height);
+        writeUInt16(glyphRecords, quint16(textureIndex));
+
+        // Same cropping as QSGRhiDistanceFieldGlyphCache::storeGlyphs().
+        const int expectedWidth = qCeil(width + radius * 2);
+        const QDistanceField field = entry.field.copy(-glyphPadding, -glyphPadding,
+                                                      expectedWidth + glyphPadding * 2,
+                                                      entry.field.height() + glyphPadding * 2);
+        const QSize extent = textureExtents.at(textureIndex);
+        const int copyWidth = qMin(field.width(), extent.width() - topLeft.x());
+        const int copyHeight = qMin(field.height(), extent.height() - topLeft.y());
+        char *dst = textureData[textureIndex].data();
+        for (int y = 0; y < copyHeight; ++y) {
+            memcpy(dst + (topLeft.y() + y) * extent.width() + topLeft.x(),
+                   field.scanLine(y), copyWidth);
+        }
+    }
+
+    QByteArray table;
+    writeUInt8(table, qtdfMajorVersion);
+    writeUInt8(table, qtdfMinorVersion);
+    writeUInt16(table, quint16(pixelSize));
+    writeUInt32(table, quint32(textureSize));
+    writeUInt8(table, doubleResolution ? 1 : 0);
+    writeUInt8(table, quint8(glyphPadding));
+    writeUInt32(table, quint32(glyphs.size()));
+    table += allocator.serialize();
+    for (const QSize &extent : std::as_const(textureExtents)) {
+        writeUInt32(table, 0);
+        writeUInt32(table, 0);
+        writeUInt32(table, quint32(extent.width()));
+        writeUInt32(table, quint32(extent.height()));
+        writeUInt8(table, quint8(glyphPadding));
+    }
+    table += glyphRecords;
+    for (const QByteArray &data : std::as_const(textureData))
+        table += data;
+
+    const QString outputPath = QDir(parser.value(outputDirOption))
+            .filePath(QSGRhiDistanceFieldGlyphCache::pregeneratedCacheFileName(font));
+    // The identity lets the runtime reject the file for any other build of the font.
+    table.prepend(QSGRhiDistanceFieldGlyphCache::pregeneratedCacheIdentity(font));
+
+    QFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly) || output.write(table) != table.size()) {
+        fprintf(stderr, "Cannot write %s\n", qPrintable(outputPath));
+        return 1;
+    }
+
+    return 0;
+}